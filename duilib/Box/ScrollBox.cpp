@@ -17,6 +17,7 @@ ScrollBox::ScrollBox(Window* pWindow, Layout* pLayout) :
     m_bScrollBarFloat(true),
     m_bVScrollBarAtLeft(false),
     m_bHoldEnd(false),
+    m_bScrollBlit(false),
     m_rcScrollBarPadding(),
     m_pScrollAnimation(nullptr),
     m_pRenderOffsetYAnimation(nullptr),
@@ -83,6 +84,9 @@ void ScrollBox::SetAttribute(const DString& pstrName, const DString& pstrValue)
     else if ((pstrName == _T("hold_end")) || (pstrName == _T("holdend"))) {
         SetHoldEnd(pstrValue == _T("true"));
     }
+    else if (pstrName == _T("scroll_blit")) {
+        SetScrollBlit(pstrValue == _T("true"));
+    }
     else {
         Box::SetAttribute(pstrName, pstrValue);
     }
@@ -566,11 +570,15 @@ void ScrollBox::SetScrollPos(UiSize64 szPos)
         return;
     }
     UiSize newScrollOffset = GetScrollOffset();
+    //滚动优化需要在子控件响应滚动之前完成，子控件响应时发起的重绘使用的是滚动后的坐标
+    bool bScrollByBlit = ScrollByBlit(oldScrollOffset, newScrollOffset);
     if (newScrollOffset != oldScrollOffset) {
         OnScrollOffsetChanged(oldScrollOffset, newScrollOffset);
     }
 
-    Invalidate();
+    if (!bScrollByBlit) {
+        Invalidate();
+    }
     SendEvent(kEventScrollChange, (cy == 0) ? 0 : 1, (cx == 0) ? 0 : 1);
 }
 
@@ -1075,6 +1083,149 @@ bool ScrollBox::IsAtEnd() const
     return GetScrollRange().cy <= GetScrollPos().cy;
 }
 
+void ScrollBox::SetScrollBlit(bool bScrollBlit)
+{
+    m_bScrollBlit = bScrollBlit;
+}
+
+bool ScrollBox::IsScrollBlit() const
+{
+    return m_bScrollBlit;
+}
+
+bool ScrollBox::GetScrollBlitRect(UiRect& rcScroll) const
+{
+    rcScroll.Clear();
+    //容器自身的绘制内容必须与滚动位置无关：不透明的纯色背景，裁剪子控件
+    if (!IsVisible() || !IsClip() || (GetAlpha() != 255) || IsFloat() ||
+        (GetRenderOffset().x != 0) || (GetRenderOffset().y != 0)) {
+        return false;
+    }
+    if (GetBkColor().empty() || (GetUiColor(GetBkColor()).GetA() != 255) ||
+        !GetBkImage().empty() || ShouldBeRoundRectFill()) {
+        return false;
+    }
+    if (IsShowFocusRect() && IsFocused()) {
+        return false;
+    }
+    //浮动的子控件不随滚动移动
+    const size_t nItemCount = m_items.size();
+    for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+        const Control* pControl = m_items[nIndex];
+        if ((pControl != nullptr) && pControl->IsVisible() && pControl->IsFloat()) {
+            return false;
+        }
+    }
+
+    //可以移动像素的区域：内容区域（去掉内边距和边框），转换为窗口客户区坐标
+    UiRect rcView = GetPosWithoutPadding();
+    UiRect rcInner = GetRect();
+    const UiRect& rcBorder = GetBorderSize();
+    rcInner.Deflate(rcBorder.left, rcBorder.top, rcBorder.right, rcBorder.bottom);
+    if (!rcView.Intersect(rcInner)) {
+        return false;
+    }
+    //去掉滚动条的区域（滚动条需要重绘）
+    if ((m_pVScrollBar != nullptr) && m_pVScrollBar->IsValid() && m_pVScrollBar->IsVisible()) {
+        const UiRect& rcBar = m_pVScrollBar->GetRect();
+        if ((rcBar.left < rcView.right) && (rcBar.right > rcView.left)) {
+            if (rcBar.CenterX() >= rcView.CenterX()) {
+                rcView.right = (std::min)(rcView.right, rcBar.left);
+            }
+            else {
+                rcView.left = (std::max)(rcView.left, rcBar.right);
+            }
+        }
+    }
+    if ((m_pHScrollBar != nullptr) && m_pHScrollBar->IsValid() && m_pHScrollBar->IsVisible()) {
+        const UiRect& rcBar = m_pHScrollBar->GetRect();
+        if ((rcBar.top < rcView.bottom) && (rcBar.bottom > rcView.top)) {
+            if (rcBar.CenterY() >= rcView.CenterY()) {
+                rcView.bottom = (std::min)(rcView.bottom, rcBar.top);
+            }
+            else {
+                rcView.top = (std::max)(rcView.top, rcBar.bottom);
+            }
+        }
+    }
+    if (rcView.IsEmpty()) {
+        return false;
+    }
+    UiPoint scrollBoxOffset = GetScrollOffsetInScrollBox();
+    rcView.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+
+    //逐级检查父容器：被裁剪的部分去掉，与兄弟控件有重叠时（可能被覆盖）不支持
+    const Control* pChild = this;
+    for (const Box* pParent = GetParent(); pParent != nullptr; pChild = pParent, pParent = pParent->GetParent()) {
+        if (!pParent->IsVisible() || (pParent->GetAlpha() != 255) ||
+            (pParent->GetRenderOffset().x != 0) || (pParent->GetRenderOffset().y != 0)) {
+            return false;
+        }
+        UiPoint parentOffset = pParent->GetScrollOffsetInScrollBox();
+        UiRect rcParent = pParent->GetPosWithoutPadding();
+        rcParent.Offset(-parentOffset.x, -parentOffset.y);
+        if (!rcParent.ContainsRect(rcView)) {
+            if (!pParent->IsClip() || (dynamic_cast<const ScrollBox*>(pParent) == nullptr)) {
+                //父容器不裁剪子控件，超出父容器的部分也会显示
+                return false;
+            }
+            if (!rcView.Intersect(rcParent)) {
+                return false;
+            }
+        }
+        const size_t nCount = pParent->GetItemCount();
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+            const Control* pControl = pParent->GetItemAt(nIndex);
+            if ((pControl == nullptr) || (pControl == pChild) || !pControl->IsVisible()) {
+                continue;
+            }
+            UiRect rcItem = pControl->GetRect();
+            UiPoint itemOffset = pControl->GetScrollOffsetInScrollBox();
+            rcItem.Offset(-itemOffset.x, -itemOffset.y);
+            UiRect rcOverlap;
+            if (UiRect::Intersect(rcOverlap, rcItem, rcView)) {
+                return false;
+            }
+        }
+    }
+    rcScroll = rcView;
+    return true;
+}
+
+bool ScrollBox::ScrollByBlit(const UiSize& oldScrollOffset, const UiSize& newScrollOffset)
+{
+    if (!m_bScrollBlit || (GetWindow() == nullptr)) {
+        return false;
+    }
+    UiRect rcScroll;
+    if (!GetScrollBlitRect(rcScroll)) {
+        return false;
+    }
+    //滚动偏移增加时，内容向左（上）移动
+    const int32_t dx = oldScrollOffset.cx - newScrollOffset.cx;
+    const int32_t dy = oldScrollOffset.cy - newScrollOffset.cy;
+    if (!GetWindow()->ScrollWindowRect(rcScroll, dx, dy)) {
+        return false;
+    }
+    //滚动条以及内容区域之外的部分（内边距等）需要重绘
+    UiRect rcBox = GetRect();
+    UiPoint scrollBoxOffset = GetScrollOffsetInScrollBox();
+    rcBox.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+    if (rcScroll.top > rcBox.top) {
+        GetWindow()->Invalidate(UiRect(rcBox.left, rcBox.top, rcBox.right, rcScroll.top));
+    }
+    if (rcScroll.bottom < rcBox.bottom) {
+        GetWindow()->Invalidate(UiRect(rcBox.left, rcScroll.bottom, rcBox.right, rcBox.bottom));
+    }
+    if (rcScroll.left > rcBox.left) {
+        GetWindow()->Invalidate(UiRect(rcBox.left, rcScroll.top, rcScroll.left, rcScroll.bottom));
+    }
+    if (rcScroll.right < rcBox.right) {
+        GetWindow()->Invalidate(UiRect(rcScroll.right, rcScroll.top, rcBox.right, rcScroll.bottom));
+    }
+    return true;
+}
+
 bool ScrollBox::IsHoldEnd() const
 {
     return m_bHoldEnd;
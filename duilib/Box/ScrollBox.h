@@ -244,6 +244,18 @@ public:
      */
     void SetScrollBarPadding(UiPadding rcScrollBarPadding, bool bNeedDpiScale);
 
+    /** 设置是否开启滚动优化：滚动时移动已经绘制的像素，只重绘移动后空出的区域
+    *   仅在满足以下条件时生效，否则仍然重绘整个容器：
+    *   容器背景为不透明的纯色（无背景图片、无圆角、不透明度为255），容器裁剪子控件，无浮动的子控件，
+    *   容器所在区域没有被其他控件覆盖，并且窗口支持该功能（目前仅SDL的CPU绘制模式支持）
+    * @param [in] bScrollBlit true表示开启，false表示关闭
+    */
+    void SetScrollBlit(bool bScrollBlit);
+
+    /** 是否开启了滚动优化
+    */
+    bool IsScrollBlit() const;
+
     /** 停止滚动条动画
     */
     void StopScrollAnimation();
@@ -283,6 +295,19 @@ private:
      */
     void SetPosInternally(const UiRect& rc);
 
+    /** 滚动优化：通过移动已经绘制的像素完成滚动，只重绘移动后空出的区域
+    * @param [in] oldScrollOffset 滚动前的偏移
+    * @param [in] newScrollOffset 滚动后的偏移
+    * @return 成功返回true；如果不满足条件返回false，此时需要重绘整个容器
+    */
+    bool ScrollByBlit(const UiSize& oldScrollOffset, const UiSize& newScrollOffset);
+
+    /** 获取滚动优化时，可以移动像素的区域（窗口客户区坐标）
+    * @param [out] rcScroll 返回区域
+    * @return 如果不满足滚动优化的条件，返回false
+    */
+    bool GetScrollBlitRect(UiRect& rcScroll) const;
+
 private:
     //垂直滚动条接口
     std::unique_ptr<ScrollBar> m_pVScrollBar;
@@ -312,6 +337,9 @@ private:
     //容器的滚动条是否在左侧显示
     bool m_bVScrollBarAtLeft;
 
+    //是否开启滚动优化（滚动时移动已经绘制的像素，只重绘空出的区域）
+    bool m_bScrollBlit;
+
     //滚动条的外边距
     UiPadding m_rcScrollBarPadding;
 
@@ -300,95 +300,180 @@ inline DString CheckBoxTemplate<Box>::GetType() const { return DUI_CTR_CHECKBOXB
 template<typename InheritType>
 void CheckBoxTemplate<InheritType>::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("selected")) {
+    //按属性名称的序号分发，同一个属性的多个名称对应同一个序号
+    enum AttributeId : int32_t
+    {
+        kSelected,
+        kNormalFirst,
+        kSelectedNormalImage,
+        kSelectedHotImage,
+        kSelectedPushedImage,
+        kSelectedDisabledImage,
+        kSelectedForeNormalImage,
+        kSelectedForeHotImage,
+        kSelectedForePushedImage,
+        kSelectedForeDisabledImage,
+        kPartSelectedNormalImage,
+        kPartSelectedHotImage,
+        kPartSelectedPushedImage,
+        kPartSelectedDisabledImage,
+        kPartSelectedForeNormalImage,
+        kPartSelectedForeHotImage,
+        kPartSelectedForePushedImage,
+        kPartSelectedForeDisabledImage,
+        kSelectedTextColor,
+        kSelectedNormalTextColor,
+        kSelectedHotTextColor,
+        kSelectedPushedTextColor,
+        kSelectedDisabledTextColor,
+        kSelectedNormalColor,
+        kSelectedHotColor,
+        kSelectedPushedColor,
+        kSelectedDisabledColor,
+        kSwitchSelect,
+        kAutoCheckSelect,
+    };
+    static const AttributeTable attributeTable({
+        { _T("selected"), kSelected },
+        { _T("normal_first"), kNormalFirst },
+        { _T("normalfirst"), kNormalFirst },
+        { _T("selected_normal_image"), kSelectedNormalImage },
+        { _T("selectednormalimage"), kSelectedNormalImage },
+        { _T("selected_hot_image"), kSelectedHotImage },
+        { _T("selectedhotimage"), kSelectedHotImage },
+        { _T("selected_pushed_image"), kSelectedPushedImage },
+        { _T("selectedpushedimage"), kSelectedPushedImage },
+        { _T("selected_disabled_image"), kSelectedDisabledImage },
+        { _T("selecteddisabledimage"), kSelectedDisabledImage },
+        { _T("selected_fore_normal_image"), kSelectedForeNormalImage },
+        { _T("selectedforenormalimage"), kSelectedForeNormalImage },
+        { _T("selected_fore_hot_image"), kSelectedForeHotImage },
+        { _T("selectedforehotimage"), kSelectedForeHotImage },
+        { _T("selected_fore_pushed_image"), kSelectedForePushedImage },
+        { _T("selectedforepushedimage"), kSelectedForePushedImage },
+        { _T("selected_fore_disabled_image"), kSelectedForeDisabledImage },
+        { _T("selectedforedisabledimage"), kSelectedForeDisabledImage },
+        { _T("part_selected_normal_image"), kPartSelectedNormalImage },
+        { _T("part_selected_hot_image"), kPartSelectedHotImage },
+        { _T("part_selected_pushed_image"), kPartSelectedPushedImage },
+        { _T("part_selected_disabled_image"), kPartSelectedDisabledImage },
+        { _T("part_selected_fore_normal_image"), kPartSelectedForeNormalImage },
+        { _T("part_selected_fore_hot_image"), kPartSelectedForeHotImage },
+        { _T("part_selected_fore_pushed_image"), kPartSelectedForePushedImage },
+        { _T("part_selected_fore_disabled_image"), kPartSelectedForeDisabledImage },
+        { _T("selected_text_color"), kSelectedTextColor },
+        { _T("selectedtextcolor"), kSelectedTextColor },
+        { _T("selected_normal_text_color"), kSelectedNormalTextColor },
+        { _T("selectednormaltextcolor"), kSelectedNormalTextColor },
+        { _T("selected_hot_text_color"), kSelectedHotTextColor },
+        { _T("selectedhottextcolor"), kSelectedHotTextColor },
+        { _T("selected_pushed_text_color"), kSelectedPushedTextColor },
+        { _T("selectedpushedtextcolor"), kSelectedPushedTextColor },
+        { _T("selected_disabled_text_color"), kSelectedDisabledTextColor },
+        { _T("selecteddisabledtextcolor"), kSelectedDisabledTextColor },
+        { _T("selected_normal_color"), kSelectedNormalColor },
+        { _T("selectednormalcolor"), kSelectedNormalColor },
+        { _T("selected_hot_color"), kSelectedHotColor },
+        { _T("selectedhotcolor"), kSelectedHotColor },
+        { _T("selected_pushed_color"), kSelectedPushedColor },
+        { _T("selectedpushedcolor"), kSelectedPushedColor },
+        { _T("selected_disabled_color"), kSelectedDisabledColor },
+        { _T("selecteddisabledcolor"), kSelectedDisabledColor },
+        { _T("switch_select"), kSwitchSelect },
+        { _T("switchselect"), kSwitchSelect },
+        { _T("auto_check_select"), kAutoCheckSelect },
+    });
+    switch (attributeTable.Find(strName)) {
+    case kSelected:
         Selected(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("normal_first")) || (strName == _T("normalfirst"))) {
+        break;
+    case kNormalFirst:
         SetPaintNormalFirst(strValue == _T("true"));
-    }
-    else if ((strName == _T("selected_normal_image")) || (strName == _T("selectednormalimage"))) {
+        break;
+    case kSelectedNormalImage:
         SetSelectedStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_image")) || (strName == _T("selectedhotimage"))) {
+        break;
+    case kSelectedHotImage:
         SetSelectedStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_image")) || (strName == _T("selectedpushedimage"))) {
+        break;
+    case kSelectedPushedImage:
         SetSelectedStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_image")) || (strName == _T("selecteddisabledimage"))) {
+        break;
+    case kSelectedDisabledImage:
         SetSelectedStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_fore_normal_image")) || (strName == _T("selectedforenormalimage"))) {
+        break;
+    case kSelectedForeNormalImage:
         SetSelectedForeStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_fore_hot_image")) || (strName == _T("selectedforehotimage"))) {
+        break;
+    case kSelectedForeHotImage:
         SetSelectedForeStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_fore_pushed_image")) || (strName == _T("selectedforepushedimage"))) {
+        break;
+    case kSelectedForePushedImage:
         SetSelectedForeStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_fore_disabled_image")) || (strName == _T("selectedforedisabledimage"))) {
+        break;
+    case kSelectedForeDisabledImage:
         SetSelectedForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("part_selected_normal_image")) {
+        break;
+    case kPartSelectedNormalImage:
         SetPartSelectedStateImage(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("part_selected_hot_image")) {
+        break;
+    case kPartSelectedHotImage:
         SetPartSelectedStateImage(kControlStateHot, strValue);
-    }
-    else if (strName == _T("part_selected_pushed_image")) {
+        break;
+    case kPartSelectedPushedImage:
         SetPartSelectedStateImage(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("part_selected_disabled_image")) {
+        break;
+    case kPartSelectedDisabledImage:
         SetPartSelectedStateImage(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("part_selected_fore_normal_image")) {
+        break;
+    case kPartSelectedForeNormalImage:
         SetPartSelectedForeStateImage(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("part_selected_fore_hot_image")) {
+        break;
+    case kPartSelectedForeHotImage:
         SetPartSelectedForeStateImage(kControlStateHot, strValue);
-    }
-    else if (strName == _T("part_selected_fore_pushed_image")) {
+        break;
+    case kPartSelectedForePushedImage:
         SetPartSelectedForeStateImage(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("part_selected_fore_disabled_image")) {
+        break;
+    case kPartSelectedForeDisabledImage:
         SetPartSelectedForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_text_color")) || (strName == _T("selectedtextcolor"))) {
+        break;
+    case kSelectedTextColor:
         SetSelectedTextColor(strValue);
-    }
-    else if ((strName == _T("selected_normal_text_color")) || (strName == _T("selectednormaltextcolor"))) {
+        break;
+    case kSelectedNormalTextColor:
         SetSelectedStateTextColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_text_color")) || (strName == _T("selectedhottextcolor"))) {
+        break;
+    case kSelectedHotTextColor:
         SetSelectedStateTextColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_text_color")) || (strName == _T("selectedpushedtextcolor"))) {
+        break;
+    case kSelectedPushedTextColor:
         SetSelectedStateTextColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_text_color")) || (strName == _T("selecteddisabledtextcolor"))) {
+        break;
+    case kSelectedDisabledTextColor:
         SetSelectedStateTextColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_normal_color")) || (strName == _T("selectednormalcolor"))) {
+        break;
+    case kSelectedNormalColor:
         SetSelectedStateColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_color")) || (strName == _T("selectedhotcolor"))) {
+        break;
+    case kSelectedHotColor:
         SetSelectedStateColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_color")) || (strName == _T("selectedpushedcolor"))) {
+        break;
+    case kSelectedPushedColor:
         SetSelectedStateColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_color")) || (strName == _T("selecteddisabledcolor"))) {
+        break;
+    case kSelectedDisabledColor:
         SetSelectedStateColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("switch_select")) || (strName == _T("switchselect"))) {
+        break;
+    case kSwitchSelect:
         Selected(!IsSelected());
-    }
-    else if (strName == _T("auto_check_select")) {
+        break;
+    case kAutoCheckSelect:
         SetAutoCheckSelect(strValue == _T("true"));
-    }
-    else {
+        break;
+    default:
         BaseClass::SetAttribute(strName, strValue);
+        break;
     }
 }
 
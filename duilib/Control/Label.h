@@ -10,6 +10,7 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Animation/AnimationManager.h"
 #include "duilib/Animation/AnimationPlayer.h"
@@ -197,100 +198,152 @@ inline DString LabelTemplate<Box>::GetType() const { return DUI_CTR_LABELBOX; }
 template<typename InheritType>
 void LabelTemplate<InheritType>::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if ((strName == _T("text_align")) || (strName == _T("align"))) {
-        if (strValue.find(_T("left")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_CENTER | TEXT_RIGHT);
-            m_uTextStyle |= TEXT_LEFT;
-        }
-        //center这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
-        size_t centerPos = strValue.find(_T("center"));
-        if (centerPos != DString::npos) {
-            bool isCenter = true;
-            size_t vCenterPos = strValue.find(_T("vcenter"));
-            if (vCenterPos != DString::npos) {
-                if ((vCenterPos + 1) == centerPos) {
-                    isCenter = false;
+    //按属性名称的序号分发，同一个属性的多个名称对应同一个序号
+    enum AttributeId : int32_t
+    {
+        kTextAlign,
+        kEndEllipsis,
+        kPathEllipsis,
+        kSingleLine,
+        kMultiLine,
+        kText,
+        kTextId,
+        kAutoTooltip,
+        kFont,
+        kNormalTextColor,
+        kHotTextColor,
+        kPushedTextColor,
+        kDisabledTextColor,
+        kTextPadding,
+    };
+    static const AttributeTable attributeTable({
+        { _T("text_align"), kTextAlign },
+        { _T("align"), kTextAlign },
+        { _T("end_ellipsis"), kEndEllipsis },
+        { _T("endellipsis"), kEndEllipsis },
+        { _T("path_ellipsis"), kPathEllipsis },
+        { _T("pathellipsis"), kPathEllipsis },
+        { _T("single_line"), kSingleLine },
+        { _T("singleline"), kSingleLine },
+        { _T("multi_line"), kMultiLine },
+        { _T("multiline"), kMultiLine },
+        { _T("text"), kText },
+        { _T("text_id"), kTextId },
+        { _T("textid"), kTextId },
+        { _T("auto_tooltip"), kAutoTooltip },
+        { _T("autotooltip"), kAutoTooltip },
+        { _T("font"), kFont },
+        { _T("normal_text_color"), kNormalTextColor },
+        { _T("normaltextcolor"), kNormalTextColor },
+        { _T("hot_text_color"), kHotTextColor },
+        { _T("hottextcolor"), kHotTextColor },
+        { _T("pushed_text_color"), kPushedTextColor },
+        { _T("pushedtextcolor"), kPushedTextColor },
+        { _T("disabled_text_color"), kDisabledTextColor },
+        { _T("disabledtextcolor"), kDisabledTextColor },
+        { _T("text_padding"), kTextPadding },
+        { _T("textpadding"), kTextPadding },
+    });
+    switch (attributeTable.Find(strName)) {
+    case kTextAlign:
+        {
+            if (strValue.find(_T("left")) != DString::npos) {
+                m_uTextStyle &= ~(TEXT_CENTER | TEXT_RIGHT);
+                m_uTextStyle |= TEXT_LEFT;
+            }
+            //center这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
+            size_t centerPos = strValue.find(_T("center"));
+            if (centerPos != DString::npos) {
+                bool isCenter = true;
+                size_t vCenterPos = strValue.find(_T("vcenter"));
+                if (vCenterPos != DString::npos) {
+                    if ((vCenterPos + 1) == centerPos) {
+                        isCenter = false;
+                    }
+                }
+                if (isCenter) {
+                    m_uTextStyle &= ~(TEXT_LEFT | TEXT_RIGHT);
+                    m_uTextStyle |= TEXT_CENTER;
                 }
             }
-            if (isCenter) {
+            if (strValue.find(_T("hcenter")) != DString::npos) {
                 m_uTextStyle &= ~(TEXT_LEFT | TEXT_RIGHT);
                 m_uTextStyle |= TEXT_CENTER;
             }
+            if (strValue.find(_T("right")) != DString::npos) {
+                m_uTextStyle &= ~(TEXT_LEFT | TEXT_CENTER);
+                m_uTextStyle |= TEXT_RIGHT;
+            }
+            if (strValue.find(_T("top")) != DString::npos) {
+                m_uTextStyle &= ~(TEXT_BOTTOM | TEXT_VCENTER);
+                m_uTextStyle |= TEXT_TOP;
+            }
+            if (strValue.find(_T("vcenter")) != DString::npos) {
+                m_uTextStyle &= ~(TEXT_TOP | TEXT_BOTTOM);
+                m_uTextStyle |= TEXT_VCENTER;
+            }
+            if (strValue.find(_T("bottom")) != DString::npos) {
+                m_uTextStyle &= ~(TEXT_TOP | TEXT_VCENTER);
+                m_uTextStyle |= TEXT_BOTTOM;
+            }
         }
-        if (strValue.find(_T("hcenter")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_LEFT | TEXT_RIGHT);
-            m_uTextStyle |= TEXT_CENTER;
-        }
-        if (strValue.find(_T("right")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_LEFT | TEXT_CENTER);
-            m_uTextStyle |= TEXT_RIGHT;
-        }
-        if (strValue.find(_T("top")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_BOTTOM | TEXT_VCENTER);
-            m_uTextStyle |= TEXT_TOP;
-        }
-        if (strValue.find(_T("vcenter")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_TOP | TEXT_BOTTOM);
-            m_uTextStyle |= TEXT_VCENTER;
-        }
-        if (strValue.find(_T("bottom")) != DString::npos) {
-            m_uTextStyle &= ~(TEXT_TOP | TEXT_VCENTER);
-            m_uTextStyle |= TEXT_BOTTOM;
-        }
-    }
-    else if ((strName == _T("end_ellipsis")) || (strName == _T("endellipsis"))) {
+        break;
+    case kEndEllipsis:
         if (strValue == _T("true")) {
             m_uTextStyle |= TEXT_END_ELLIPSIS;
         }
         else {
             m_uTextStyle &= ~TEXT_END_ELLIPSIS;
         }
-    }
-    else if ((strName == _T("path_ellipsis")) || (strName == _T("pathellipsis"))) {
+        break;
+    case kPathEllipsis:
         if (strValue == _T("true")) {
             m_uTextStyle |= TEXT_PATH_ELLIPSIS;
         }
         else {
             m_uTextStyle &= ~TEXT_PATH_ELLIPSIS;
         }
-    }
-    else if ((strName == _T("single_line")) || (strName == _T("singleline"))) {
+        break;
+    case kSingleLine:
         SetSingleLine(strValue == _T("true"));
-    }
-    else if ((strName == _T("multi_line")) || (strName == _T("multiline"))) {
+        break;
+    case kMultiLine:
         SetSingleLine(strValue != _T("true"));
-    }
-    else if (strName == _T("text")) {
+        break;
+    case kText:
         SetText(strValue);
-    }
-    else if ((strName == _T("text_id")) || (strName == _T("textid"))){
+        break;
+    case kTextId:
         SetTextId(strValue);
-    }
-    else if ((strName == _T("auto_tooltip")) || (strName == _T("autotooltip"))) {
+        break;
+    case kAutoTooltip:
         SetAutoToolTip(strValue == _T("true"));
-    }
-    else if (strName == _T("font")) {
+        break;
+    case kFont:
         SetFontId(strValue);
-    }
-    else if ((strName == _T("normal_text_color")) || (strName == _T("normaltextcolor"))) {
+        break;
+    case kNormalTextColor:
         SetStateTextColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_text_color")) || (strName == _T("hottextcolor"))) {
+        break;
+    case kHotTextColor:
         SetStateTextColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_text_color")) || (strName == _T("pushedtextcolor"))) {
+        break;
+    case kPushedTextColor:
         SetStateTextColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_text_color")) || (strName == _T("disabledtextcolor"))) {
+        break;
+    case kDisabledTextColor:
         SetStateTextColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("text_padding")) || (strName == _T("textpadding"))) {
-        UiPadding rcTextPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
-        SetTextPadding(rcTextPadding, true);
-    }
-    else {
+        break;
+    case kTextPadding:
+        {
+            UiPadding rcTextPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
+            SetTextPadding(rcTextPadding, true);
+        }
+        break;
+    default:
         BaseClass::SetAttribute(strName, strValue);
+        break;
     }
 }
 
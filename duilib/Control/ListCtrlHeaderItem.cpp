@@ -81,11 +81,12 @@ void ListCtrlHeaderItem::PaintText(IRender* pRender)
     }
     //文本前的图标
     ImagePtr pItemImage;
+    ImageList* pImageList = nullptr;
     UiSize itemImageSize;
     if ((m_imageId >= 0) && (m_pHeaderCtrl != nullptr)) {
         ListCtrl* pListCtrl = m_pHeaderCtrl->GetListCtrl();
         if (pListCtrl != nullptr) {
-            ImageList* pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
+            pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
             if (pImageList != nullptr) {
                 itemImageSize = pImageList->GetImageSize();
                 pItemImage = pImageList->GetImageData(m_imageId);
@@ -107,6 +108,9 @@ void ListCtrlHeaderItem::PaintText(IRender* pRender)
                 pItemImage = nullptr;
                 pItemImageCache.reset();
             }
+            else if (pImageList != nullptr) {
+                pImageList->CheckImageAtlas(*pItemImage);
+            }
         }
     }
 
@@ -249,10 +249,11 @@ void ListCtrlItem::Paint(IRender* pRender, const UiRect& rcPaint)
 ImagePtr ListCtrlItem::LoadItemImage() const
 {
     ImagePtr pItemImage;
+    ImageList* pImageList = nullptr;
     if (m_imageId >= 0) {
         ListCtrl* pListCtrl = GetListCtrl();
         if (pListCtrl != nullptr) {
-            ImageList* pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
+            pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
             if (pImageList != nullptr) {
                 pItemImage = pImageList->GetImageData(m_imageId);
                 ASSERT(pItemImage != nullptr);
@@ -270,6 +271,9 @@ ImagePtr ListCtrlItem::LoadItemImage() const
                 (pItemImageCache->GetHeight() <= 0)) {
                 pItemImage = nullptr;
             }
+            else if (pImageList != nullptr) {
+                pImageList->CheckImageAtlas(*pItemImage);
+            }
         }
     }
     return pItemImage;
@@ -189,10 +189,11 @@ int32_t ListCtrlSubItem::GetIconSpacing() const
 ImagePtr ListCtrlSubItem::LoadItemImage() const
 {
     ImagePtr pItemImage;
+    ImageList* pImageList = nullptr;
     if ((m_imageId >= 0) && (m_pItem != nullptr)) {
         ListCtrl* pListCtrl = m_pItem->GetListCtrl();
         if (pListCtrl != nullptr) {
-            ImageList* pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
+            pImageList = pListCtrl->GetImageList(ListCtrlType::Report);
             if (pImageList != nullptr) {
                 pItemImage = pImageList->GetImageData(m_imageId);
                 ASSERT(pItemImage != nullptr);
@@ -210,6 +211,9 @@ ImagePtr ListCtrlSubItem::LoadItemImage() const
                 (pItemImageCache->GetHeight() <= 0)) {
                 pItemImage = nullptr;
             }
+            else if (pImageList != nullptr) {
+                pImageList->CheckImageAtlas(*pItemImage);
+            }
         }
     }
     return pItemImage;
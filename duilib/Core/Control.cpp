@@ -13,6 +13,7 @@
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 
 namespace ui 
 {
@@ -97,10 +98,213 @@ DString Control::GetType() const { return DUI_CTR_CONTROL; }
 void Control::SetAttribute(const DString& strName, const DString& strValue)
 {
     ASSERT(GetWindow() != nullptr);//由于需要做DPI感知功能，所以必须先设置关联窗口
-    if (strName == _T("class")) {
+    //按属性名称的序号分发，同一个属性的多个名称对应同一个序号
+    enum AttributeId : int32_t
+    {
+        kClass,
+        kHalign,
+        kValign,
+        kMargin,
+        kPadding,
+        kControlPadding,
+        kBkcolor,
+        kBkcolor2,
+        kBkcolor2Direction,
+        kBorderSize,
+        kBorderRound,
+        kBoxShadow,
+        kWidth,
+        kHeight,
+        kState,
+        kCursorType,
+        kRenderOffset,
+        kNormalColor,
+        kHotColor,
+        kPushedColor,
+        kDisabledColor,
+        kBorderColor,
+        kNormalBorderColor,
+        kHotBorderColor,
+        kPushedBorderColor,
+        kDisabledBorderColor,
+        kFocusBorderColor,
+        kLeftBorderSize,
+        kTopBorderSize,
+        kRightBorderSize,
+        kBottomBorderSize,
+        kBkimage,
+        kMinWidth,
+        kMaxWidth,
+        kMinHeight,
+        kMaxHeight,
+        kName,
+        kTooltipText,
+        kTooltipTextId,
+        kTooltipWidth,
+        kDataId,
+        kUserDataId,
+        kEnabled,
+        kMouseEnabled,
+        kKeyboardEnabled,
+        kVisible,
+        kFadeVisible,
+        kFloat,
+        kCache,
+        kNoFocus,
+        kAlpha,
+        kNormalImage,
+        kHotImage,
+        kPushedImage,
+        kDisabledImage,
+        kForeNormalImage,
+        kForeHotImage,
+        kForePushedImage,
+        kForeDisabledImage,
+        kFadeAlpha,
+        kFadeHot,
+        kFadeWidth,
+        kFadeHeight,
+        kFadeInOutXFromLeft,
+        kFadeInOutXFromRight,
+        kFadeInOutYFromTop,
+        kFadeInOutYFromBottom,
+        kTabStop,
+        kLoadingImage,
+        kLoadingBkcolor,
+        kShowFocusRect,
+        kFocusRectColor,
+        kPaintOrder,
+        kStartGifPlay,
+        kStopGifPlay,
+    };
+    static const AttributeTable attributeTable({
+        { _T("class"), kClass },
+        { _T("halign"), kHalign },
+        { _T("valign"), kValign },
+        { _T("margin"), kMargin },
+        { _T("padding"), kPadding },
+        { _T("control_padding"), kControlPadding },
+        { _T("bkcolor"), kBkcolor },
+        { _T("bkcolor2"), kBkcolor2 },
+        { _T("bkcolor2_direction"), kBkcolor2Direction },
+        { _T("border_size"), kBorderSize },
+        { _T("bordersize"), kBorderSize },
+        { _T("border_round"), kBorderRound },
+        { _T("borderround"), kBorderRound },
+        { _T("box_shadow"), kBoxShadow },
+        { _T("boxshadow"), kBoxShadow },
+        { _T("width"), kWidth },
+        { _T("height"), kHeight },
+        { _T("state"), kState },
+        { _T("cursor_type"), kCursorType },
+        { _T("cursortype"), kCursorType },
+        { _T("render_offset"), kRenderOffset },
+        { _T("renderoffset"), kRenderOffset },
+        { _T("normal_color"), kNormalColor },
+        { _T("normalcolor"), kNormalColor },
+        { _T("hot_color"), kHotColor },
+        { _T("hotcolor"), kHotColor },
+        { _T("pushed_color"), kPushedColor },
+        { _T("pushedcolor"), kPushedColor },
+        { _T("disabled_color"), kDisabledColor },
+        { _T("disabledcolor"), kDisabledColor },
+        { _T("border_color"), kBorderColor },
+        { _T("bordercolor"), kBorderColor },
+        { _T("normal_border_color"), kNormalBorderColor },
+        { _T("hot_border_color"), kHotBorderColor },
+        { _T("pushed_border_color"), kPushedBorderColor },
+        { _T("disabled_border_color"), kDisabledBorderColor },
+        { _T("focus_border_color"), kFocusBorderColor },
+        { _T("left_border_size"), kLeftBorderSize },
+        { _T("leftbordersize"), kLeftBorderSize },
+        { _T("top_border_size"), kTopBorderSize },
+        { _T("topbordersize"), kTopBorderSize },
+        { _T("right_border_size"), kRightBorderSize },
+        { _T("rightbordersize"), kRightBorderSize },
+        { _T("bottom_border_size"), kBottomBorderSize },
+        { _T("bottombordersize"), kBottomBorderSize },
+        { _T("bkimage"), kBkimage },
+        { _T("min_width"), kMinWidth },
+        { _T("minwidth"), kMinWidth },
+        { _T("max_width"), kMaxWidth },
+        { _T("maxwidth"), kMaxWidth },
+        { _T("min_height"), kMinHeight },
+        { _T("minheight"), kMinHeight },
+        { _T("max_height"), kMaxHeight },
+        { _T("maxheight"), kMaxHeight },
+        { _T("name"), kName },
+        { _T("tooltip_text"), kTooltipText },
+        { _T("tooltiptext"), kTooltipText },
+        { _T("tooltip_text_id"), kTooltipTextId },
+        { _T("tooltip_textid"), kTooltipTextId },
+        { _T("tooltiptextid"), kTooltipTextId },
+        { _T("tooltip_width"), kTooltipWidth },
+        { _T("data_id"), kDataId },
+        { _T("dataid"), kDataId },
+        { _T("user_data_id"), kUserDataId },
+        { _T("user_dataid"), kUserDataId },
+        { _T("enabled"), kEnabled },
+        { _T("mouse_enabled"), kMouseEnabled },
+        { _T("mouse"), kMouseEnabled },
+        { _T("keyboard_enabled"), kKeyboardEnabled },
+        { _T("keyboard"), kKeyboardEnabled },
+        { _T("visible"), kVisible },
+        { _T("fade_visible"), kFadeVisible },
+        { _T("fadevisible"), kFadeVisible },
+        { _T("float"), kFloat },
+        { _T("cache"), kCache },
+        { _T("no_focus"), kNoFocus },
+        { _T("nofocus"), kNoFocus },
+        { _T("alpha"), kAlpha },
+        { _T("normal_image"), kNormalImage },
+        { _T("normalimage"), kNormalImage },
+        { _T("hot_image"), kHotImage },
+        { _T("hotimage"), kHotImage },
+        { _T("pushed_image"), kPushedImage },
+        { _T("pushedimage"), kPushedImage },
+        { _T("disabled_image"), kDisabledImage },
+        { _T("disabledimage"), kDisabledImage },
+        { _T("fore_normal_image"), kForeNormalImage },
+        { _T("forenormalimage"), kForeNormalImage },
+        { _T("fore_hot_image"), kForeHotImage },
+        { _T("forehotimage"), kForeHotImage },
+        { _T("fore_pushed_image"), kForePushedImage },
+        { _T("forepushedimage"), kForePushedImage },
+        { _T("fore_disabled_image"), kForeDisabledImage },
+        { _T("foredisabledimage"), kForeDisabledImage },
+        { _T("fade_alpha"), kFadeAlpha },
+        { _T("fadealpha"), kFadeAlpha },
+        { _T("fade_hot"), kFadeHot },
+        { _T("fadehot"), kFadeHot },
+        { _T("fade_width"), kFadeWidth },
+        { _T("fadewidth"), kFadeWidth },
+        { _T("fade_height"), kFadeHeight },
+        { _T("fadeheight"), kFadeHeight },
+        { _T("fade_in_out_x_from_left"), kFadeInOutXFromLeft },
+        { _T("fadeinoutxfromleft"), kFadeInOutXFromLeft },
+        { _T("fade_in_out_x_from_right"), kFadeInOutXFromRight },
+        { _T("fadeinoutxfromright"), kFadeInOutXFromRight },
+        { _T("fade_in_out_y_from_top"), kFadeInOutYFromTop },
+        { _T("fadeinoutyfromtop"), kFadeInOutYFromTop },
+        { _T("fade_in_out_y_from_bottom"), kFadeInOutYFromBottom },
+        { _T("fadeinoutyfrombottom"), kFadeInOutYFromBottom },
+        { _T("tab_stop"), kTabStop },
+        { _T("tabstop"), kTabStop },
+        { _T("loading_image"), kLoadingImage },
+        { _T("loadingimage"), kLoadingImage },
+        { _T("loading_bkcolor"), kLoadingBkcolor },
+        { _T("loadingbkcolor"), kLoadingBkcolor },
+        { _T("show_focus_rect"), kShowFocusRect },
+        { _T("focus_rect_color"), kFocusRectColor },
+        { _T("paint_order"), kPaintOrder },
+        { _T("start_gif_play"), kStartGifPlay },
+        { _T("stop_gif_play"), kStopGifPlay },
+    });
+    switch (attributeTable.Find(strName)) {
+    case kClass:
         SetClass(strValue);
-    }
-    else if (strName == _T("halign")) {
+        break;
+    case kHalign:
         if (strValue == _T("left")) {
             SetHorAlignType(kHorAlignLeft);
         }
@@ -113,8 +317,8 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             ASSERT(0);
         }
-    }
-    else if (strName == _T("valign")) {
+        break;
+    case kValign:
         if (strValue == _T("top")) {
             SetVerAlignType(kVerAlignTop);
         }
@@ -127,58 +331,66 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             ASSERT(0);
         }
-    }
-    else if (strName == _T("margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetMargin(rcMargin, true);
-    }
-    else if (strName == _T("padding")) {
-        UiPadding rcPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
-        SetPadding(rcPadding, true);
-    }
-    else if (strName == _T("control_padding")) {
+        break;
+    case kMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetMargin(rcMargin, true);
+        }
+        break;
+    case kPadding:
+        {
+            UiPadding rcPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
+            SetPadding(rcPadding, true);
+        }
+        break;
+    case kControlPadding:
         SetEnableControlPadding(strValue == _T("true"));
-    }
-    else if (strName == _T("bkcolor")) {
+        break;
+    case kBkcolor:
         //背景色
         SetBkColor(strValue);
-    }
-    else if (strName == _T("bkcolor2")) {
+        break;
+    case kBkcolor2:
         //第二背景色（实现渐变背景色）
         SetBkColor2(strValue);
-    }
-    else if (strName == _T("bkcolor2_direction")) {
+        break;
+    case kBkcolor2Direction:
         //第二背景色的方向："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
         SetBkColor2Direction(strValue);
-    }
-    else if ((strName == _T("border_size")) || (strName == _T("bordersize"))) {
-        DString nValue = strValue;
-        if (nValue.find(_T(',')) == DString::npos) {
-            int32_t nBorderSize = StringUtil::StringToInt32(strValue);
-            if (nBorderSize < 0) {
-                nBorderSize = 0;
+        break;
+    case kBorderSize:
+        {
+            DString nValue = strValue;
+            if (nValue.find(_T(',')) == DString::npos) {
+                int32_t nBorderSize = StringUtil::StringToInt32(strValue);
+                if (nBorderSize < 0) {
+                    nBorderSize = 0;
+                }
+                UiRect rcBorder(nBorderSize, nBorderSize, nBorderSize, nBorderSize);
+                SetBorderSize(rcBorder, true);
+            }
+            else {
+                UiMargin rcMargin;
+                AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+                UiRect rcBorder(rcMargin.left, rcMargin.top, rcMargin.right, rcMargin.bottom);
+                SetBorderSize(rcBorder, true);
             }
-            UiRect rcBorder(nBorderSize, nBorderSize, nBorderSize, nBorderSize);
-            SetBorderSize(rcBorder, true);
         }
-        else {
-            UiMargin rcMargin;
-            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-            UiRect rcBorder(rcMargin.left, rcMargin.top, rcMargin.right, rcMargin.bottom);
-            SetBorderSize(rcBorder, true);
+        break;
+    case kBorderRound:
+        {
+            UiSize cxyRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
+            SetBorderRound(cxyRound, true);
         }
-    }
-    else if ((strName == _T("border_round")) || (strName == _T("borderround"))) {
-        UiSize cxyRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
-        SetBorderRound(cxyRound, true);
-    }
-    else if ((strName == _T("box_shadow")) || (strName == _T("boxshadow"))) {
+        break;
+    case kBoxShadow:
         SetBoxShadow(strValue);
-    }
-    else if (strName == _T("width")) {
+        break;
+    case kWidth:
         if (strValue == _T("stretch")) {
             //宽度为拉伸：由父容器负责分配宽度
             SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
@@ -205,8 +417,8 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             SetFixedWidth(UiFixedInt(0), true, true);
         }
-    }
-    else if (strName == _T("height")) {
+        break;
+    case kHeight:
         if (strValue == _T("stretch")) {
             //高度为拉伸：由父容器负责分配高度
             SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
@@ -233,8 +445,8 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             SetFixedHeight(UiFixedInt(0), true, true);
         }
-    }
-    else if (strName == _T("state")) {
+        break;
+    case kState:
         if (strValue == _T("normal")) {
             SetState(kControlStateNormal);
         }
@@ -250,8 +462,8 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             ASSERT(0);
         }
-    }
-    else if ((strName == _T("cursor_type")) || (strName == _T("cursortype"))) {
+        break;
+    case kCursorType:
         if (strValue == _T("arrow")) {
             SetCursorType(CursorType::kCursorArrow);
         }
@@ -288,192 +500,200 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
         else {
             ASSERT(0);
         }
-    }
-    else if ((strName == _T("render_offset")) || (strName == _T("renderoffset"))) {
-        UiPoint renderOffset;
-        AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
-        SetRenderOffset(renderOffset, true);
-    }
-    else if ((strName == _T("normal_color")) || (strName == _T("normalcolor"))) {
+        break;
+    case kRenderOffset:
+        {
+            UiPoint renderOffset;
+            AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
+            SetRenderOffset(renderOffset, true);
+        }
+        break;
+    case kNormalColor:
         SetStateColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_color")) || (strName == _T("hotcolor"))) {
+        break;
+    case kHotColor:
         SetStateColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_color")) || (strName == _T("pushedcolor"))) {
+        break;
+    case kPushedColor:
         SetStateColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_color")) || (strName == _T("disabledcolor"))) {
+        break;
+    case kDisabledColor:
         SetStateColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("border_color")) || (strName == _T("bordercolor"))) {
+        break;
+    case kBorderColor:
         SetBorderColor(strValue);
-    }
-    else if (strName == _T("normal_border_color")) {
+        break;
+    case kNormalBorderColor:
         SetBorderColor(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("hot_border_color")) {
+        break;
+    case kHotBorderColor:
         SetBorderColor(kControlStateHot, strValue);
-    }
-    else if (strName == _T("pushed_border_color")) {
+        break;
+    case kPushedBorderColor:
         SetBorderColor(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("disabled_border_color")) {
+        break;
+    case kDisabledBorderColor:
         SetBorderColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("focus_border_color")) {
+        break;
+    case kFocusBorderColor:
         SetFocusBorderColor(strValue);
-    }
-    else if ((strName == _T("left_border_size")) || (strName == _T("leftbordersize"))) {
+        break;
+    case kLeftBorderSize:
         SetLeftBorderSize(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("top_border_size")) || (strName == _T("topbordersize"))) {
+        break;
+    case kTopBorderSize:
         SetTopBorderSize(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("right_border_size")) || (strName == _T("rightbordersize"))) {
+        break;
+    case kRightBorderSize:
         SetRightBorderSize(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("bottom_border_size")) || (strName == _T("bottombordersize"))) {
+        break;
+    case kBottomBorderSize:
         SetBottomBorderSize(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("bkimage")) {
+        break;
+    case kBkimage:
         SetBkImage(strValue);
-    }
-    else if ((strName == _T("min_width")) || (strName == _T("minwidth"))) {
+        break;
+    case kMinWidth:
         SetMinWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_width")) || (strName == _T("maxwidth"))) {
+        break;
+    case kMaxWidth:
         SetMaxWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("min_height")) || (strName == _T("minheight"))) {
+        break;
+    case kMinHeight:
         SetMinHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_height")) || (strName == _T("maxheight"))) {
+        break;
+    case kMaxHeight:
         SetMaxHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("name")) {
+        break;
+    case kName:
         SetName(strValue);
-    }
-    else if ((strName == _T("tooltip_text")) || (strName == _T("tooltiptext"))) {
+        break;
+    case kTooltipText:
         SetToolTipText(strValue);
-    }
-    else if ((strName == _T("tooltip_text_id")) || (strName == _T("tooltip_textid")) || (strName == _T("tooltiptextid"))) {
+        break;
+    case kTooltipTextId:
         SetToolTipTextId(strValue);
-    }
-    else if (strName == _T("tooltip_width")) {
-
+        break;
+    case kTooltipWidth:
         SetToolTipWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("data_id")) || (strName == _T("dataid"))) {
+        break;
+    case kDataId:
         SetDataID(strValue);
-    }
-    else if ((strName == _T("user_data_id")) || (strName == _T("user_dataid"))) {
+        break;
+    case kUserDataId:
         SetUserDataID(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("enabled")) {
+        break;
+    case kEnabled:
         SetEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("mouse_enabled")) || (strName == _T("mouse"))) {
+        break;
+    case kMouseEnabled:
         SetMouseEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("keyboard_enabled")) || (strName == _T("keyboard"))) {
+        break;
+    case kKeyboardEnabled:
         SetKeyboardEnabled(strValue == _T("true"));
-    }
-    else if (strName == _T("visible")) {
+        break;
+    case kVisible:
         SetVisible(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_visible")) || (strName == _T("fadevisible"))) {
+        break;
+    case kFadeVisible:
         SetFadeVisible(strValue == _T("true"));
-    }
-    else if (strName == _T("float")) {
+        break;
+    case kFloat:
         SetFloat(strValue == _T("true"));
-    }
-    else if (strName == _T("cache")) {
+        break;
+    case kCache:
         SetUseCache(strValue == _T("true"));
-    }
-    else if ((strName == _T("no_focus")) || (strName == _T("nofocus"))) {
+        break;
+    case kNoFocus:
         SetNoFocus();
-    }
-    else if (strName == _T("alpha")) {
+        break;
+    case kAlpha:
         SetAlpha(StringUtil::StringToInt32(strValue));
-    }
-    else if ((strName == _T("normal_image")) || (strName == _T("normalimage"))) {
+        break;
+    case kNormalImage:
         SetStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_image")) || (strName == _T("hotimage"))) {
+        break;
+    case kHotImage:
         SetStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_image")) || (strName == _T("pushedimage"))) {
+        break;
+    case kPushedImage:
         SetStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_image")) || (strName == _T("disabledimage"))) {
+        break;
+    case kDisabledImage:
         SetStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fore_normal_image")) || (strName == _T("forenormalimage"))) {
+        break;
+    case kForeNormalImage:
         SetForeStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("fore_hot_image")) || (strName == _T("forehotimage"))) {
+        break;
+    case kForeHotImage:
         SetForeStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("fore_pushed_image")) || (strName == _T("forepushedimage"))) {
+        break;
+    case kForePushedImage:
         SetForeStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("fore_disabled_image")) || (strName == _T("foredisabledimage"))) {
+        break;
+    case kForeDisabledImage:
         SetForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fade_alpha")) || (strName == _T("fadealpha"))) {
+        break;
+    case kFadeAlpha:
         GetAnimationManager().SetFadeAlpha(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_hot")) || (strName == _T("fadehot"))) {
+        break;
+    case kFadeHot:
         GetAnimationManager().SetFadeHot(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_width")) || (strName == _T("fadewidth"))) {
+        break;
+    case kFadeWidth:
         GetAnimationManager().SetFadeWidth(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_height")) || (strName == _T("fadeheight"))) {
+        break;
+    case kFadeHeight:
         GetAnimationManager().SetFadeHeight(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_in_out_x_from_left")) || (strName == _T("fadeinoutxfromleft"))) {
+        break;
+    case kFadeInOutXFromLeft:
         GetAnimationManager().SetFadeInOutX(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_x_from_right")) || (strName == _T("fadeinoutxfromright"))) {
+        break;
+    case kFadeInOutXFromRight:
         GetAnimationManager().SetFadeInOutX(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("fade_in_out_y_from_top")) || (strName == _T("fadeinoutyfromtop"))) {
+        break;
+    case kFadeInOutYFromTop:
         GetAnimationManager().SetFadeInOutY(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_y_from_bottom")) || (strName == _T("fadeinoutyfrombottom"))) {
+        break;
+    case kFadeInOutYFromBottom:
         GetAnimationManager().SetFadeInOutY(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("tab_stop")) || (strName == _T("tabstop"))) {
+        break;
+    case kTabStop:
         SetTabStop(strValue == _T("true"));
-    }
-    else if ((strName == _T("loading_image")) || (strName == _T("loadingimage"))) {
+        break;
+    case kLoadingImage:
         SetLoadingImage(strValue);
-    }
-    else if ((strName == _T("loading_bkcolor")) || (strName == _T("loadingbkcolor"))) {
+        break;
+    case kLoadingBkcolor:
         SetLoadingBkColor(strValue);
-    }
-    else if (strName == _T("show_focus_rect")) {
+        break;
+    case kShowFocusRect:
         SetShowFocusRect(strValue == _T("true"));
-    }
-    else if (strName == _T("focus_rect_color")) {
+        break;
+    case kFocusRectColor:
         SetFocusRectColor(strValue);
-    }
-    else if (strName == _T("paint_order")) {
-        uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
-        SetPaintOrder(nPaintOrder);
-    }
-    else if (strName == _T("start_gif_play")) {
-        int32_t nPlayCount = StringUtil::StringToInt32(strValue);
-        StartGifPlay(kGifFrameCurrent, nPlayCount);
-    }
-    else if (strName == _T("stop_gif_play")) {
-        GifFrameType nStopFrame = (GifFrameType)StringUtil::StringToInt32(strValue);
-        StopGifPlay(false, nStopFrame);
-    }
-    else {
+        break;
+    case kPaintOrder:
+        {
+            uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
+            SetPaintOrder(nPaintOrder);
+        }
+        break;
+    case kStartGifPlay:
+        {
+            int32_t nPlayCount = StringUtil::StringToInt32(strValue);
+            StartGifPlay(kGifFrameCurrent, nPlayCount);
+        }
+        break;
+    case kStopGifPlay:
+        {
+            GifFrameType nStopFrame = (GifFrameType)StringUtil::StringToInt32(strValue);
+            StopGifPlay(false, nStopFrame);
+        }
+        break;
+    default:
         ASSERT(!"Control::SetAttribute失败: 发现不能识别的属性");
+        break;
     }
 }
 
@@ -560,17 +780,30 @@ void Control::SetClass(const DString& strClass)
     if (strClass.empty()) {
         return;
     }
+    if (strClass.find(_T(' ')) == DString::npos) {
+        //只有一个class（大多数情况），不需要拆分
+        ApplyClass(strClass);
+        return;
+    }
     std::list<DString> splitList = StringUtil::Split(strClass, _T(" "));
     for (auto it = splitList.begin(); it != splitList.end(); it++) {
-        DString pDefaultAttributes = GlobalManager::Instance().GetClassAttributes((*it));
-        Window* pWindow = GetWindow();
-        if (pDefaultAttributes.empty() && (pWindow != nullptr)) {
-            pDefaultAttributes = pWindow->GetClassAttributes(*it);
-        }
+        ApplyClass(*it);
+    }
+}
 
-        ASSERT(!pDefaultAttributes.empty());
-        if (!pDefaultAttributes.empty()) {
-            ApplyAttributeList(pDefaultAttributes);
+void Control::ApplyClass(const DString& strClassName)
+{
+    //Class的属性列表在添加时已经解析，直接应用解析后的属性列表
+    std::shared_ptr<const AttributeList> pAttributeList = GlobalManager::Instance().GetClassAttributeList(strClassName);
+    Window* pWindow = GetWindow();
+    if ((pAttributeList == nullptr) && (pWindow != nullptr)) {
+        pAttributeList = pWindow->GetClassAttributeList(strClassName);
+    }
+
+    ASSERT(pAttributeList != nullptr);
+    if (pAttributeList != nullptr) {
+        for (const auto& attribute : *pAttributeList) {
+            SetAttribute(attribute.first, attribute.second);
         }
     }
 }
@@ -581,13 +814,8 @@ void Control::ApplyAttributeList(const DString& strList)
     if (strList.empty()) {
         return;
     }
-    std::vector<std::pair<DString, DString>> attributeList;
-    if (strList.find(_T('\"')) != DString::npos) {
-        AttributeUtil::ParseAttributeList(strList, _T('\"'), attributeList);
-    }    
-    else if (strList.find(_T('\'')) != DString::npos) {
-        AttributeUtil::ParseAttributeList(strList, _T('\''), attributeList);
-    }
+    AttributeList attributeList;
+    AttributeUtil::ParseAttributeList(strList, attributeList);
     for (const auto& attribute : attributeList) {
         SetAttribute(attribute.first, attribute.second);
     }
@@ -2204,11 +2432,16 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
         return false;
     }
 
-    IBitmap* pBitmap = duiImage.GetCurrentBitmap();
+    //图片在图集中：从图集位图中对应的区域绘制（图片的位图数据已经复制到图集位图中，原位图已释放）
+    UiRect rcAtlas;
+    IBitmap* pAtlasBitmap = duiImage.GetAtlasBitmap(rcAtlas);
+    IBitmap* pBitmap = (pAtlasBitmap != nullptr) ? pAtlasBitmap : duiImage.GetCurrentBitmap();
     ASSERT(pBitmap != nullptr);
     if (pBitmap == nullptr) {
         return false;
     }
+    const uint32_t nBitmapWidth = (pAtlasBitmap != nullptr) ? (uint32_t)rcAtlas.Width() : pBitmap->GetWidth();
+    const uint32_t nBitmapHeight = (pAtlasBitmap != nullptr) ? (uint32_t)rcAtlas.Height() : pBitmap->GetHeight();
 
     ImageAttribute newImageAttribute = duiImage.GetImageAttribute();
     if (!strModify.empty()) {
@@ -2235,11 +2468,14 @@ bool Control::PaintImage(IRender* pRender, Image* pImage,
     UiRect rcDestCorners;
     UiRect rcSource = newImageAttribute.GetImageSourceRect();
     UiRect rcSourceCorners = newImageAttribute.GetImageCorner();
-    ImageAttribute::ScaleImageRect(pBitmap->GetWidth(), pBitmap->GetHeight(), 
+    ImageAttribute::ScaleImageRect(nBitmapWidth, nBitmapHeight, 
                                    Dpi(), imageInfo->IsBitmapSizeDpiScaled(),
                                    rcDestCorners,
                                    rcSource,
                                    rcSourceCorners);
+    if (pAtlasBitmap != nullptr) {
+        rcSource.Offset(rcAtlas.left, rcAtlas.top);
+    }
     
     if (!hasDestAttr) {
         //运用rcPadding、hAlign、vAlign 三个图片属性
@@ -3043,17 +3279,44 @@ bool Control::LoadImageData(Image& duiImage) const
             return true;
         }        
     }
-    Window* pWindow = GetWindow();
-    ASSERT(pWindow != nullptr);
-    if (pWindow == nullptr) {
+    ASSERT(GetWindow() != nullptr);
+    FilePath imageFullPath = GetImageFullPath(duiImage.GetImagePath());
+    if (imageFullPath.IsEmpty()) {
         return false;
     }
 
-    DString sImagePath = duiImage.GetImagePath();
-    if (sImagePath.empty()) {
-        return false;
+    ImageLoadAttribute imageLoadAttr = duiImage.GetImageLoadAttribute();
+    imageLoadAttr.SetImageFullPath(imageFullPath.ToString());
+    std::shared_ptr<ImageInfo> imageCache = duiImage.GetImageCache();
+    if ((imageCache == nullptr) || 
+        (imageCache->GetLoadKey() != imageLoadAttr.GetCacheKey(Dpi().GetScale()))) {
+        //如果图片没有加载则执行加载图片；如果图片发生变化，则重新加载该图片
+        ImageManager& imageManager = GlobalManager::Instance().Image();
+        if (imageManager.IsAsyncLoadImage()) {
+            //异步加载：加载完成前返回空，不绘制该图片；加载完成后重绘（或者重新布局）
+            Control* pThis = const_cast<Control*>(this);
+            StdClosure loadedCallback = [pThis]() {
+                    pThis->RelayoutOrRedraw();
+                };
+            imageCache = imageManager.GetImageAsync(GetWindow(), imageLoadAttr,
+                                                    pThis->ToWeakCallback(loadedCallback));
+        }
+        else {
+            imageCache = imageManager.GetImage(GetWindow(), imageLoadAttr);
+        }
+        duiImage.SetImageCache(imageCache);
     }
+    return imageCache ? true : false;
+}
+
+FilePath Control::GetImageFullPath(const DString& sImagePath) const
+{
     FilePath imageFullPath;
+    Window* pWindow = GetWindow();
+    if ((pWindow == nullptr) || sImagePath.empty()) {
+        return imageFullPath;
+    }
+
 
 #ifdef DUILIB_BUILD_FOR_WIN
     if (GlobalManager::Instance().Icon().IsIconString(sImagePath)) {
@@ -3065,21 +3328,32 @@ bool Control::LoadImageData(Image& duiImage) const
     if(imageFullPath.IsEmpty()) {
         imageFullPath = GlobalManager::Instance().GetExistsResFullPath(pWindow->GetResourcePath(), pWindow->GetXmlPath(), FilePath(sImagePath));
     }
-    if (imageFullPath.IsEmpty()) {
-        //资源文件不存在
-        return false;
-    }
+    //资源文件不存在时，返回空
+    return imageFullPath;
+}
 
-    ImageLoadAttribute imageLoadAttr = duiImage.GetImageLoadAttribute();
-    imageLoadAttr.SetImageFullPath(imageFullPath.ToString());
-    std::shared_ptr<ImageInfo> imageCache = duiImage.GetImageCache();
-    if ((imageCache == nullptr) || 
-        (imageCache->GetLoadKey() != imageLoadAttr.GetCacheKey(Dpi().GetScale()))) {
-        //如果图片没有加载则执行加载图片；如果图片发生变化，则重新加载该图片
-        imageCache = GlobalManager::Instance().Image().GetImage(GetWindow(), imageLoadAttr);
-        duiImage.SetImageCache(imageCache);
+void Control::PrefetchImages() const
+{
+    std::vector<Image*> allImages;
+    if (m_pImageMap != nullptr) {
+        m_pImageMap->GetAllImages(allImages);
+    }
+    if (m_pBkImage != nullptr) {
+        allImages.push_back(m_pBkImage.get());
+    }
+    ImageManager& imageManager = GlobalManager::Instance().Image();
+    for (const Image* pImage : allImages) {
+        if ((pImage == nullptr) || (pImage->GetImageCache() != nullptr)) {
+            continue;
+        }
+        FilePath imageFullPath = GetImageFullPath(pImage->GetImagePath());
+        if (!imageFullPath.IsEmpty()) {
+            //与LoadImageData使用相同的加载属性，保证加载Key相同
+            ImageLoadAttribute imageLoadAttr = pImage->GetImageLoadAttribute();
+            imageLoadAttr.SetImageFullPath(imageFullPath.ToString());
+            imageManager.PrefetchImage(GetWindow(), imageLoadAttr);
+        }
     }
-    return imageCache ? true : false;
 }
 
 void Control::ClearImageCache()
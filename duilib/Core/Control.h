@@ -20,6 +20,7 @@ namespace ui
     class IRender;
     class IPath;
     class IFont;
+    class FilePath;
 
     typedef Control* (CALLBACK* FINDCONTROLPROC)(Control*, void*);
 
@@ -766,6 +767,11 @@ public:
      */
     bool LoadImageData(Image& duiImage) const;
 
+    /**@brief 预加载控件的所有图片（背景图片和状态图片），在工作线程中解码，首次绘制时可直接从缓存中获取
+     *        参见：ImageManager::PrefetchImage
+     */
+    void PrefetchImages() const;
+
     /**@brief 清理图片缓存
      */
     virtual void ClearImageCache();
@@ -1186,6 +1192,11 @@ private:
     */
     bool ShouldBeRoundRectBorders() const;
 
+    /** 应用一个 class 的属性列表（先查找全局 class，再查找窗口的 class）
+    * @param [in] strClassName class 名称
+    */
+    void ApplyClass(const DString& strClassName);
+
 public:
     /** 判断是否需要采用圆角矩形填充背景色
     */
@@ -1234,6 +1245,11 @@ private:
     */
     int8_t GetColor2Direction(const UiString& bkColor2Direction) const;
 
+    /** 获取图片资源的完整路径（按窗口的资源路径和XML文件路径查找）
+    * @return 图片资源不存在时返回空
+    */
+    FilePath GetImageFullPath(const DString& sImagePath) const;
+
 private:
     /** 边框圆角大小(与m_rcBorderSize联合应用)或者阴影的圆角大小(与m_boxShadow联合应用)
         仅当 m_rcBorderSize 四个边框值都有效, 并且都相同时
@@ -4,6 +4,7 @@
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Core/Box.h"
+#include "duilib/Core/SkinBinary.h"
 
 //渲染引擎
 #include "duilib/RenderSkia/RenderFactory_Skia.h"
@@ -20,7 +21,10 @@ namespace ui
 {
 
 GlobalManager::GlobalManager():
-    m_platformData(nullptr)
+    m_platformData(nullptr),
+    m_bUseCompiledSkin(false),
+    m_nClassHash(0),
+    m_bClassHashValid(false)
 {
 }
 
@@ -97,11 +101,14 @@ void GlobalManager::Shutdown()
     m_renderFactory = nullptr;
     m_pfnCreateControlCallbackList.clear();
     m_globalClass.clear();
+    m_globalClassAttributes.clear();
+    m_bClassHashValid = false;
     m_windowList.clear();
     m_dwUiThreadId = std::thread::id();
     m_resourcePath.Clear();
     m_languagePath.Clear();
     m_fontFilePath.Clear();
+    m_bUseCompiledSkin = false;
     m_builderMap.clear();
     m_platformData = nullptr;
 
@@ -141,6 +148,11 @@ const FilePath& GlobalManager::GetFontFilePath() const
     return m_fontFilePath;
 }
 
+bool GlobalManager::IsUseCompiledSkin() const
+{
+    return m_bUseCompiledSkin;
+}
+
 void GlobalManager::SetLanguagePath(const FilePath& strPath)
 {
     m_languagePath = strPath;
@@ -208,6 +220,9 @@ bool GlobalManager::ReloadResource(const ResourceParam& resParam, bool bInvalida
     //保存字体文件所在路径
     SetFontFilePath(FilePathUtil::JoinFilePath(strResourcePath, resParam.fontFilePath));
 
+    //是否优先加载编译后的皮肤文件
+    m_bUseCompiledSkin = resParam.useCompiledSkin;
+
     //解析全局资源信息(默认是"global.xml"文件)
     ASSERT(!resParam.globalXmlFileName.empty());
     if (!resParam.globalXmlFileName.empty()) {
@@ -481,6 +496,10 @@ void GlobalManager::AddClass(const DString& strClassName, const DString& strCont
     ASSERT(!strClassName.empty() && !strControlAttrList.empty());
     if (!strClassName.empty() && !strControlAttrList.empty()) {
         m_globalClass[strClassName] = strControlAttrList;
+        std::shared_ptr<AttributeList> pAttributeList = std::make_shared<AttributeList>();
+        AttributeUtil::ParseAttributeList(strControlAttrList, *pAttributeList);
+        m_globalClassAttributes[strClassName] = pAttributeList;
+        m_bClassHashValid = false;
     }    
 }
 
@@ -494,10 +513,32 @@ DString GlobalManager::GetClassAttributes(const DString& strClassName) const
     return DString();
 }
 
+std::shared_ptr<const AttributeList> GlobalManager::GetClassAttributeList(const DString& strClassName) const
+{
+    AssertUIThread();
+    auto it = m_globalClassAttributes.find(strClassName);
+    if (it != m_globalClassAttributes.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+uint64_t GlobalManager::GetClassHash() const
+{
+    AssertUIThread();
+    if (!m_bClassHashValid) {
+        m_nClassHash = SkinBinary::GetClassHash(m_globalClass);
+        m_bClassHashValid = true;
+    }
+    return m_nClassHash;
+}
+
 void GlobalManager::RemoveAllClasss()
 {
     AssertUIThread();
     m_globalClass.clear();
+    m_globalClassAttributes.clear();
+    m_bClassHashValid = false;
 }
 
 ColorManager& GlobalManager::Color()
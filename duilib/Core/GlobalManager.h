@@ -12,6 +12,7 @@
 #include "duilib/Core/ThreadManager.h"
 #include "duilib/Core/ResourceParam.h"
 #include "duilib/Core/CursorManager.h"
+#include "duilib/Utils/AttributeUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_WIN
     #include "duilib/Core/IconManager_Windows.h"
@@ -20,6 +21,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <thread>
 
 namespace ui 
@@ -100,6 +102,10 @@ public:
     */
     const FilePath& GetFontFilePath() const;
 
+    /** 是否优先加载编译后的皮肤文件（见ResourceParam::useCompiledSkin）
+    */
+    bool IsUseCompiledSkin() const;
+
 public:
     /** 设置语言文件所在路径，可以是相对路径或者是绝对路径（多语言版时，所有的语言文件都放在这个目录中）
     *   如果是绝对路径，则在这个绝对路径中查找语言文件
@@ -162,6 +168,16 @@ public:
      */
     DString GetClassAttributes(const DString& strClassName) const;
 
+    /** 获取一个全局 class 解析后的属性列表（添加 class 时已经解析，应用 class 时不需要重复解析）
+     * @param[in] strClassName 全局 class 名称
+     * @return 返回解析后的属性列表（不可修改），如果不存在该 class，返回nullptr
+     */
+    std::shared_ptr<const AttributeList> GetClassAttributeList(const DString& strClassName) const;
+
+    /** 获取所有全局 class 属性的哈希值（用于校验编译后的皮肤文件，见SkinBinary）
+     */
+    uint64_t GetClassHash() const;
+
     /** 从全局属性中删除所有 class 属性
      * @return 返回绘制区域对象
      */
@@ -298,6 +314,10 @@ private:
     */
     FilePath m_fontFilePath;
 
+    /** 是否优先加载编译后的皮肤文件
+    */
+    bool m_bUseCompiledSkin;
+
     /** 全局语言文件路径（绝对路径）
     */
     FilePath m_languagePath;
@@ -318,6 +338,15 @@ private:
     */
     std::map<DString, DString> m_globalClass;
 
+    /** 每个Class的名称(KEY)和解析后的属性列表(VALUE)
+    */
+    std::unordered_map<DString, std::shared_ptr<const AttributeList>> m_globalClassAttributes;
+
+    /** 全局Class的哈希值（修改Class后重新计算）
+    */
+    mutable uint64_t m_nClassHash;
+    mutable bool m_bClassHashValid;
+
     /** 主线程ID
     */
     std::thread::id m_dwUiThreadId;
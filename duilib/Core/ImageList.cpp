@@ -49,6 +49,10 @@ void ImageList::ChangeDpiScale(const DpiManager& dpi, uint32_t nOldDpiScale)
         szImageSize = dpi.GetScaleSize(szImageSize, nOldDpiScale);
         SetImageSize(szImageSize, dpi, false);
     }
+    if (m_pImageAtlas != nullptr) {
+        //图片将按新的DPI重新加载，旧的图集不再使用
+        m_pImageAtlas->Clear();
+    }
 }
 
 int32_t ImageList::AddImageString(const DString& imageString, const DpiManager& dpi)
@@ -127,6 +131,46 @@ void ImageList::GetImageIdList(std::vector<int32_t>& imageIdList) const
 void ImageList::Clear()
 {
     m_imageMap.clear();
+    if (m_pImageAtlas != nullptr) {
+        m_pImageAtlas->Clear();
+    }
+}
+
+void ImageList::SetAtlasMode(bool bAtlasMode)
+{
+    if (bAtlasMode) {
+        if (m_pImageAtlas == nullptr) {
+            m_pImageAtlas = std::make_unique<ImageAtlas>();
+        }
+    }
+    else if (m_pImageAtlas != nullptr) {
+        m_pImageAtlas.reset();
+        for (auto iter = m_imageMap.begin(); iter != m_imageMap.end(); ++iter) {
+            iter->second->SetAtlasBitmap(nullptr, UiRect());
+        }
+    }
+}
+
+bool ImageList::IsAtlasMode() const
+{
+    return m_pImageAtlas != nullptr;
+}
+
+void ImageList::CheckImageAtlas(Image& image)
+{
+    if (m_pImageAtlas == nullptr) {
+        return;
+    }
+    UiRect rcAtlas;
+    if (image.GetAtlasBitmap(rcAtlas) != nullptr) {
+        //已经在图集中
+        return;
+    }
+    const std::shared_ptr<ImageInfo>& imageInfo = image.GetImageCache();
+    std::shared_ptr<IBitmap> pAtlasBitmap;
+    if ((imageInfo != nullptr) && m_pImageAtlas->AddImage(imageInfo, pAtlasBitmap, rcAtlas)) {
+        image.SetAtlasBitmap(pAtlasBitmap, rcAtlas);
+    }
 }
 
 } //namespace ui 
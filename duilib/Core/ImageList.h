@@ -2,6 +2,7 @@
 #define UI_CORE_IMAGE_LIST_H_
 
 #include "duilib/Image/Image.h"
+#include "duilib/Image/ImageAtlas.h"
 #include "duilib/Core/UiTypes.h"
 #include <map>
 #include <string>
@@ -93,6 +94,21 @@ public:
     /** 清空所有图片资源
     */
     void Clear();
+
+    /** 设置是否开启图集模式，默认关闭
+    *   开启后，加载完成的小图片（单帧图片，宽高不超过ImageAtlas::kMaxAtlasImageSize）被合并到少量的图集位图中，
+    *   绘制时从图集位图中对应的区域绘制（适用于列表中大量的图标）
+    */
+    void SetAtlasMode(bool bAtlasMode);
+
+    /** 是否开启了图集模式
+    */
+    bool IsAtlasMode() const;
+
+    /** 开启图集模式时，将已经加载完成的图片加入图集（在图片加载完成后、绘制前调用）
+    * @param [in] image 图片资源，由GetImageData函数返回
+    */
+    void CheckImageAtlas(Image& image);
  
 private:
     /** 下一个ID
@@ -110,6 +126,10 @@ private:
     /** 图片资源映射表
     */
     std::map<int32_t, ImagePtr> m_imageMap;
+
+    /** 图集（开启图集模式时有效）
+    */
+    std::unique_ptr<ImageAtlas> m_pImageAtlas;
 };
 
 } //namespace ui 
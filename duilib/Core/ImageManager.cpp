@@ -1,18 +1,34 @@
 #include "ImageManager.h"
 #include "duilib/Image/Image.h"
 #include "duilib/Image/ImageDecoder.h"
+#include "duilib/Image/ImageDiskCache.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/ThreadPool.h"
+#include "duilib/Utils/PerformanceUtil.h"
 
 namespace ui 
 {
 
+/** 异步加载完成的图片，等待请求方取走的最长时间（毫秒），超时后释放对图片的引用
+*/
+static constexpr uint32_t kAsyncLoadedImageHoldMs = 2000;
+
+/** 图片缓存默认的上限：保留图片数据的总大小（字节）和图片个数
+*/
+static constexpr uint64_t kDefaultImageCacheMaxBytes = 32 * 1024 * 1024;
+static constexpr size_t kDefaultImageCacheMaxCount = 256;
+
 ImageManager::ImageManager():
     m_bDpiScaleAllImages(true),
-    m_bAutoMatchScaleImage(true)
+    m_bAutoMatchScaleImage(true),
+    m_nCacheMaxBytes(kDefaultImageCacheMaxBytes),
+    m_nCacheMaxCount(kDefaultImageCacheMaxCount),
+    m_bAsyncLoadImage(false),
+    m_nAsyncTaskCount(0)
 {
 }
 
@@ -24,27 +40,45 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const Window* pWindow,
                                                   const ImageLoadAttribute& loadAtrribute)
 {
     const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
+    return GetImageImpl(pWindow, dpi, loadAtrribute);
+}
+
+std::shared_ptr<ImageInfo> ImageManager::GetImage(uint32_t uDpi,
+                                                  const ImageLoadAttribute& loadAtrribute)
+{
+    //DpiManager只用于计算图片大小，使用局部对象，避免跨线程访问窗口的DpiManager
+    DpiManager dpi;
+    dpi.SetDPI(uDpi);
+    return GetImageImpl(nullptr, dpi, loadAtrribute);
+}
+
+std::shared_ptr<ImageInfo> ImageManager::GetImageImpl(const Window* pWindow,
+                                                      const DpiManager& dpi,
+                                                      const ImageLoadAttribute& loadAtrribute)
+{
     //查找对应关系：LoadKey ->(多对一) ImageKey ->(一对一) SharedImage
     DString loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
-    auto iter = m_loadKeyMap.find(loadKey);
-    if (iter != m_loadKeyMap.end()) {
-        const DString& imageKey = iter->second;
-        auto it = m_imageMap.find(imageKey);
-        if (it != m_imageMap.end()) {
-            std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
-            if (sharedImage) {
-                //从缓存中，找到有效图片资源，直接返回
-                return sharedImage;
-            }
+    std::shared_ptr<ImageInfo> sharedImage = FindImageByLoadKey(loadKey);
+    if (sharedImage != nullptr) {
+        //从缓存中，找到有效图片资源，直接返回（如果是预加载完成的图片，已经被请求方取走，不再需要保持引用）
+        if (GlobalManager::Instance().Thread().GetCurrentThreadIdentifier() == kThreadUI) {
+            m_asyncLoadedMap.erase(loadKey);
         }
-    }    
+        AddCacheStat(true);
+        TouchImageCache(sharedImage);
+        return sharedImage;
+    }
 
     //重新加载资源    
     std::unique_ptr<ImageInfo> imageInfo;
     bool isIcon = false;
 #ifdef DUILIB_BUILD_FOR_WIN
     if (GlobalManager::Instance().Icon().IsIconString(loadAtrribute.GetImageFullPath())) {
-        //加载ICON
+        //加载ICON（HICON句柄只能在UI线程中加载）
+        if (GlobalManager::Instance().Thread().GetCurrentThreadIdentifier() != kThreadUI) {
+            ASSERT(!"ImageManager::GetImage: HICON must be loaded in UI thread!");
+            return nullptr;
+        }
         isIcon = true;
         LoadIconData(pWindow, loadAtrribute, imageInfo);
     }
@@ -52,86 +86,351 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const Window* pWindow,
 
     bool isDpiScaledImageFile = false;
     if (!isIcon) {
-        DString imageFullPath = loadAtrribute.GetImageFullPath();
-        bool isUseZip = GlobalManager::Instance().Zip().IsUseZip();
-        DString dpiImageFullPath;
-        uint32_t nImageDpiScale = 0;
-        //仅在DPI缩放图片功能开启的情况下，查找对应DPI的图片是否存在
-        const bool bEnableImageDpiScale = IsDpiScaleAllImages();
-        if (bEnableImageDpiScale && GetDpiScaleImageFullPath(dpi.GetScale(), isUseZip, imageFullPath,
-                                     dpiImageFullPath, nImageDpiScale)) {
-            //标记DPI自适应图片属性，如果路径不同，说明已经选择了对应DPI下的文件
-            isDpiScaledImageFile = true;
-            imageFullPath = dpiImageFullPath;
-            ASSERT(!imageFullPath.empty());
-            ASSERT(nImageDpiScale > 100);
-        }
-        else {
-            nImageDpiScale = 100; //原始图片，未经DPI缩放
-            isDpiScaledImageFile = false;
+        TImageLoadParam loadParam;
+        GetImageLoadParam(dpi, loadAtrribute, loadParam);
+        isDpiScaledImageFile = loadParam.bDpiScaledImageFile;
+
+        //根据imageKey查询缓存
+        sharedImage = FindImageByImageKey(loadParam.imageKey, dpi.GetScale());
+        if (sharedImage != nullptr) {
+            //与请求的DPI缩放百分比相同
+            AddCacheStat(true);
+            TouchImageCache(sharedImage);
+            return sharedImage;
         }
-        //加载图片的KEY
-        ImageLoadAttribute realLoadAttribute = loadAtrribute;
-        realLoadAttribute.SetImageFullPath(imageFullPath);
-        DString imageKey;
-        if (isDpiScaledImageFile) {
-            //有对应DPI的图片文件
-            imageKey = realLoadAttribute.GetCacheKey(nImageDpiScale);
+
+        //从内存数据加载文件
+        std::vector<uint8_t> fileData;
+        ReadImageFileData(loadParam, fileData);
+        imageInfo = DecodeImageData(fileData, loadAtrribute, loadParam, dpi);
+    }
+    AddCacheStat(false);
+    sharedImage = AddImageCache(imageInfo, loadKey, dpi.GetScale(), isDpiScaledImageFile);
+    if (sharedImage != nullptr) {
+        TouchImageCache(sharedImage);
+    }
+    return sharedImage;
+}
+
+std::shared_ptr<ImageInfo> ImageManager::GetImageAsync(const Window* pWindow,
+                                                       const ImageLoadAttribute& loadAtrribute,
+                                                       const WeakCallback<StdClosure>& loadedCallback)
+{
+    if (!IsAsyncLoadImage() ||
+        (GlobalManager::Instance().Thread().GetCurrentThreadIdentifier() != kThreadUI)) {
+        return GetImage(pWindow, loadAtrribute);
+    }
+#ifdef DUILIB_BUILD_FOR_WIN
+    if (GlobalManager::Instance().Icon().IsIconString(loadAtrribute.GetImageFullPath())) {
+        //ICON句柄：只能在UI线程中加载
+        return GetImage(pWindow, loadAtrribute);
+    }
+#endif
+    const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
+    DString loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+    std::shared_ptr<ImageInfo> sharedImage = FindImageByLoadKey(loadKey);
+    if (sharedImage != nullptr) {
+        //如果是异步加载完成的图片，已经被请求方取走，不再需要保持引用
+        m_asyncLoadedMap.erase(loadKey);
+        AddCacheStat(true);
+        TouchImageCache(sharedImage);
+        return sharedImage;
+    }
+
+    auto iter = m_asyncLoadingMap.find(loadKey);
+    if (iter != m_asyncLoadingMap.end()) {
+        //该图片正在加载中，加载完成后一并回调：同一个请求方（比如控件）加载完成前会多次请求（每次重绘都会请求），只保留一个回调
+        std::vector<WeakCallback<StdClosure>>& callbacks = iter->second;
+        const std::weak_ptr<WeakFlag>& weakFlag = loadedCallback.GetFlag();
+        bool bQueued = false;
+        for (auto it = callbacks.begin(); it != callbacks.end();) {
+            if (it->Expired()) {
+                //请求方已经销毁，删除其回调
+                it = callbacks.erase(it);
+                continue;
+            }
+            if (!it->GetFlag().owner_before(weakFlag) && !weakFlag.owner_before(it->GetFlag())) {
+                bQueued = true;
+            }
+            ++it;
         }
-        else {
-            //无对应DPI缩放比的图片文件
-            imageKey = realLoadAttribute.GetCacheKey(0);
+        if (!bQueued && !loadedCallback.Expired()) {
+            callbacks.push_back(loadedCallback);
         }
+        AddCacheStat(false);
+        return nullptr;
+    }
 
-        //根据imageKey查询缓存
-        if (!imageKey.empty()) {
-            auto it = m_imageMap.find(imageKey);
-            if (it != m_imageMap.end()) {
-                std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
-                if ((sharedImage != nullptr) && (sharedImage->GetLoadDpiScale() == dpi.GetScale())) {
-                    //与请求的DPI缩放百分比相同
-                    return sharedImage;
+    TImageLoadParam loadParam;
+    GetImageLoadParam(dpi, loadAtrribute, loadParam);
+    sharedImage = FindImageByImageKey(loadParam.imageKey, dpi.GetScale());
+    if (sharedImage != nullptr) {
+        AddCacheStat(true);
+        TouchImageCache(sharedImage);
+        return sharedImage;
+    }
+    AddCacheStat(false);
+
+    StartAsyncLoad(loadAtrribute, loadParam, dpi);
+    m_asyncLoadingMap[loadKey].push_back(loadedCallback);
+    return nullptr;
+}
+
+bool ImageManager::PrefetchImage(const Window* pWindow, const ImageLoadAttribute& loadAtrribute)
+{
+    if (GlobalManager::Instance().Thread().GetCurrentThreadIdentifier() != kThreadUI) {
+        return false;
+    }
+#ifdef DUILIB_BUILD_FOR_WIN
+    if (GlobalManager::Instance().Icon().IsIconString(loadAtrribute.GetImageFullPath())) {
+        //ICON句柄：只能在UI线程中加载，不需要预加载
+        return false;
+    }
+#endif
+    const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
+    DString loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+    if ((FindImageByLoadKey(loadKey) != nullptr) ||
+        (m_asyncLoadingMap.find(loadKey) != m_asyncLoadingMap.end())) {
+        //已经在缓存中，或者正在加载中
+        return false;
+    }
+    TImageLoadParam loadParam;
+    GetImageLoadParam(dpi, loadAtrribute, loadParam);
+    if (FindImageByImageKey(loadParam.imageKey, dpi.GetScale()) != nullptr) {
+        return false;
+    }
+    StartAsyncLoad(loadAtrribute, loadParam, dpi);
+    //预加载没有回调函数（加载完成后，如果有控件请求该图片，会添加回调函数）
+    m_asyncLoadingMap[loadKey];
+    PerformanceUtil::Instance().AddCounter(_T("ImageManager::PrefetchImage"));
+    return true;
+}
+
+void ImageManager::StartAsyncLoad(const ImageLoadAttribute& loadAtrribute,
+                                  const TImageLoadParam& loadParam,
+                                  const DpiManager& dpi)
+{
+    const uint32_t uDpi = dpi.GetDPI();
+    const uint32_t loadDpiScale = dpi.GetScale();
+    std::weak_ptr<WeakFlag> weakFlag = m_asyncLoadFlag.GetWeakFlag();
+    ImageLoadAttribute imageLoadAttr(loadAtrribute);
+    //记录正在执行的加载任务个数，RemoveAllImages需要等待这些任务结束（任务中会访问资源压缩包和渲染接口）
+    {
+        std::lock_guard<std::mutex> taskLock(m_asyncTaskMutex);
+        ++m_nAsyncTaskCount;
+    }
+    ThreadPool::Instance().PostTask([this, weakFlag, loadParam, imageLoadAttr, uDpi, loadDpiScale]() {
+            //任务结束时（包括提前返回），减少任务个数并通知等待方
+            struct TAsyncTaskGuard
+            {
+                ImageManager* m_pImageManager;
+                ~TAsyncTaskGuard()
+                {
+                    std::lock_guard<std::mutex> taskLock(m_pImageManager->m_asyncTaskMutex);
+                    ASSERT(m_pImageManager->m_nAsyncTaskCount > 0);
+                    --m_pImageManager->m_nAsyncTaskCount;
+                    m_pImageManager->m_asyncTaskCond.notify_all();
                 }
+            };
+            TAsyncTaskGuard taskGuard = { this };
+            if (weakFlag.expired()) {
+                return;
             }
-        }
+            //文件的读取和解码都在工作线程中执行
+            std::vector<uint8_t> fileData;
+            ReadImageFileData(loadParam, fileData);
+            //DpiManager只用于计算图片大小，使用局部对象，避免跨线程访问窗口的DpiManager
+            DpiManager dpi;
+            dpi.SetDPI(uDpi);
+            std::shared_ptr<std::unique_ptr<ImageInfo>> spImageInfo = std::make_shared<std::unique_ptr<ImageInfo>>();
+            *spImageInfo = DecodeImageData(fileData, imageLoadAttr, loadParam, dpi);
+            if (weakFlag.expired()) {
+                //解码过程中已经取消（比如程序退出），丢弃解码结果
+                return;
+            }
+            GlobalManager::Instance().Thread().PostTask(kThreadUI, WeakCallback<StdClosure>(weakFlag, [this, loadParam, loadDpiScale, spImageInfo]() {
+                    OnAsyncImageLoaded(loadParam, loadDpiScale, *spImageInfo);
+                }));
+        });
+}
 
-        //从内存数据加载文件
-        std::vector<uint8_t> fileData;
-        if (isUseZip) {
-            GlobalManager::Instance().Zip().GetZipData(FilePath(imageFullPath), fileData);
+void ImageManager::OnAsyncImageLoaded(const TImageLoadParam& loadParam,
+                                      uint32_t loadDpiScale,
+                                      std::unique_ptr<ImageInfo>& imageInfo)
+{
+    std::vector<WeakCallback<StdClosure>> loadedCallbacks;
+    auto iter = m_asyncLoadingMap.find(loadParam.loadKey);
+    if (iter != m_asyncLoadingMap.end()) {
+        loadedCallbacks.swap(iter->second);
+        m_asyncLoadingMap.erase(iter);
+    }
+    if (imageInfo == nullptr) {
+        //加载失败
+        return;
+    }
+
+    std::shared_ptr<ImageInfo> sharedImage = FindImageByImageKey(loadParam.imageKey, loadDpiScale);
+    if (sharedImage == nullptr) {
+        sharedImage = AddImageCache(imageInfo, loadParam.loadKey, loadDpiScale, loadParam.bDpiScaledImageFile);
+    }
+    if (sharedImage == nullptr) {
+        return;
+    }
+    TouchImageCache(sharedImage);
+
+    bool bHasCallback = false;
+    for (const WeakCallback<StdClosure>& loadedCallback : loadedCallbacks) {
+        if (!loadedCallback.Expired()) {
+            bHasCallback = true;
+            break;
         }
-        else {
-            FileUtil::ReadFileData(FilePath(imageFullPath), fileData);
+    }
+    if (!loadedCallbacks.empty() && !bHasCallback) {
+        //请求方都已经销毁（没有回调函数的是预加载，需要保持引用，等待控件首次绘制时取走）
+        return;
+    }
+
+    //在请求方重绘取走图片之前，保持图片的引用；如果请求方一直没有重绘（比如控件不可见），超时后释放
+    const DString loadKey = loadParam.loadKey;
+    m_asyncLoadedMap[loadKey] = sharedImage;
+    std::weak_ptr<ImageInfo> weakImage = sharedImage;
+    GlobalManager::Instance().Timer().AddTimer(m_asyncLoadFlag.GetWeakFlag(), [this, loadKey, weakImage]() {
+            auto it = m_asyncLoadedMap.find(loadKey);
+            if ((it != m_asyncLoadedMap.end()) && (it->second == weakImage.lock())) {
+                m_asyncLoadedMap.erase(it);
+            }
+        }, kAsyncLoadedImageHoldMs, 1);
+
+    for (const WeakCallback<StdClosure>& loadedCallback : loadedCallbacks) {
+        loadedCallback();
+    }
+}
+
+std::shared_ptr<ImageInfo> ImageManager::FindImageByLoadKey(const DString& loadKey) const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    auto iter = m_loadKeyMap.find(loadKey);
+    if (iter != m_loadKeyMap.end()) {
+        const DString& imageKey = iter->second;
+        auto it = m_imageMap.find(imageKey);
+        if (it != m_imageMap.end()) {
+            return it->second.lock();
         }
-        ASSERT(!fileData.empty());
-
-        imageInfo.reset();
-        if (!fileData.empty()) {
-            ImageDecoder imageDecoder;
-            ImageLoadAttribute imageLoadAtrribute(loadAtrribute);
-            if (isDpiScaledImageFile) {
-                imageLoadAtrribute.SetNeedDpiScale(false);
-            }            
-            imageInfo = imageDecoder.LoadImageData(fileData, 
-                                                   imageLoadAtrribute, 
-                                                   bEnableImageDpiScale, nImageDpiScale, dpi);
-            if (imageInfo != nullptr) {
-                imageInfo->SetImageKey(imageKey);
+    }
+    return nullptr;
+}
+
+std::shared_ptr<ImageInfo> ImageManager::FindImageByImageKey(const DString& imageKey, uint32_t dpiScale) const
+{
+    if (!imageKey.empty()) {
+        std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+        auto it = m_imageMap.find(imageKey);
+        if (it != m_imageMap.end()) {
+            std::shared_ptr<ImageInfo> sharedImage = it->second.lock();
+            if ((sharedImage != nullptr) && (sharedImage->GetLoadDpiScale() == dpiScale)) {
+                return sharedImage;
             }
         }
-    }    
+    }
+    return nullptr;
+}
+
+void ImageManager::GetImageLoadParam(const DpiManager& dpi,
+                                     const ImageLoadAttribute& loadAtrribute,
+                                     TImageLoadParam& loadParam) const
+{
+    loadParam.loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+    DString imageFullPath = loadAtrribute.GetImageFullPath();
+    bool isUseZip = GlobalManager::Instance().Zip().IsUseZip();
+    DString dpiImageFullPath;
+    uint32_t nImageDpiScale = 0;
+    bool isDpiScaledImageFile = false;
+    //仅在DPI缩放图片功能开启的情况下，查找对应DPI的图片是否存在
+    const bool bEnableImageDpiScale = IsDpiScaleAllImages();
+    if (bEnableImageDpiScale && GetDpiScaleImageFullPath(dpi.GetScale(), isUseZip, imageFullPath,
+                                 dpiImageFullPath, nImageDpiScale)) {
+        //标记DPI自适应图片属性，如果路径不同，说明已经选择了对应DPI下的文件
+        isDpiScaledImageFile = true;
+        imageFullPath = dpiImageFullPath;
+        ASSERT(!imageFullPath.empty());
+        ASSERT(nImageDpiScale > 100);
+    }
+    else {
+        nImageDpiScale = 100; //原始图片，未经DPI缩放
+        isDpiScaledImageFile = false;
+    }
+    //加载图片的KEY
+    ImageLoadAttribute realLoadAttribute = loadAtrribute;
+    realLoadAttribute.SetImageFullPath(imageFullPath);
+    if (isDpiScaledImageFile) {
+        //有对应DPI的图片文件
+        loadParam.imageKey = realLoadAttribute.GetCacheKey(nImageDpiScale);
+    }
+    else {
+        //无对应DPI缩放比的图片文件
+        loadParam.imageKey = realLoadAttribute.GetCacheKey(0);
+    }
+    loadParam.imageFullPath = imageFullPath;
+    loadParam.bUseZip = isUseZip;
+    loadParam.bEnableImageDpiScale = bEnableImageDpiScale;
+    loadParam.bDpiScaledImageFile = isDpiScaledImageFile;
+    loadParam.nImageDpiScale = nImageDpiScale;
+    loadParam.diskCachePath = GetImageDiskCachePath();
+}
+
+std::unique_ptr<ImageInfo> ImageManager::DecodeImageData(std::vector<uint8_t>& fileData,
+                                                         const ImageLoadAttribute& loadAtrribute,
+                                                         const TImageLoadParam& loadParam,
+                                                         const DpiManager& dpi)
+{
+    std::unique_ptr<ImageInfo> imageInfo;
+    if (!fileData.empty()) {
+        ImageDecoder imageDecoder;
+        imageDecoder.SetDiskCachePath(loadParam.diskCachePath);
+        ImageLoadAttribute imageLoadAtrribute(loadAtrribute);
+        if (loadParam.bDpiScaledImageFile) {
+            imageLoadAtrribute.SetNeedDpiScale(false);
+        }            
+        imageInfo = imageDecoder.LoadImageData(fileData, 
+                                               imageLoadAtrribute, 
+                                               loadParam.bEnableImageDpiScale, loadParam.nImageDpiScale, dpi);
+        if (imageInfo != nullptr) {
+            imageInfo->SetImageKey(loadParam.imageKey);
+        }
+    }
+    return imageInfo;
+}
+
+std::shared_ptr<ImageInfo> ImageManager::AddImageCache(std::unique_ptr<ImageInfo>& imageInfo,
+                                                       const DString& loadKey,
+                                                       uint32_t loadDpiScale,
+                                                       bool bDpiScaledImageFile)
+{
     std::shared_ptr<ImageInfo> sharedImage;
     if (imageInfo != nullptr) {
         DString imageKey = imageInfo->GetImageKey();
+        if (imageKey.empty()) {
+            imageKey = loadKey;
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+        auto it = m_imageMap.find(imageKey);
+        if (it != m_imageMap.end()) {
+            //多个线程同时加载同一个图片：使用先加入缓存的图片，丢弃本次加载的结果
+            sharedImage = it->second.lock();
+            if ((sharedImage != nullptr) && (sharedImage->GetLoadDpiScale() == loadDpiScale)) {
+                m_loadKeyMap[loadKey] = imageKey;
+                imageInfo.reset();
+                return sharedImage;
+            }
+        }
+
         sharedImage.reset(imageInfo.release(), &OnImageInfoDestroy);
         sharedImage->SetLoadKey(loadKey);
-        sharedImage->SetLoadDpiScale(dpi.GetScale());
-        if (isDpiScaledImageFile) {
+        sharedImage->SetLoadDpiScale(loadDpiScale);
+        if (bDpiScaledImageFile) {
             //使用了DPI自适应的图片，做标记（必须位true时才能修改这个值）
-            sharedImage->SetBitmapSizeDpiScaled(isDpiScaledImageFile);
-        }
-        if (imageKey.empty()) {
-            imageKey = loadKey;
+            sharedImage->SetBitmapSizeDpiScaled(bDpiScaledImageFile);
         }
 
         //保存对应关系：LoadKey ->(多对一) ImageKey ->(一对一) SharedImage
@@ -146,6 +445,91 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const Window* pWindow,
     return sharedImage;
 }
 
+std::shared_ptr<ImageInfo> ImageManager::AddImageData(const Window* pWindow,
+                                                      const ImageLoadAttribute& loadAtrribute,
+                                                      const void* pPixelBits,
+                                                      uint32_t nWidth,
+                                                      uint32_t nHeight)
+{
+    const DpiManager& dpi = (pWindow != nullptr) ? pWindow->Dpi() : GlobalManager::Instance().Dpi();
+    return AddImageData(dpi.GetDPI(), loadAtrribute, pPixelBits, nWidth, nHeight);
+}
+
+std::shared_ptr<ImageInfo> ImageManager::AddImageData(uint32_t uDpi,
+                                                      const ImageLoadAttribute& loadAtrribute,
+                                                      const void* pPixelBits,
+                                                      uint32_t nWidth,
+                                                      uint32_t nHeight)
+{
+    ASSERT((pPixelBits != nullptr) && (nWidth > 0) && (nHeight > 0));
+    if ((pPixelBits == nullptr) || (nWidth == 0) || (nHeight == 0)) {
+        return nullptr;
+    }
+    IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactroy != nullptr);
+    if (pRenderFactroy == nullptr) {
+        return nullptr;
+    }
+    IBitmap* pBitmap = pRenderFactroy->CreateBitmap();
+    ASSERT(pBitmap != nullptr);
+    if (pBitmap == nullptr) {
+        return nullptr;
+    }
+    if (!pBitmap->Init(nWidth, nHeight, true, pPixelBits)) {
+        delete pBitmap;
+        return nullptr;
+    }
+    std::vector<IBitmap*> frameBitmaps;
+    frameBitmaps.push_back(pBitmap);
+    std::unique_ptr<ImageInfo> imageInfo(new ImageInfo);
+    imageInfo->SetFrameBitmap(frameBitmaps);
+    imageInfo->SetImageSize(nWidth, nHeight);
+    imageInfo->SetPlayCount(-1);
+
+    //按照加载Key加入缓存，图片Key与加载Key相同（外部图片数据没有对应DPI的图片文件）
+    DpiManager dpi;
+    dpi.SetDPI(uDpi);
+    const DString loadKey = loadAtrribute.GetCacheKey(dpi.GetScale());
+    //被替换的图片：在新图片加入缓存后再释放（图片的释放回调中会修改映射表）
+    std::shared_ptr<ImageInfo> replacedImage;
+    std::shared_ptr<ImageInfo> replacedCachedImage;
+    {
+        //替换缓存中已有的图片：从映射表和缓存中一并移除，避免旧图片一直保留在缓存中
+        std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+        auto iter = m_loadKeyMap.find(loadKey);
+        if (iter != m_loadKeyMap.end()) {
+            auto it = m_imageMap.find(iter->second);
+            if (it != m_imageMap.end()) {
+                replacedImage = it->second.lock();
+                m_imageMap.erase(it);
+            }
+            m_loadKeyMap.erase(iter);
+        }
+        m_imageMap.erase(loadKey);
+        if (replacedImage != nullptr) {
+            replacedCachedImage = RemoveImageCache(replacedImage.get());
+        }
+    }
+    imageInfo->SetImageKey(loadKey);
+    std::shared_ptr<ImageInfo> sharedImage = AddImageCache(imageInfo, loadKey, dpi.GetScale(), false);
+    if (sharedImage != nullptr) {
+        //保留在缓存中，直到请求方取走
+        TouchImageCache(sharedImage);
+    }
+    return sharedImage;
+}
+
+void ImageManager::ReadImageFileData(const TImageLoadParam& loadParam, std::vector<uint8_t>& fileData)
+{
+    if (loadParam.bUseZip) {
+        GlobalManager::Instance().Zip().GetZipData(FilePath(loadParam.imageFullPath), fileData);
+    }
+    else {
+        FileUtil::ReadFileData(FilePath(loadParam.imageFullPath), fileData);
+    }
+    ASSERT(!fileData.empty());
+}
+
 #ifdef DUILIB_BUILD_FOR_WIN
 void ImageManager::LoadIconData(const Window* pWindow, 
                                 const ImageLoadAttribute& loadAtrribute,
@@ -191,18 +575,21 @@ void ImageManager::OnImageInfoDestroy(ImageInfo* pImageInfo)
     ASSERT(pImageInfo != nullptr);
     ImageManager& imageManager = GlobalManager::Instance().Image();
     if (pImageInfo != nullptr) {
+        //图片可能在任意线程中释放（最后一个引用所在的线程）
         DString imageKey;
         DString loadKey = pImageInfo->GetLoadKey();
-        if (!loadKey.empty()) {            
+        if (!loadKey.empty()) {
+            std::lock_guard<std::recursive_mutex> lock(imageManager.m_imageMutex);
             auto iter = imageManager.m_loadKeyMap.find(loadKey);
             if (iter != imageManager.m_loadKeyMap.end()) {
                 imageKey = iter->second;
-                imageManager.m_loadKeyMap.erase(iter);
-            }
-            if (imageKey.empty()) {
                 auto it = imageManager.m_imageMap.find(imageKey);
-                if (it != imageManager.m_imageMap.end()) {
-                    imageManager.m_imageMap.erase(it);
+                //如果该Key已经被重新加载的图片替换，则保留对应关系
+                if ((it == imageManager.m_imageMap.end()) || it->second.expired()) {
+                    imageManager.m_loadKeyMap.erase(iter);
+                    if (it != imageManager.m_imageMap.end()) {
+                        imageManager.m_imageMap.erase(it);
+                    }
                 }
             }
         }
@@ -216,9 +603,166 @@ void ImageManager::OnImageInfoDestroy(ImageInfo* pImageInfo)
 
 void ImageManager::RemoveAllImages()
 {
+    //丢弃正在异步加载的图片
+    m_asyncLoadFlag.Cancel();
+    WaitAsyncLoadTasks();
+    m_asyncLoadingMap.clear();
+    m_asyncLoadedMap.clear();
+    //缓存中保留的图片全部移除（包括仍被引用的图片），先从缓存中移除，再释放图片
+    std::list<TCachedImage> cachedImages;
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    cachedImages.swap(m_cachedImages);
+    m_cachedImageMap.clear();
+    m_cacheStat.m_nCachedBytes = 0;
+    m_cacheStat.m_nCachedCount = 0;
+    cachedImages.clear();
     m_imageMap.clear();
 }
 
+void ImageManager::WaitAsyncLoadTasks()
+{
+    //已经取消的任务在工作线程中开始执行时直接返回，正在读取或者解码的任务需要等待其结束
+    std::unique_lock<std::mutex> taskLock(m_asyncTaskMutex);
+    m_asyncTaskCond.wait(taskLock, [this]() {
+            return m_nAsyncTaskCount == 0;
+        });
+}
+
+void ImageManager::TouchImageCache(const std::shared_ptr<ImageInfo>& sharedImage)
+{
+    ASSERT(sharedImage != nullptr);
+    if (sharedImage == nullptr) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    if ((m_nCacheMaxBytes == 0) || (m_nCacheMaxCount == 0)) {
+        return;
+    }
+    //图片帧数据的大小可能变化（按需解码的动画图片），每次重新计算
+    const uint64_t nDataSize = sharedImage->GetBitmapDataSize();
+    auto iter = m_cachedImageMap.find(sharedImage.get());
+    if (iter != m_cachedImageMap.end()) {
+        std::list<TCachedImage>::iterator itCached = iter->second;
+        itCached->m_nDataSize = nDataSize;
+        //移到最前面（最近使用）
+        m_cachedImages.splice(m_cachedImages.begin(), m_cachedImages, itCached);
+    }
+    else {
+        TCachedImage cachedImage;
+        cachedImage.m_sharedImage = sharedImage;
+        cachedImage.m_nDataSize = nDataSize;
+        m_cachedImages.push_front(cachedImage);
+        m_cachedImageMap[sharedImage.get()] = m_cachedImages.begin();
+    }
+    EvictImageCache(m_nCacheMaxBytes, m_nCacheMaxCount);
+}
+
+bool ImageManager::IsCachedImageReferenced(const TCachedImage& cachedImage)
+{
+    //除缓存外还有其他引用（控件、异步加载完成待取走的图片等）
+    return cachedImage.m_sharedImage.use_count() > 1;
+}
+
+void ImageManager::GetUnreferencedCacheSize(uint64_t& nCachedBytes, size_t& nCachedCount) const
+{
+    nCachedBytes = 0;
+    nCachedCount = 0;
+    for (const TCachedImage& cachedImage : m_cachedImages) {
+        if (!IsCachedImageReferenced(cachedImage)) {
+            nCachedBytes += cachedImage.m_nDataSize;
+            nCachedCount += 1;
+        }
+    }
+}
+
+void ImageManager::EvictImageCache(uint64_t nMaxBytes, size_t nMaxCount)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    //仍被引用的图片不计入缓存的大小，也不淘汰（从缓存中移除并不能释放图片数据），
+    //只按上限淘汰没有其他引用的图片，从最久未使用的开始
+    uint64_t nCachedBytes = 0;
+    size_t nCachedCount = 0;
+    GetUnreferencedCacheSize(nCachedBytes, nCachedCount);
+    std::vector<std::shared_ptr<ImageInfo>> evictedImages;
+    auto iter = m_cachedImages.end();
+    while ((iter != m_cachedImages.begin()) && ((nCachedBytes > nMaxBytes) || (nCachedCount > nMaxCount))) {
+        --iter;
+        if (IsCachedImageReferenced(*iter)) {
+            continue;
+        }
+        nCachedBytes -= iter->m_nDataSize;
+        nCachedCount -= 1;
+        evictedImages.push_back(iter->m_sharedImage);
+        m_cachedImageMap.erase(iter->m_sharedImage.get());
+        iter = m_cachedImages.erase(iter);
+        m_cacheStat.m_nEvictCount += 1;
+    }
+    m_cacheStat.m_nCachedBytes = nCachedBytes;
+    m_cacheStat.m_nCachedCount = nCachedCount;
+    //先从缓存中移除，再释放图片（图片的释放回调中会修改其他容器）
+    evictedImages.clear();
+}
+
+std::shared_ptr<ImageInfo> ImageManager::RemoveImageCache(const ImageInfo* pImageInfo)
+{
+    std::shared_ptr<ImageInfo> sharedImage;
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    auto iter = m_cachedImageMap.find(pImageInfo);
+    if (iter != m_cachedImageMap.end()) {
+        std::list<TCachedImage>::iterator itCached = iter->second;
+        sharedImage = itCached->m_sharedImage;
+        m_cachedImageMap.erase(iter);
+        m_cachedImages.erase(itCached);
+    }
+    return sharedImage;
+}
+
+void ImageManager::SetImageCacheLimit(uint64_t nMaxBytes, size_t nMaxCount)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    m_nCacheMaxBytes = nMaxBytes;
+    m_nCacheMaxCount = nMaxCount;
+    EvictImageCache(m_nCacheMaxBytes, m_nCacheMaxCount);
+}
+
+uint64_t ImageManager::GetImageCacheMaxBytes() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    return m_nCacheMaxBytes;
+}
+
+size_t ImageManager::GetImageCacheMaxCount() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    return m_nCacheMaxCount;
+}
+
+void ImageManager::TrimImageCache(uint64_t nMaxBytes)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    EvictImageCache(nMaxBytes, (nMaxBytes == 0) ? 0 : m_cachedImages.size());
+}
+
+ImageCacheStat ImageManager::GetImageCacheStat() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    //控件释放图片后，图片才计入缓存的大小，所以每次重新统计
+    ImageCacheStat cacheStat = m_cacheStat;
+    GetUnreferencedCacheSize(cacheStat.m_nCachedBytes, cacheStat.m_nCachedCount);
+    return cacheStat;
+}
+
+void ImageManager::AddCacheStat(bool bHit)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    if (bHit) {
+        m_cacheStat.m_nHitCount += 1;
+    }
+    else {
+        m_cacheStat.m_nMissCount += 1;
+    }
+}
+
 void ImageManager::SetDpiScaleAllImages(bool bEnable)
 {
     m_bDpiScaleAllImages = bEnable;
@@ -229,6 +773,32 @@ bool ImageManager::IsDpiScaleAllImages() const
     return m_bDpiScaleAllImages;
 }
 
+void ImageManager::SetAsyncLoadImage(bool bAsyncLoadImage)
+{
+    m_bAsyncLoadImage = bAsyncLoadImage;
+}
+
+bool ImageManager::IsAsyncLoadImage() const
+{
+    return m_bAsyncLoadImage;
+}
+
+void ImageManager::SetImageDiskCachePath(const FilePath& diskCachePath, uint64_t nMaxBytes)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+        m_imageDiskCachePath = diskCachePath;
+    }
+    //缓存的Key包含图片文件内容的哈希值，图片文件修改、DPI或者加载属性变化后，旧的缓存文件不再使用，需要按大小上限清理
+    ImageDiskCache::TrimCacheFiles(diskCachePath, nMaxBytes);
+}
+
+FilePath ImageManager::GetImageDiskCachePath() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_imageMutex);
+    return m_imageDiskCachePath;
+}
+
 void ImageManager::SetAutoMatchScaleImage(bool bAutoMatchScaleImage)
 {
     m_bAutoMatchScaleImage = bAutoMatchScaleImage;
@@ -2,10 +2,16 @@
 #define UI_CORE_IMAGEMANAGER_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Core/Callback.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
 #include <vector>
+#include <list>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 namespace ui 
 {
@@ -14,7 +20,29 @@ class ImageLoadAttribute;
 class DpiManager;
 class Window;
 
+/** 图片缓存的统计信息
+*/
+struct ImageCacheStat
+{
+    //从缓存中获取到图片的次数
+    uint64_t m_nHitCount = 0;
+
+    //缓存中没有，需要加载图片的次数
+    uint64_t m_nMissCount = 0;
+
+    //因超出缓存上限而从缓存中移除的图片个数
+    uint64_t m_nEvictCount = 0;
+
+    //当前缓存中保留的图片个数（不包含仍被控件使用的图片）
+    size_t m_nCachedCount = 0;
+
+    //当前缓存中保留的图片数据总大小（字节，不包含仍被控件使用的图片）
+    uint64_t m_nCachedBytes = 0;
+};
+
 /** 图片管理器
+ *  多线程：GetImage、AddImageData和图片缓存相关的接口可以在任意线程中调用（比如在工作线程中预先解码缩略图），
+ *          图片的查找和缓存使用锁保护，文件读取和解码在锁外执行；异步加载和预加载相关的接口只能在UI线程中调用
  */
 class UILIB_API ImageManager
 {
@@ -29,14 +57,120 @@ public:
      * @param [in] pWindow 图片关联的窗口（用于DPI缩放、HICON绘制等）
      * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息     
      * @return 返回图片 ImageInfo 对象的智能指针
+     *  注：窗口是UI线程的对象，pWindow不为nullptr时只能在UI线程中调用，在工作线程中加载图片请使用按DPI加载的版本；
+     *      多个线程同时加载同一个图片时，缓存中只保留先加载完成的图片
      */
     std::shared_ptr<ImageInfo> GetImage(const Window* pWindow,
                                         const ImageLoadAttribute& loadAtrribute);
 
+    /** 按指定的DPI加载图片 ImageInfo 对象（可以在任意线程中调用，比如在工作线程中预先解码缩略图）
+     * @param [in] uDpi 图片关联的DPI值（比如96，可在UI线程中通过窗口的Dpi().GetDPI()获取）
+     * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息
+     * @return 返回图片 ImageInfo 对象的智能指针
+     *  注：HICON只能在UI线程中加载
+     */
+    std::shared_ptr<ImageInfo> GetImage(uint32_t uDpi,
+                                        const ImageLoadAttribute& loadAtrribute);
+
+    /** 异步加载图片 ImageInfo 对象（只能在UI线程中调用）
+     *  图片文件的读取和解码在工作线程中执行，加载完成后在UI线程中回调loadedCallback，
+     *  回调后再次调用本函数即可获取到图片；同一个加载Key的多次请求只解码一次，完成后回调所有的请求方
+     * @param [in] pWindow 图片关联的窗口（用于DPI缩放、HICON绘制等）
+     * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息
+     * @param [in] loadedCallback 图片加载完成的回调函数（加载失败时不回调；同一个请求方（WeakCallback的标志相同）在加载完成前只保留一个回调）
+     * @return 如果图片已经在缓存中，返回图片 ImageInfo 对象的智能指针；如果正在异步加载，返回nullptr
+     *  注：未开启异步加载（参见SetAsyncLoadImage）、非UI线程、HICON等情况下，同步加载，与GetImage相同
+     */
+    std::shared_ptr<ImageInfo> GetImageAsync(const Window* pWindow,
+                                             const ImageLoadAttribute& loadAtrribute,
+                                             const WeakCallback<StdClosure>& loadedCallback);
+
+    /** 将外部解码的图片数据加入缓存（比如在工作线程中解码的缩略图），控件使用相同的加载属性时，直接从缓存中获取
+     *  如果缓存中已经有该加载Key对应的图片，则替换；pWindow不为nullptr时只能在UI线程中调用，在工作线程中请使用按DPI添加的版本
+     * @param [in] pWindow 图片关联的窗口（用于计算加载Key中的DPI缩放百分比），为nullptr时使用全局的DPI
+     * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息（路径需要与控件加载图片时的完整路径相同，可以是不存在的绝对路径）
+     * @param [in] pPixelBits 位图数据，每个像素4字节，行序从上到下，Alpha预乘，Windows平台为BGRA格式，其他平台为RGBA格式
+     * @param [in] nWidth 位图宽度
+     * @param [in] nHeight 位图高度
+     * @return 返回图片 ImageInfo 对象的智能指针，失败返回nullptr
+     */
+    std::shared_ptr<ImageInfo> AddImageData(const Window* pWindow,
+                                            const ImageLoadAttribute& loadAtrribute,
+                                            const void* pPixelBits,
+                                            uint32_t nWidth,
+                                            uint32_t nHeight);
+
+    /** 按指定的DPI将外部解码的图片数据加入缓存（可以在任意线程中调用），参数含义同上
+     * @param [in] uDpi 图片关联的DPI值（用于计算加载Key中的DPI缩放百分比）
+     */
+    std::shared_ptr<ImageInfo> AddImageData(uint32_t uDpi,
+                                            const ImageLoadAttribute& loadAtrribute,
+                                            const void* pPixelBits,
+                                            uint32_t nWidth,
+                                            uint32_t nHeight);
+
+    /** 预加载图片（只能在UI线程中调用）：在工作线程中读取和解码图片，完成后加入缓存，控件首次绘制时可以直接从缓存中获取
+     *  与是否开启异步加载（SetAsyncLoadImage）无关；图片已经在缓存中或者正在加载时，不重复加载
+     * @param [in] pWindow 图片关联的窗口（用于DPI缩放等）
+     * @param [in] loadAtrribute 图片的加载属性，包含图片路径等信息
+     * @return 如果开始预加载返回true，否则返回false
+     */
+    bool PrefetchImage(const Window* pWindow, const ImageLoadAttribute& loadAtrribute);
+
     /** 从缓存中删除所有图片
+     *  取消所有的异步加载任务，并等待正在工作线程中读取或者解码的任务结束后返回
+     *  （GlobalManager::Shutdown在关闭资源压缩包和释放渲染接口之前调用）
      */
     void RemoveAllImages();
 
+    /** 设置图片缓存的上限：最近使用的图片在没有控件引用后，仍然保留在缓存中，直到超出上限
+    *  （避免切换TabBox页面、虚表控件重新填充数据等场景下，重复解码同样的图片），默认上限为32MB和256个图片
+    *   注：上限只计算没有控件引用的图片，仍被控件使用的图片不计入，也不会因超出上限而移除
+    * @param [in] nMaxBytes 保留图片数据的总大小上限（字节），为0表示不保留
+    * @param [in] nMaxCount 保留图片的个数上限，为0表示不保留
+    */
+    void SetImageCacheLimit(uint64_t nMaxBytes, size_t nMaxCount);
+
+    /** 获取保留图片数据的总大小上限（字节）
+    */
+    uint64_t GetImageCacheMaxBytes() const;
+
+    /** 获取保留图片的个数上限
+    */
+    size_t GetImageCacheMaxCount() const;
+
+    /** 释放缓存中保留的图片，使保留图片数据的总大小不超过nMaxBytes（比如在内存不足时调用）
+    *   注：只影响没有控件引用的图片，仍被控件使用的图片不会被释放，也不计入总大小
+    * @param [in] nMaxBytes 保留图片数据的总大小（字节），为0表示释放所有保留的图片
+    */
+    void TrimImageCache(uint64_t nMaxBytes = 0);
+
+    /** 获取图片缓存的统计信息
+    */
+    ImageCacheStat GetImageCacheStat() const;
+
+    /** 设置是否异步加载图片（在工作线程中解码图片，避免大量图片在绘制过程中同步解码导致界面卡顿），默认为false
+    *   开启后，控件的图片在加载完成前不绘制，加载完成后控件自动重绘（如果控件大小依赖图片大小，则重新布局）
+    */
+    void SetAsyncLoadImage(bool bAsyncLoadImage);
+
+    /** 获取是否异步加载图片
+    */
+    bool IsAsyncLoadImage() const;
+
+    /** 设置图片解码结果的磁盘缓存目录，默认为空（不使用磁盘缓存）
+    *   设置后，解码并按DPI缩放后的位图数据保存在该目录中，程序再次启动时直接从缓存文件中创建位图，不需要再解码图片，
+    *   缓存与图片文件的内容关联，图片文件修改后缓存自动失效（旧的缓存文件不再使用）；
+    *   设置时按大小上限清理缓存目录：缓存文件总大小超过上限时，按最后使用时间从旧到新删除（程序启动时设置一次即可）
+    * @param [in] diskCachePath 缓存目录（不存在时自动创建）
+    * @param [in] nMaxBytes 缓存文件总大小的上限（字节），默认为256MB
+    */
+    void SetImageDiskCachePath(const FilePath& diskCachePath, uint64_t nMaxBytes = 256 * 1024 * 1024);
+
+    /** 获取图片解码结果的磁盘缓存目录
+    */
+    FilePath GetImageDiskCachePath() const;
+
     /** 设置是否默认对所有图片在加载时根据DPI进行缩放，这个是全局属性，默认为true，应用于所有图片
        （设置为true后，也可以通过在xml中，使用"dpiscale='false'"属性关闭某个图片的DPI自动缩放）
     */
@@ -57,6 +191,115 @@ public:
     bool IsAutoMatchScaleImage() const;
 
 private:
+    /** 加载一个图片使用的参数
+    */
+    struct TImageLoadParam
+    {
+        //图片的加载Key
+        DString loadKey;
+
+        //图片的Key（多个加载Key可能对应同一个图片Key）
+        DString imageKey;
+
+        //实际加载的图片文件路径（可能是对应DPI的图片文件）
+        DString imageFullPath;
+
+        //是否使用zip压缩包资源
+        bool bUseZip = false;
+
+        //是否允许按照DPI对图片大小进行缩放
+        bool bEnableImageDpiScale = true;
+
+        //是否为对应DPI的图片文件
+        bool bDpiScaledImageFile = false;
+
+        //图片文件对应的DPI缩放百分比
+        uint32_t nImageDpiScale = 100;
+
+        //图片解码结果的磁盘缓存目录
+        FilePath diskCachePath;
+    };
+
+    /** 加载图片 ImageInfo 对象（GetImage的实现）
+    * @param [in] pWindow 图片关联的窗口（仅用于加载HICON，可以为nullptr）
+    * @param [in] dpi 图片关联的DPI
+    * @param [in] loadAtrribute 图片的加载属性
+    */
+    std::shared_ptr<ImageInfo> GetImageImpl(const Window* pWindow,
+                                            const DpiManager& dpi,
+                                            const ImageLoadAttribute& loadAtrribute);
+
+    /** 根据加载Key，从缓存中查找图片
+    */
+    std::shared_ptr<ImageInfo> FindImageByLoadKey(const DString& loadKey) const;
+
+    /** 根据图片Key，从缓存中查找图片（图片加载时的DPI缩放百分比必须与dpiScale相同）
+    */
+    std::shared_ptr<ImageInfo> FindImageByImageKey(const DString& imageKey, uint32_t dpiScale) const;
+
+    /** 计算加载图片使用的参数（查找对应DPI的图片文件，计算图片Key）
+    */
+    void GetImageLoadParam(const DpiManager& dpi,
+                           const ImageLoadAttribute& loadAtrribute,
+                           TImageLoadParam& loadParam) const;
+
+    /** 读取图片文件的数据（本地文件或者zip压缩包，可在工作线程中调用）
+    */
+    static void ReadImageFileData(const TImageLoadParam& loadParam, std::vector<uint8_t>& fileData);
+
+    /** 解码图片数据（可在工作线程中调用）
+    */
+    static std::unique_ptr<ImageInfo> DecodeImageData(std::vector<uint8_t>& fileData,
+                                                      const ImageLoadAttribute& loadAtrribute,
+                                                      const TImageLoadParam& loadParam,
+                                                      const DpiManager& dpi);
+
+    /** 将加载完成的图片添加到缓存中
+    */
+    std::shared_ptr<ImageInfo> AddImageCache(std::unique_ptr<ImageInfo>& imageInfo,
+                                             const DString& loadKey,
+                                             uint32_t loadDpiScale,
+                                             bool bDpiScaledImageFile);
+
+    /** 图片被使用（从缓存中获取或者新加载），保留在缓存中，并标记为最近使用
+    */
+    void TouchImageCache(const std::shared_ptr<ImageInfo>& sharedImage);
+
+    /** 等待所有的异步加载任务结束（在工作线程中执行的任务会访问资源压缩包和渲染接口，释放这些资源前需要等待）
+    */
+    void WaitAsyncLoadTasks();
+
+    /** 按照上限，从缓存中移除最久未使用的图片（只移除没有其他引用的图片）
+    */
+    void EvictImageCache(uint64_t nMaxBytes, size_t nMaxCount);
+
+    /** 统计缓存中没有其他引用的图片（只有这部分图片计入缓存的上限）
+    * @param [out] nCachedBytes 图片数据的总大小（字节）
+    * @param [out] nCachedCount 图片的个数
+    */
+    void GetUnreferencedCacheSize(uint64_t& nCachedBytes, size_t& nCachedCount) const;
+
+    /** 从缓存中移除一个图片（图片被替换时调用，不再保留在缓存中）
+    * @return 返回缓存中保留的图片引用，由调用方在修改完映射表后释放
+    */
+    std::shared_ptr<ImageInfo> RemoveImageCache(const ImageInfo* pImageInfo);
+
+    /** 更新图片缓存的命中统计
+    */
+    void AddCacheStat(bool bHit);
+
+    /** 在工作线程中读取和解码图片，完成后在UI线程中调用OnAsyncImageLoaded
+    */
+    void StartAsyncLoad(const ImageLoadAttribute& loadAtrribute,
+                        const TImageLoadParam& loadParam,
+                        const DpiManager& dpi);
+
+    /** 异步加载图片完成（在UI线程中执行）
+    */
+    void OnAsyncImageLoaded(const TImageLoadParam& loadParam,
+                            uint32_t loadDpiScale,
+                            std::unique_ptr<ImageInfo>& imageInfo);
+
     /** 图片被销毁的回调函数，用于释放图片资源
      * @param[in] pImageInfo 图片对应的 ImageInfo 对象
      */
@@ -108,11 +351,17 @@ private:
     /** 是否默认对所有图片在加载时根据DPI进行缩放，这个是全局属性，默认为true，应用于所有图片
        （设置为true后，也可以通过在xml中，使用"dpiscale='false'"属性关闭某个图片的DPI自动缩放）
     */
-    bool m_bDpiScaleAllImages;
+    std::atomic<bool> m_bDpiScaleAllImages;
 
     /** 是否智能匹配临近的缩放百分比图片
+    *  （以上两个选项在UI线程中设置，在工作线程中加载图片时也会读取，所以使用原子变量）
     */
-    bool m_bAutoMatchScaleImage;
+    std::atomic<bool> m_bAutoMatchScaleImage;
+
+    /** 图片资源映射表、缓存中保留的图片、统计信息和磁盘缓存目录的多线程同步锁
+    *  （使用可重入锁：释放图片时，图片的释放回调中需要再次加锁修改映射表）
+    */
+    mutable std::recursive_mutex m_imageMutex;
 
     /** 图片资源映射表（图片的Key与图片数据）
     */
@@ -121,6 +370,69 @@ private:
     /** 图片资源Key映射表（图片的加载Key与图片Key）
     */
     std::unordered_map <DString, DString> m_loadKeyMap;
+
+    /** 缓存中保留的图片（强引用）
+    */
+    struct TCachedImage
+    {
+        //图片数据
+        std::shared_ptr<ImageInfo> m_sharedImage;
+
+        //图片数据的大小（字节）
+        uint64_t m_nDataSize = 0;
+    };
+
+    /** 缓存中的图片是否还有其他引用（控件等）
+    */
+    static bool IsCachedImageReferenced(const TCachedImage& cachedImage);
+
+    /** 缓存中保留的图片，按最近使用排序（最近使用的在前面）
+    *  仍被其他地方引用的图片也在列表中（保持使用顺序），但不计入缓存的上限，也不会被淘汰
+    */
+    std::list<TCachedImage> m_cachedImages;
+
+    /** 缓存中保留的图片的索引
+    */
+    std::unordered_map<const ImageInfo*, std::list<TCachedImage>::iterator> m_cachedImageMap;
+
+    /** 保留图片数据的总大小上限（字节）
+    */
+    uint64_t m_nCacheMaxBytes;
+
+    /** 保留图片的个数上限
+    */
+    size_t m_nCacheMaxCount;
+
+    /** 图片缓存的统计信息
+    */
+    ImageCacheStat m_cacheStat;
+
+    /** 是否异步加载图片
+    */
+    bool m_bAsyncLoadImage;
+
+    /** 正在异步加载的图片（图片的加载Key与加载完成的回调函数）
+    */
+    std::unordered_map<DString, std::vector<WeakCallback<StdClosure>>> m_asyncLoadingMap;
+
+    /** 异步加载完成、等待请求方取走的图片（图片的加载Key与图片数据），
+    *   在请求方重绘前保持图片的引用，避免图片在被取走前释放
+    */
+    std::unordered_map<DString, std::shared_ptr<ImageInfo>> m_asyncLoadedMap;
+
+    /** 异步加载任务的取消机制（删除所有图片时，丢弃正在加载的结果）
+    */
+    WeakCallbackFlag m_asyncLoadFlag;
+
+    /** 正在执行（或者等待执行）的异步加载任务个数，及其同步锁和条件变量
+    */
+    size_t m_nAsyncTaskCount;
+    std::mutex m_asyncTaskMutex;
+    std::condition_variable m_asyncTaskCond;
+
+    /** 图片解码结果的磁盘缓存目录（工作线程中加载图片时也会读取，使用m_imageMutex保护）
+    */
+    FilePath m_imageDiskCachePath;
 };
 
 }
@@ -11,6 +11,7 @@
 #ifdef DUILIB_BUILD_FOR_SDL
 
 #include <SDL3/SDL.h>
+#include <cstdlib>
 
 /** 主动绘制
 */
@@ -173,9 +174,27 @@ public:
     */
     virtual bool GetUpdateRect(UiRect& rcUpdate) const override
     {
-        rcUpdate = m_pNativeWindow->GetUpdateRect();
+        rcUpdate = m_pNativeWindow->GetUpdateRegion().GetBounds();
         return !rcUpdate.IsEmpty();
     }
+
+    /** 获取界面需要绘制的多个区域，以实现局部绘制
+    * @param [out] updateRects 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& updateRects) const override
+    {
+        updateRects = m_pNativeWindow->GetUpdateRegion().GetRects();
+        return !updateRects.empty();
+    }
+
+    /** 获取无需重新绘制、但需要更新到窗口的区域
+    * @param [out] scrolledRects 返回区域矩形列表
+    */
+    virtual void GetScrolledRects(std::vector<UiRect>& scrolledRects) const override
+    {
+        scrolledRects = m_pNativeWindow->GetScrolledRegion().GetRects();
+    }
 };
 
 bool NativeWindow_SDL::OnSDLWindowEvent(const SDL_Event& sdlEvent)
@@ -2058,12 +2077,8 @@ static bool SDLCALL FilterNativeWindowExposedEvent(void* userdata, SDL_Event* ev
 
 void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
 {
-    if (m_rcUpdateRect.IsZero()) {
-        m_rcUpdateRect = rcItem;
-    }
-    else {
-        m_rcUpdateRect.Union(rcItem);
-    }
+    //记录需要更新的区域（多个矩形，相距较远的区域不合并，以减少绘制的范围）
+    m_updateRegion.Union(rcItem);
 
     //暂时没有此功能, 只能发送一个绘制消息，触发界面绘制
     if (m_sdlWindow != nullptr) {
@@ -2085,12 +2100,66 @@ void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
     }
 }
 
+bool NativeWindow_SDL::ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    if ((m_sdlWindow == nullptr) || (m_pOwner == nullptr) || ((dx == 0) && (dy == 0))) {
+        return false;
+    }
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    UiRect rcValid = rcScroll;
+    if (!rcValid.Intersect(rcClient)) {
+        return false;
+    }
+    if ((std::abs(dx) >= rcValid.Width()) || (std::abs(dy) >= rcValid.Height())) {
+        //移动后没有可复用的像素
+        return false;
+    }
+    IRender* pRender = m_pOwner->OnNativeGetRender();
+    if ((pRender == nullptr) || (pRender->GetWidth() != rcClient.Width()) || (pRender->GetHeight() != rcClient.Height())) {
+        return false;
+    }
+    //移动已经绘制的像素（非CPU绘制时不支持）
+    if (!pRender->ScrollRect(rcValid, dx, dy)) {
+        return false;
+    }
+
+    //等待绘制的区域内容已经过时，移动后所在的位置也需要重绘（原位置仍需重绘）
+    const std::vector<UiRect> updateRects = m_updateRegion.GetRects();
+    for (const UiRect& rcUpdate : updateRects) {
+        UiRect rcMoved;
+        if (UiRect::Intersect(rcMoved, rcUpdate, rcValid)) {
+            rcMoved.Offset(dx, dy);
+            if (rcMoved.Intersect(rcValid)) {
+                m_updateRegion.Union(rcMoved);
+            }
+        }
+    }
+
+    //整个区域需要更新到窗口，但只有移动后空出的区域需要重绘
+    m_scrolledRegion.Union(rcValid);
+    if (dx > 0) {
+        Invalidate(UiRect(rcValid.left, rcValid.top, rcValid.left + dx, rcValid.bottom));
+    }
+    else if (dx < 0) {
+        Invalidate(UiRect(rcValid.right + dx, rcValid.top, rcValid.right, rcValid.bottom));
+    }
+    if (dy > 0) {
+        Invalidate(UiRect(rcValid.left, rcValid.top, rcValid.right, rcValid.top + dy));
+    }
+    else if (dy < 0) {
+        Invalidate(UiRect(rcValid.left, rcValid.bottom + dy, rcValid.right, rcValid.bottom));
+    }
+    return true;
+}
+
 void NativeWindow_SDL::PaintWindow(bool bPaintAll)
 {
     PerformanceStat statPerformance(_T("PaintWindow, NativeWindow_SDL::PaintWindow(Total)"));
     if (bPaintAll) {
         //绘制全部
-        m_rcUpdateRect.Clear();
+        m_updateRegion.Clear();
+        m_scrolledRegion.Clear();
     }
     INativeWindow* pOwner = m_pOwner;
     ASSERT(pOwner != nullptr);
@@ -2112,12 +2181,18 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
             bPaint = pRender->PaintAndSwapBuffers(&renderPaint);
         }
     }
-    m_rcUpdateRect.Clear();
+    m_updateRegion.Clear();
+    m_scrolledRegion.Clear();
+}
+
+const UiRegion& NativeWindow_SDL::GetUpdateRegion() const
+{
+    return m_updateRegion;
 }
 
-const UiRect& NativeWindow_SDL::GetUpdateRect() const
+const UiRegion& NativeWindow_SDL::GetScrolledRegion() const
 {
-    return m_rcUpdateRect;
+    return m_scrolledRegion;
 }
 
 void NativeWindow_SDL::GetClientRect(UiRect& rcClient) const
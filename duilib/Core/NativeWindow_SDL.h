@@ -4,6 +4,7 @@
 #include "duilib/Core/INativeWindow.h"
 #include "duilib/Core/WindowCreateParam.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/UiRegion.h"
 #include "duilib/Utils/FilePath.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -359,6 +360,14 @@ public:
     */
     void Invalidate(const UiRect& rcItem);
 
+    /** 滚动窗口中指定区域的内容：移动已经绘制的像素，只重绘移动后空出的区域
+    * @param [in] rcScroll 滚动的区域，为客户区坐标
+    * @param [in] dx X轴方向移动的距离，正数向右移动，负数向左移动
+    * @param [in] dy Y轴方向移动的距离，正数向下移动，负数向上移动
+    * @return 成功返回true；如果不支持或者不满足条件返回false，此时需要调用者重绘整个区域
+    */
+    bool ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy);
+
     /** 更新窗口，执行重绘
     */
     bool UpdateWindow() const;
@@ -501,9 +510,13 @@ public:
     */
     void PaintWindow(bool bPaintAll);
 
-    /** 窗口更新的区域（需要绘制）
+    /** 窗口更新的区域（需要绘制，由多个矩形组成）
+    */
+    const UiRegion& GetUpdateRegion() const;
+
+    /** 滚动时已经移动过像素的区域（无需重绘，但需要更新到窗口）
     */
-    const UiRect& GetUpdateRect() const;
+    const UiRegion& GetScrolledRegion() const;
 
 private:
     /** 创建窗口和渲染接口
@@ -660,9 +673,13 @@ private:
     */
     bool m_bIsLayeredWindow;
 
-    /** 窗口更新的区域（需要绘制）
+    /** 窗口更新的区域（需要绘制，由多个矩形组成）
+    */
+    UiRegion m_updateRegion;
+
+    /** 滚动时已经移动过像素的区域（无需重绘，但需要更新到窗口）
     */
-    UiRect m_rcUpdateRect;
+    UiRegion m_scrolledRegion;
 };
 
 /** 定义别名
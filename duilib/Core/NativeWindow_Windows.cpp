@@ -1198,6 +1198,12 @@ void NativeWindow_Windows::Invalidate(const UiRect& rcItem)
     }
 }
 
+bool NativeWindow_Windows::ScrollWindowRect(const UiRect& /*rcScroll*/, int32_t /*dx*/, int32_t /*dy*/)
+{
+    //Windows平台的绘制区域由系统管理（::GetUpdateRect），暂不支持只更新到窗口而不重绘的区域
+    return false;
+}
+
 bool NativeWindow_Windows::UpdateWindow() const
 {
     bool bRet = false;
@@ -321,6 +321,14 @@ public:
     */
     void Invalidate(const UiRect& rcItem);
 
+    /** 滚动窗口中指定区域的内容：移动已经绘制的像素，只重绘移动后空出的区域
+    * @param [in] rcScroll 滚动的区域，为客户区坐标
+    * @param [in] dx X轴方向移动的距离，正数向右移动，负数向左移动
+    * @param [in] dy Y轴方向移动的距离，正数向下移动，负数向上移动
+    * @return 成功返回true；如果不支持或者不满足条件返回false，此时需要调用者重绘整个区域
+    */
+    bool ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy);
+
     /** 更新窗口，执行重绘
     */
     bool UpdateWindow() const;
@@ -77,6 +77,11 @@ public:
     /** 全局资源描述XML文件的文件名，默认为："global.xml"
     */
     DString globalXmlFileName = _T("global.xml");
+
+    /** 是否优先加载编译后的皮肤文件（XML文件名 + ".skb"，由皮肤编译工具tools/skin_compiler生成）
+    *   如果编译后的文件不存在或者校验失败，仍然加载XML文件
+    */
+    bool useCompiledSkin = false;
 };
 
 /** 加载全局资源所需的参数（本地文件形式，对应资源类型：kLocalFiles）
@@ -0,0 +1,566 @@
+#include "SkinBinary.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/AttributeUtil.h"
+
+#include "duilib/third_party/xml/pugixml.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace ui
+{
+/** 文件头的标识："DSKB"
+*/
+static constexpr uint32_t kSkinBinaryMagic = 0x424B5344;
+
+/** 文件头的标志：控件的class属性已经展开
+*/
+static constexpr uint32_t kSkinBinaryFlagClassExpanded = 0x01;
+
+/** 节点嵌套的最大层数（避免异常数据导致栈溢出）
+*/
+static constexpr uint32_t kSkinBinaryMaxDepth = 256;
+
+/** 节点类型
+*/
+enum SkinBinaryNodeType : uint32_t
+{
+    kSkinNodeElement = 1,   //元素节点
+    kSkinNodeText    = 2,   //文本节点
+    kSkinNodeCData   = 3    //CDATA节点
+};
+
+/** 文件头（文件中的所有数值都是小端字节序）
+*   文件格式：文件头 + 字符串偏移表（uint32_t * 字符串个数） + 字符串数据（UTF-8编码，以'\0'结尾） + 节点数据（uint32_t数组）
+*   节点数据按深度优先顺序存储，每个节点的格式为：
+*   节点类型，名称序号，值序号，属性个数，子节点个数，[属性名序号，属性值序号] * 属性个数，子节点 * 子节点个数
+*/
+struct TSkinBinaryHeader
+{
+    uint32_t m_nMagic;          //文件头标识
+    uint32_t m_nVersion;        //文件格式版本号
+    uint32_t m_nHeaderSize;     //文件头的长度
+    uint32_t m_nFlags;          //标志
+    uint64_t m_nSourceHash;     //XML文件数据的哈希值
+    uint64_t m_nClassHash;      //展开class属性时使用的全局Class的哈希值
+    uint32_t m_nSourceSize;     //XML文件数据的长度
+    uint32_t m_nStringCount;    //字符串个数
+    uint32_t m_nStringDataSize; //字符串数据的长度（字节）
+    uint32_t m_nNodeDataCount;  //节点数据的长度（uint32_t的个数）
+};
+
+/** 计算XML文件数据的哈希值（每次处理8个字节，剩余的字节按FNV-1a计算）
+*   加载时每次都需要计算XML文件的哈希值，逐字节计算的FNV-1a只有约500MB/s，耗时与解析XML文本相当
+*/
+static uint64_t GetSourceHash(const uint8_t* pData, size_t nDataSize)
+{
+    uint64_t nHash = 14695981039346656037ULL ^ (uint64_t)nDataSize;
+    size_t i = 0;
+    for (; (i + sizeof(uint64_t)) <= nDataSize; i += sizeof(uint64_t)) {
+        uint64_t nValue = 0;
+        ::memcpy(&nValue, pData + i, sizeof(nValue));
+        nHash = (nHash ^ nValue) * 0x9E3779B97F4A7C15ULL;
+        nHash ^= nHash >> 29;
+    }
+    for (; i < nDataSize; ++i) {
+        nHash ^= pData[i];
+        nHash *= 1099511628211ULL;
+    }
+    nHash ^= nHash >> 32;
+    nHash *= 0xD6E8FEB86659FD93ULL;
+    nHash ^= nHash >> 32;
+    return nHash;
+}
+
+/** 读取一个uint32_t数值（数据可能未对齐，比如压缩包中的文件）
+*/
+static inline uint32_t ReadUInt32(const uint8_t* pData)
+{
+    uint32_t nValue = 0;
+    ::memcpy(&nValue, pData, sizeof(nValue));
+    return nValue;
+}
+
+/** 解析XML数据（与WindowBuilder解析XML文件时的参数相同）
+*/
+static bool LoadXmlDocument(const std::vector<uint8_t>& xmlData, pugi::xml_document& xmlDoc)
+{
+    if (xmlData.empty()) {
+        return false;
+    }
+    pugi::xml_parse_result result = xmlDoc.load_buffer(xmlData.data(), xmlData.size());
+    return result.status == pugi::status_ok;
+}
+
+/** 读取节点下的Class定义（与WindowBuilder中的实现保持一致，属性列表的格式相同）
+*/
+static void ReadClassNodes(const pugi::xml_node& root, std::map<DString, DString>& classMap)
+{
+    for (pugi::xml_node node : root.children(_T("Class"))) {
+        DString strClassName;
+        DString strAttribute;
+        for (pugi::xml_attribute attr : node.attributes()) {
+            DString strName = attr.name();
+            DString strValue = attr.value();
+            if (strName == _T("name")) {
+                strClassName = strValue;
+            }
+            else {
+                strAttribute.append(StringUtil::Printf(_T(" %s=\"%s\""), strName.c_str(), strValue.c_str()));
+            }
+        }
+        if (!strClassName.empty()) {
+            StringUtil::TrimLeft(strAttribute);
+            classMap[strClassName] = strAttribute;
+        }
+    }
+}
+
+/** 编译过程
+*/
+class SkinBinaryWriter
+{
+public:
+    SkinBinaryWriter(const std::map<DString, DString>& globalClassMap,
+                     const std::map<DString, DString>& windowClassMap):
+        m_globalClassMap(globalClassMap),
+        m_windowClassMap(windowClassMap)
+    {
+        //序号为0的字符串是空字符串
+        AddString(DString());
+    }
+
+    /** 写入一个节点（含子节点）
+    * @param [in] xmlNode XML节点
+    * @param [in] bControl 该节点是否对应一个控件（只有控件的class属性才展开）
+    * @param [in] nDepth 节点的层级（根节点为0）
+    */
+    bool WriteNode(const pugi::xml_node& xmlNode, bool bControl, uint32_t nDepth)
+    {
+        uint32_t nType = 0;
+        switch (xmlNode.type()) {
+        case pugi::node_element:
+            nType = kSkinNodeElement;
+            break;
+        case pugi::node_pcdata:
+            nType = kSkinNodeText;
+            break;
+        case pugi::node_cdata:
+            nType = kSkinNodeCData;
+            break;
+        default:
+            //其他类型的节点，解析XML时也不会保留
+            return false;
+        }
+        const DString nodeName = xmlNode.name();
+        m_nodeData.push_back(nType);
+        m_nodeData.push_back(AddString(nodeName));
+        m_nodeData.push_back(AddString(xmlNode.value()));
+
+        std::vector<std::pair<DString, DString>> attributeList;
+        for (pugi::xml_attribute attr : xmlNode.attributes()) {
+            if (bControl && (StringUtil::StringCompare(attr.name(), _T("class")) == 0) &&
+                ExpandClass(attr.value(), attributeList)) {
+                continue;
+            }
+            attributeList.emplace_back(attr.name(), attr.value());
+        }
+        m_nodeData.push_back((uint32_t)attributeList.size());
+        const size_t nChildCountPos = m_nodeData.size();
+        m_nodeData.push_back(0);
+        for (const auto& attribute : attributeList) {
+            m_nodeData.push_back(AddString(attribute.first));
+            m_nodeData.push_back(AddString(attribute.second));
+        }
+
+        //根节点和控件的子节点是控件（资源节点除外）；RichText的子节点是文本片段，不是控件
+        const bool bChildControl = (bControl || (nDepth == 0)) && (nType == kSkinNodeElement) && (nodeName != _T("RichText"));
+        uint32_t nChildCount = 0;
+        for (pugi::xml_node childNode : xmlNode.children()) {
+            if (WriteNode(childNode, bChildControl && !IsResourceNode(childNode.name()), nDepth + 1)) {
+                ++nChildCount;
+            }
+        }
+        m_nodeData[nChildCountPos] = nChildCount;
+        return true;
+    }
+
+    /** 生成编译后的数据
+    */
+    void GetData(const std::vector<uint8_t>& xmlData, std::vector<uint8_t>& binData) const
+    {
+        std::vector<uint32_t> stringOffsets;
+        std::string stringData;
+        for (const std::string& str : m_strings) {
+            stringOffsets.push_back((uint32_t)stringData.size());
+            stringData.append(str);
+            stringData.push_back('\0');
+        }
+        //4字节对齐
+        while ((stringData.size() % sizeof(uint32_t)) != 0) {
+            stringData.push_back('\0');
+        }
+
+        TSkinBinaryHeader header;
+        ::memset(&header, 0, sizeof(header));
+        header.m_nMagic = kSkinBinaryMagic;
+        header.m_nVersion = SkinBinary::kVersion;
+        header.m_nHeaderSize = sizeof(TSkinBinaryHeader);
+        header.m_nFlags = m_nExpandedCount > 0 ? kSkinBinaryFlagClassExpanded : 0;
+        header.m_nSourceHash = GetSourceHash(xmlData.data(), xmlData.size());
+        header.m_nClassHash = (m_nExpandedCount > 0) ? SkinBinary::GetClassHash(m_globalClassMap) : 0;
+        header.m_nSourceSize = (uint32_t)xmlData.size();
+        header.m_nStringCount = (uint32_t)stringOffsets.size();
+        header.m_nStringDataSize = (uint32_t)stringData.size();
+        header.m_nNodeDataCount = (uint32_t)m_nodeData.size();
+
+        binData.clear();
+        binData.reserve(sizeof(header) + stringOffsets.size() * sizeof(uint32_t) +
+                        stringData.size() + m_nodeData.size() * sizeof(uint32_t));
+        const uint8_t* pHeader = (const uint8_t*)&header;
+        binData.insert(binData.end(), pHeader, pHeader + sizeof(header));
+        const uint8_t* pOffsets = (const uint8_t*)stringOffsets.data();
+        binData.insert(binData.end(), pOffsets, pOffsets + stringOffsets.size() * sizeof(uint32_t));
+        binData.insert(binData.end(), stringData.begin(), stringData.end());
+        const uint8_t* pNodeData = (const uint8_t*)m_nodeData.data();
+        binData.insert(binData.end(), pNodeData, pNodeData + m_nodeData.size() * sizeof(uint32_t));
+    }
+
+private:
+    /** 添加一个字符串到字符串表，返回字符串的序号（相同的字符串只保存一份）
+    */
+    uint32_t AddString(const DString& str)
+    {
+        std::string utf8 = StringConvert::TToUTF8(str);
+        auto iter = m_stringIndex.find(utf8);
+        if (iter != m_stringIndex.end()) {
+            return iter->second;
+        }
+        const uint32_t nIndex = (uint32_t)m_strings.size();
+        m_strings.push_back(utf8);
+        m_stringIndex[utf8] = nIndex;
+        return nIndex;
+    }
+
+    /** 展开class属性（与Control::SetClass的查找顺序相同：先查找全局的Class，再查找窗口的Class）
+    * @return 如果有Class找不到定义，返回false（保留class属性，由运行时展开）
+    */
+    bool ExpandClass(const DString& strClass, std::vector<std::pair<DString, DString>>& attributeList)
+    {
+        if (strClass.empty()) {
+            return false;
+        }
+        std::vector<std::pair<DString, DString>> classAttributeList;
+        std::list<DString> splitList = StringUtil::Split(strClass, _T(" "));
+        for (const DString& className : splitList) {
+            auto iter = m_globalClassMap.find(className);
+            if (iter == m_globalClassMap.end()) {
+                iter = m_windowClassMap.find(className);
+                if (iter == m_windowClassMap.end()) {
+                    return false;
+                }
+            }
+            //与运行时添加Class时的解析方式相同
+            AttributeUtil::ParseAttributeList(iter->second, classAttributeList);
+        }
+        attributeList.insert(attributeList.end(), classAttributeList.begin(), classAttributeList.end());
+        ++m_nExpandedCount;
+        return true;
+    }
+
+    /** 判断节点是否为资源节点（不是控件）
+    */
+    static bool IsResourceNode(const DString& nodeName)
+    {
+        return (nodeName == _T("Class")) ||
+               (nodeName == _T("Font")) ||
+               (nodeName == _T("FontFile")) ||
+               (nodeName == _T("FontResource")) ||
+               (nodeName == _T("DefaultFontFamilyNames")) ||
+               (nodeName == _T("TextColor")) ||
+               (nodeName == _T("Image")) ||
+               (nodeName == _T("Include")) ||
+               (nodeName == _T("Event")) ||
+               (nodeName == _T("BubbledEvent"));
+    }
+
+private:
+    /** 全局的Class
+    */
+    const std::map<DString, DString>& m_globalClassMap;
+
+    /** 窗口的Class
+    */
+    const std::map<DString, DString>& m_windowClassMap;
+
+    /** 字符串表（UTF-8编码）
+    */
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringIndex;
+
+    /** 节点数据
+    */
+    std::vector<uint32_t> m_nodeData;
+
+    /** 展开的class属性个数
+    */
+    uint32_t m_nExpandedCount = 0;
+};
+
+/** 加载过程
+*/
+class SkinBinaryReader
+{
+public:
+    SkinBinaryReader(const uint8_t* pNodeData, uint32_t nNodeDataCount):
+        m_pNodeData(pNodeData),
+        m_nNodeDataCount(nNodeDataCount),
+        m_nPos(0)
+    {
+    }
+
+    /** 读取字符串表
+    */
+    bool ReadStrings(const uint8_t* pOffsets, uint32_t nStringCount, const char* pStringData, uint32_t nStringDataSize)
+    {
+        m_strings.resize(nStringCount);
+        m_stringSizes.resize(nStringCount);
+#ifdef DUILIB_UNICODE
+        m_wideStrings.resize(nStringCount);
+#endif
+        for (uint32_t nIndex = 0; nIndex < nStringCount; ++nIndex) {
+            const uint32_t nOffset = ReadUInt32(pOffsets + nIndex * sizeof(uint32_t));
+            if (nOffset >= nStringDataSize) {
+                return false;
+            }
+            //字符串必须以'\0'结尾
+            const char* pStr = pStringData + nOffset;
+            const void* pEnd = ::memchr(pStr, '\0', nStringDataSize - nOffset);
+            if (pEnd == nullptr) {
+                return false;
+            }
+            const size_t nSize = (const char*)pEnd - pStr;
+#ifdef DUILIB_UNICODE
+            m_wideStrings[nIndex] = StringConvert::UTF8ToT(pStr, nSize);
+            m_strings[nIndex] = m_wideStrings[nIndex].c_str();
+            m_stringSizes[nIndex] = m_wideStrings[nIndex].size();
+#else
+            //直接使用文件中的数据，不需要复制
+            m_strings[nIndex] = pStr;
+            m_stringSizes[nIndex] = nSize;
+#endif
+        }
+        return true;
+    }
+
+    /** 读取所有节点
+    */
+    bool ReadNodes(pugi::xml_node parentNode)
+    {
+        while (m_nPos < m_nNodeDataCount) {
+            if (!ReadNode(parentNode, 0)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /** 读取一个节点（含子节点）
+    */
+    bool ReadNode(pugi::xml_node& parentNode, uint32_t nDepth)
+    {
+        uint32_t nType = 0;
+        uint32_t nName = 0;
+        uint32_t nValue = 0;
+        uint32_t nAttrCount = 0;
+        uint32_t nChildCount = 0;
+        if ((nDepth >= kSkinBinaryMaxDepth) ||
+            !ReadValue(nType) || !ReadString(nName) || !ReadString(nValue) ||
+            !ReadValue(nAttrCount) || !ReadValue(nChildCount)) {
+            return false;
+        }
+        pugi::xml_node node;
+        if (nType == kSkinNodeElement) {
+            node = parentNode.append_child(pugi::node_element);
+            node.set_name(m_strings[nName], m_stringSizes[nName]);
+        }
+        else if ((nType == kSkinNodeText) || (nType == kSkinNodeCData)) {
+            node = parentNode.append_child((nType == kSkinNodeText) ? pugi::node_pcdata : pugi::node_cdata);
+            node.set_value(m_strings[nValue], m_stringSizes[nValue]);
+        }
+        else {
+            return false;
+        }
+        for (uint32_t nIndex = 0; nIndex < nAttrCount; ++nIndex) {
+            uint32_t nAttrName = 0;
+            uint32_t nAttrValue = 0;
+            if (!ReadString(nAttrName) || !ReadString(nAttrValue)) {
+                return false;
+            }
+            node.append_attribute(m_strings[nAttrName]).set_value(m_strings[nAttrValue], m_stringSizes[nAttrValue]);
+        }
+        for (uint32_t nIndex = 0; nIndex < nChildCount; ++nIndex) {
+            if (!ReadNode(node, nDepth + 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** 读取一个数值
+    */
+    bool ReadValue(uint32_t& nValue)
+    {
+        if (m_nPos >= m_nNodeDataCount) {
+            return false;
+        }
+        nValue = ReadUInt32(m_pNodeData + (size_t)m_nPos * sizeof(uint32_t));
+        ++m_nPos;
+        return true;
+    }
+
+    /** 读取一个字符串序号
+    */
+    bool ReadString(uint32_t& nIndex)
+    {
+        return ReadValue(nIndex) && (nIndex < m_strings.size());
+    }
+
+private:
+    /** 节点数据
+    */
+    const uint8_t* m_pNodeData;
+    uint32_t m_nNodeDataCount;
+
+    /** 当前读取位置
+    */
+    uint32_t m_nPos;
+
+    /** 字符串表
+    */
+    std::vector<const pugi::char_t*> m_strings;
+    std::vector<size_t> m_stringSizes;
+#ifdef DUILIB_UNICODE
+    std::vector<DString> m_wideStrings;
+#endif
+};
+
+/** 校验文件头
+*/
+static bool ReadHeader(const uint8_t* pData, size_t nDataSize, TSkinBinaryHeader& header)
+{
+    if ((pData == nullptr) || (nDataSize < sizeof(TSkinBinaryHeader))) {
+        return false;
+    }
+    ::memcpy(&header, pData, sizeof(header));
+    if ((header.m_nMagic != kSkinBinaryMagic) ||
+        (header.m_nVersion != SkinBinary::kVersion) ||
+        (header.m_nHeaderSize != sizeof(TSkinBinaryHeader))) {
+        return false;
+    }
+    const uint64_t nTotalSize = (uint64_t)header.m_nHeaderSize +
+                                (uint64_t)header.m_nStringCount * sizeof(uint32_t) +
+                                (uint64_t)header.m_nStringDataSize +
+                                (uint64_t)header.m_nNodeDataCount * sizeof(uint32_t);
+    return nTotalSize == (uint64_t)nDataSize;
+}
+
+FilePath SkinBinary::GetCompiledFilePath(const FilePath& xmlFilePath)
+{
+    return FilePath(xmlFilePath.ToString() + _T(".skb"));
+}
+
+bool SkinBinary::ReadClasses(const std::vector<uint8_t>& xmlData, std::map<DString, DString>& classMap)
+{
+    pugi::xml_document xmlDoc;
+    if (!LoadXmlDocument(xmlData, xmlDoc)) {
+        return false;
+    }
+    ReadClassNodes(xmlDoc.root().first_child(), classMap);
+    return true;
+}
+
+bool SkinBinary::Compile(const std::vector<uint8_t>& xmlData,
+                         const std::map<DString, DString>& globalClassMap,
+                         std::vector<uint8_t>& binData)
+{
+    binData.clear();
+    pugi::xml_document xmlDoc;
+    if (!LoadXmlDocument(xmlData, xmlDoc)) {
+        return false;
+    }
+    pugi::xml_node root = xmlDoc.root().first_child();
+    if (root.empty() || (xmlData.size() > UINT32_MAX)) {
+        return false;
+    }
+
+    //窗口的Class：窗口创建控件前，先添加本文件中定义的Class；没有全局Class时，不展开class属性
+    std::map<DString, DString> windowClassMap;
+    if (!globalClassMap.empty() && (StringUtil::StringCompare(root.name(), _T("Window")) == 0)) {
+        ReadClassNodes(root, windowClassMap);
+    }
+    SkinBinaryWriter writer(globalClassMap, windowClassMap);
+    for (pugi::xml_node node : xmlDoc.root().children()) {
+        //根节点不是控件，根节点的子节点才是控件
+        if (node.type() == pugi::node_element) {
+            writer.WriteNode(node, false, 0);
+        }
+    }
+    writer.GetData(xmlData, binData);
+    return true;
+}
+
+bool SkinBinary::Load(const uint8_t* pData, size_t nDataSize, uint64_t nClassHash, pugi::xml_document& xmlDoc)
+{
+    xmlDoc.reset();
+    TSkinBinaryHeader header;
+    if (!ReadHeader(pData, nDataSize, header)) {
+        return false;
+    }
+    if ((header.m_nFlags & kSkinBinaryFlagClassExpanded) && (header.m_nClassHash != nClassHash)) {
+        //编译时展开class属性使用的全局Class与当前的不一致（比如global.xml修改后未重新编译）
+        return false;
+    }
+    const uint8_t* pOffsets = pData + header.m_nHeaderSize;
+    const char* pStringData = (const char*)(pOffsets + (size_t)header.m_nStringCount * sizeof(uint32_t));
+    const uint8_t* pNodeData = (const uint8_t*)pStringData + header.m_nStringDataSize;
+
+    SkinBinaryReader reader(pNodeData, header.m_nNodeDataCount);
+    if (!reader.ReadStrings(pOffsets, header.m_nStringCount, pStringData, header.m_nStringDataSize) ||
+        !reader.ReadNodes(xmlDoc)) {
+        xmlDoc.reset();
+        return false;
+    }
+    return !xmlDoc.root().first_child().empty();
+}
+
+uint64_t SkinBinary::GetClassHash(const std::map<DString, DString>& globalClassMap)
+{
+    std::vector<uint8_t> classData;
+    for (const auto& iter : globalClassMap) {
+        const std::string className = StringConvert::TToUTF8(iter.first);
+        const std::string classValue = StringConvert::TToUTF8(iter.second);
+        classData.insert(classData.end(), className.begin(), className.end());
+        classData.push_back('\0');
+        classData.insert(classData.end(), classValue.begin(), classValue.end());
+        classData.push_back('\0');
+    }
+    return GetSourceHash(classData.data(), classData.size());
+}
+
+bool SkinBinary::IsUpToDate(const uint8_t* pData, size_t nDataSize, const uint8_t* pXmlData, size_t nXmlDataSize)
+{
+    TSkinBinaryHeader header;
+    if (!ReadHeader(pData, nDataSize, header)) {
+        return false;
+    }
+    //先比较文件长度（代价很小，XML文件修改后长度通常会变化），长度一致时再比较哈希值
+    if (header.m_nSourceSize != nXmlDataSize) {
+        return false;
+    }
+    return header.m_nSourceHash == GetSourceHash(pXmlData, nXmlDataSize);
+}
+
+} // namespace ui
@@ -0,0 +1,76 @@
+#ifndef UI_CORE_SKIN_BINARY_H_
+#define UI_CORE_SKIN_BINARY_H_
+
+#include "duilib/Utils/FilePath.h"
+#include <map>
+#include <vector>
+
+namespace pugi
+{
+    //XML 解析器相关定义
+    class xml_document;
+    class xml_node;
+}
+
+namespace ui
+{
+/** 编译后的皮肤文件（二进制格式）
+*   由皮肤编译工具（tools/skin_compiler）将XML文件离线编译生成，XML文件仍然是皮肤的源文件，修改XML文件后需要重新编译；
+*   编译时：所有字符串（节点名、属性名、属性值）存入字符串表并去重，节点和属性只记录字符串的序号；
+*          控件的class属性展开为Class中定义的属性列表（仅展开能在global.xml或者本文件中找到定义的Class）；
+*   加载时：校验文件头、版本号和展开class属性时使用的全局Class，直接由二进制数据构建XML文档对象，不需要解析XML文本；
+*          校验失败时由调用方改为加载XML文件
+*/
+class UILIB_API SkinBinary
+{
+public:
+    /** 当前的文件格式版本号，格式有变化时需要增加版本号（加载时版本号不一致的文件视为无效）
+    */
+    static constexpr uint32_t kVersion = 2;
+
+    /** 获取XML文件对应的编译后文件路径（XML文件名 + ".skb"，比如："main.xml" 编译后为 "main.xml.skb"）
+    */
+    static FilePath GetCompiledFilePath(const FilePath& xmlFilePath);
+
+    /** 读取XML文件中定义的Class（根节点下的Class节点），用于编译时展开控件的class属性
+    * @param [in] xmlData XML文件的数据
+    * @param [out] classMap 返回Class的名称和属性列表（格式与运行时的Class属性列表相同）
+    */
+    static bool ReadClasses(const std::vector<uint8_t>& xmlData, std::map<DString, DString>& classMap);
+
+    /** 编译XML文件
+    * @param [in] xmlData XML文件的数据
+    * @param [in] globalClassMap 全局的Class（global.xml中定义的Class），为空时不展开控件的class属性
+    * @param [out] binData 返回编译后的数据
+    */
+    static bool Compile(const std::vector<uint8_t>& xmlData,
+                        const std::map<DString, DString>& globalClassMap,
+                        std::vector<uint8_t>& binData);
+
+    /** 加载编译后的数据，构建XML文档对象
+    * @param [in] pData 编译后的数据
+    * @param [in] nDataSize 数据长度
+    * @param [in] nClassHash 当前全局Class的哈希值（GetClassHash函数的返回值），如果编译时展开了class属性，必须与编译时一致
+    * @param [out] xmlDoc 返回XML文档对象
+    * @return 文件头或者版本号校验失败、全局Class不一致、数据不完整时返回false
+    */
+    static bool Load(const uint8_t* pData, size_t nDataSize, uint64_t nClassHash, pugi::xml_document& xmlDoc);
+
+    /** 计算全局Class的哈希值（按UTF-8编码计算，与平台无关）
+    * @param [in] globalClassMap 全局的Class
+    */
+    static uint64_t GetClassHash(const std::map<DString, DString>& globalClassMap);
+
+    /** 判断编译后的数据是否与XML文件一致（XML文件修改后，需要重新编译）
+    * @param [in] pData 编译后的数据
+    * @param [in] nDataSize 数据长度
+    * @param [in] pXmlData XML文件的数据
+    * @param [in] nXmlDataSize XML文件的数据长度
+    * @return 先比较XML文件的长度，再比较XML文件数据的哈希值，均一致时返回true
+    */
+    static bool IsUpToDate(const uint8_t* pData, size_t nDataSize, const uint8_t* pXmlData, size_t nXmlDataSize);
+};
+
+} // namespace ui
+
+#endif // UI_CORE_SKIN_BINARY_H_
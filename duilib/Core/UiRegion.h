@@ -0,0 +1,182 @@
+#ifndef UI_CORE_UIREGION_H_
+#define UI_CORE_UIREGION_H_
+
+#include "duilib/Core/UiRect.h"
+#include <vector>
+
+namespace ui
+{
+/** 由多个矩形组成的区域（用于记录窗口需要重绘的区域）
+*   矩形个数有上限，添加矩形时按照"合并后浪费的面积最少"的原则合并相近的矩形，
+*   避免两个相距较远的小区域（比如窗口一角的光标和另一角的进度条）合并成一个接近整个窗口的大矩形
+*/
+class UILIB_API UiRegion
+{
+public:
+    /** 默认的矩形个数上限
+    */
+    static constexpr size_t kDefaultMaxRects = 8;
+
+    UiRegion():
+        m_nMaxRects(kDefaultMaxRects)
+    {
+    }
+
+    /** 清空区域
+    */
+    void Clear()
+    {
+        m_rects.clear();
+    }
+
+    /** 判断是否为空区域
+    */
+    bool IsEmpty() const
+    {
+        return m_rects.empty();
+    }
+
+    /** 获取区域包含的矩形（矩形之间可能有重叠）
+    */
+    const std::vector<UiRect>& GetRects() const
+    {
+        return m_rects;
+    }
+
+    /** 获取区域的外接矩形
+    */
+    UiRect GetBounds() const
+    {
+        UiRect rcBounds;
+        for (const UiRect& rc : m_rects) {
+            rcBounds.Union(rc);
+        }
+        return rcBounds;
+    }
+
+    /** 设置矩形个数的上限（最小值为1，为1时等同于取所有矩形的并集）
+    */
+    void SetMaxRects(size_t nMaxRects)
+    {
+        m_nMaxRects = (nMaxRects > 0) ? nMaxRects : 1;
+        while (m_rects.size() > m_nMaxRects) {
+            MergeClosestRects();
+        }
+    }
+
+    /** 添加一个矩形（取并集）
+    */
+    void Union(const UiRect& rc)
+    {
+        if (rc.IsEmpty()) {
+            return;
+        }
+        UiRect rcNew = rc;
+        bool bMerged = true;
+        while (bMerged) {
+            bMerged = false;
+            for (size_t nIndex = 0; nIndex < m_rects.size(); ++nIndex) {
+                const UiRect& rcItem = m_rects[nIndex];
+                if (rcItem.ContainsRect(rcNew)) {
+                    //已经包含在区域中
+                    return;
+                }
+                if (rcNew.ContainsRect(rcItem) || IsMergeCheap(rcItem, rcNew)) {
+                    //合并后再次检查，合并后的矩形可能与其他矩形也满足合并条件
+                    rcNew.Union(rcItem);
+                    m_rects.erase(m_rects.begin() + nIndex);
+                    bMerged = true;
+                    break;
+                }
+            }
+        }
+        m_rects.push_back(rcNew);
+        while (m_rects.size() > m_nMaxRects) {
+            MergeClosestRects();
+        }
+    }
+
+    /** 添加另外一个区域（取并集）
+    */
+    void Union(const UiRegion& r)
+    {
+        for (const UiRect& rc : r.m_rects) {
+            Union(rc);
+        }
+    }
+
+    /** 与一个矩形取交集（比如限制在窗口客户区范围内）
+    */
+    void Intersect(const UiRect& rc)
+    {
+        std::vector<UiRect> rects;
+        rects.swap(m_rects);
+        for (UiRect rcItem : rects) {
+            if (rcItem.Intersect(rc)) {
+                m_rects.push_back(rcItem);
+            }
+        }
+    }
+
+private:
+    /** 获取矩形的面积
+    */
+    static int64_t GetArea(const UiRect& rc)
+    {
+        return rc.IsEmpty() ? 0 : (int64_t)rc.Width() * rc.Height();
+    }
+
+    /** 计算两个矩形合并后，浪费的面积（合并后矩形的面积 - 两个矩形的面积之和）
+    */
+    static int64_t GetMergeCost(const UiRect& a, const UiRect& b)
+    {
+        UiRect rcUnion = a;
+        rcUnion.Union(b);
+        return GetArea(rcUnion) - GetArea(a) - GetArea(b);
+    }
+
+    /** 判断两个矩形是否值得直接合并：合并后浪费的面积不超过两个矩形面积之和的1/4
+    */
+    static bool IsMergeCheap(const UiRect& a, const UiRect& b)
+    {
+        return GetMergeCost(a, b) * 4 <= (GetArea(a) + GetArea(b));
+    }
+
+    /** 矩形个数超过上限时，合并浪费面积最少的两个矩形
+    */
+    void MergeClosestRects()
+    {
+        const size_t nCount = m_rects.size();
+        if (nCount < 2) {
+            return;
+        }
+        size_t nFirst = 0;
+        size_t nSecond = 1;
+        int64_t nMinCost = INT64_MAX;
+        for (size_t i = 0; i < nCount; ++i) {
+            for (size_t j = i + 1; j < nCount; ++j) {
+                int64_t nCost = GetMergeCost(m_rects[i], m_rects[j]);
+                if (nCost < nMinCost) {
+                    nMinCost = nCost;
+                    nFirst = i;
+                    nSecond = j;
+                }
+            }
+        }
+        m_rects[nFirst].Union(m_rects[nSecond]);
+        m_rects.erase(m_rects.begin() + nSecond);
+    }
+
+private:
+    /** 区域包含的矩形
+    */
+    std::vector<UiRect> m_rects;
+
+    /** 矩形个数的上限
+    */
+    size_t m_nMaxRects;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_UIREGION_H_
@@ -24,6 +24,9 @@ Window::Window() :
     m_bIsArranged(false),
     m_bPostQuitMsgWhenClosed(false),
     m_renderBackendType(RenderBackendType::kRaster_BackendType),
+    m_nParallelPaintThreads(0),
+    m_bPrefetchImages(false),
+    m_bFirstPaint(true),
     m_bWindowAttributesApplied(false)
 {
     m_toolTip = std::make_unique<ToolTip>();
@@ -95,6 +98,27 @@ RenderBackendType Window::GetRenderBackendType() const
     return backendType;
 }
 
+void Window::SetParallelPaintThreads(int32_t nThreadCount)
+{
+    ASSERT(nThreadCount >= 0);
+    m_nParallelPaintThreads = std::max(nThreadCount, 0);
+}
+
+int32_t Window::GetParallelPaintThreads() const
+{
+    return m_nParallelPaintThreads;
+}
+
+void Window::SetPrefetchImages(bool bPrefetchImages)
+{
+    m_bPrefetchImages = bPrefetchImages;
+}
+
+bool Window::IsPrefetchImages() const
+{
+    return m_bPrefetchImages;
+}
+
 bool Window::SetWindowIcon(const DString& iconFilePath)
 {
     if (iconFilePath.empty()) {
@@ -381,6 +405,7 @@ bool Window::AttachBox(Box* pRoot)
     // Go ahead...
     m_bIsArranged = true;
     m_bFirstLayout = true;
+    m_bFirstPaint = true;
     // Initiate all control
     return InitControls(m_pRoot);
 }
@@ -450,6 +475,9 @@ void Window::AddClass(const DString& strClassName, const DString& strControlAttr
     }
 #endif
     m_defaultAttrHash[strClassName] = strControlAttrList;
+    std::shared_ptr<AttributeList> pAttributeList = std::make_shared<AttributeList>();
+    AttributeUtil::ParseAttributeList(strControlAttrList, *pAttributeList);
+    m_classAttributes[strClassName] = pAttributeList;
 }
 
 DString Window::GetClassAttributes(const DString& strClassName) const
@@ -461,8 +489,18 @@ DString Window::GetClassAttributes(const DString& strClassName) const
     return _T("");
 }
 
+std::shared_ptr<const AttributeList> Window::GetClassAttributeList(const DString& strClassName) const
+{
+    auto it = m_classAttributes.find(strClassName);
+    if (it != m_classAttributes.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
 bool Window::RemoveClass(const DString& strClassName)
 {
+    m_classAttributes.erase(strClassName);
     auto it = m_defaultAttrHash.find(strClassName);
     if (it != m_defaultAttrHash.end()) {
         m_defaultAttrHash.erase(it);
@@ -474,6 +512,7 @@ bool Window::RemoveClass(const DString& strClassName)
 void Window::RemoveAllClass()
 {
     m_defaultAttrHash.clear();
+    m_classAttributes.clear();
 }
 
 void Window::AddTextColor(const DString& strName, const DString& strValue)
@@ -667,6 +706,15 @@ void Window::InvalidateAll()
     Invalidate(rcClient);
 }
 
+bool Window::ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    if ((m_renderOffset.x != 0) || (m_renderOffset.y != 0)) {
+        //有绘制偏移时（动画过程中），绘制的坐标与窗口的坐标不一致
+        return false;
+    }
+    return WindowBase::ScrollWindowRect(rcScroll, dx, dy);
+}
+
 void Window::OnWindowAlphaChanged()
 {
     InvalidateAll();
@@ -1024,6 +1072,10 @@ LRESULT Window::OnPaintMsg(const UiRect& rcPaint, const NativeMsg& /*nativeMsg*/
     return 0;
 }
 
+/** 使用分块并行绘制的最小绘制面积（像素），面积较小时，录制和线程调度的开销超过并行带来的收益
+*/
+static constexpr int64_t kMinParallelPaintArea = 256 * 256;
+
 bool Window::Paint(const UiRect& rcPaint)
 {
     GlobalManager::Instance().AssertUIThread();
@@ -1038,13 +1090,31 @@ bool Window::Paint(const UiRect& rcPaint)
         pRender->ClearAlpha(rcPaint);
     }
 
+    //首次绘制的耗时（图片的同步加载通常集中在首次绘制中，可用于评估预加载图片的效果）
+    std::unique_ptr<PerformanceStat> pFirstPaintStat;
+    if (m_bFirstPaint) {
+        m_bFirstPaint = false;
+        pFirstPaintStat = std::make_unique<PerformanceStat>(_T("PaintWindow, Window::Paint(FirstPaint)"));
+    }
+
     // 绘制    
     if (m_pRoot->IsVisible()) {
-        AutoClip rectClip(pRender, rcPaint, true);
-        UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
-        m_pRoot->Paint(pRender, rcPaint);
-        m_pRoot->PaintChild(pRender, rcPaint);
-        pRender->SetWindowOrg(ptOldWindOrg);
+        auto paintRoot = [this, &rcPaint](IRender* pPaintRender) {
+                AutoClip rectClip(pPaintRender, rcPaint, true);
+                UiPoint ptOldWindOrg = pPaintRender->OffsetWindowOrg(m_renderOffset);
+                m_pRoot->Paint(pPaintRender, rcPaint);
+                m_pRoot->PaintChild(pPaintRender, rcPaint);
+                pPaintRender->SetWindowOrg(ptOldWindOrg);
+            };
+        //大面积重绘时，分块并行绘制；如果不支持（比如控件直接读写像素数据），按普通方式绘制
+        bool bPainted = false;
+        if ((m_nParallelPaintThreads > 1) && ((int64_t)rcPaint.Width() * rcPaint.Height() >= kMinParallelPaintArea)) {
+            PerformanceStat statPerformance(_T("PaintWindow, Window::Paint(Parallel)"));
+            bPainted = pRender->PaintParallel(rcPaint, m_nParallelPaintThreads, paintRoot);
+        }
+        if (!bPainted) {
+            paintRoot(pRender);
+        }
     }
     else {
         UiColor bkColor = UiColor(UiColors::LightGray);
@@ -7,6 +7,7 @@
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/Delegate.h"
 #include "duilib/Utils/FilePath.h"
+#include "duilib/Utils/AttributeUtil.h"
 
 namespace ui
 {
@@ -100,6 +101,26 @@ public:
     */
     RenderBackendType GetRenderBackendType() const;
 
+    /** 设置分块并行绘制使用的线程数（CPU绘制时，用于加速大面积的重绘，比如调整窗口大小、DPI变化、切换主题等）
+    *   开启后，大面积重绘时先在UI线程中录制绘制过程，然后分块在多个线程中并行回放；小面积重绘仍按普通方式绘制
+    * @param [in] nThreadCount 参与绘制的线程数（含UI线程），0或者1表示不使用并行绘制（默认值），超过CPU核数时按CPU核数计算
+    */
+    void SetParallelPaintThreads(int32_t nThreadCount);
+
+    /** 获取分块并行绘制使用的线程数
+    */
+    int32_t GetParallelPaintThreads() const;
+
+    /** 设置是否预加载图片：根据XML创建控件时，在工作线程中并行加载控件的背景图片和状态图片（含Class中设置的图片），
+    *   布局与图片加载同时进行，首次绘制时图片可以直接从缓存中获取，默认为false
+    *   （首次绘制的耗时，可对比性能统计项"PaintWindow, Window::Paint(FirstPaint)"）
+    */
+    void SetPrefetchImages(bool bPrefetchImages);
+
+    /** 获取是否预加载图片
+    */
+    bool IsPrefetchImages() const;
+
     /** 设置窗口图标（支持*.ico格式）
     *  @param [in] iconFilePath ico文件的路径（在资源根目录内的相对路径）
     */
@@ -195,6 +216,14 @@ public:
     */
     void InvalidateAll();
 
+    /** 滚动窗口中指定区域的内容：移动已经绘制的像素，只重绘移动后空出的区域
+    * @param [in] rcScroll 滚动的区域，为客户区坐标
+    * @param [in] dx X轴方向移动的距离，正数向右移动，负数向左移动
+    * @param [in] dy Y轴方向移动的距离，正数向下移动，负数向上移动
+    * @return 成功返回true；如果不支持或者不满足条件返回false，此时需要调用者重绘整个区域
+    */
+    virtual bool ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
+
     /** @} */
 
 public:
@@ -285,6 +314,12 @@ public:
     */
     DString GetClassAttributes(const DString& strClassName) const;
 
+    /** 获取指定通用样式解析后的属性列表（添加通用样式时已经解析，应用时不需要重复解析）
+    * @param [in] strClassName 通用样式名称
+    * @return 返回解析后的属性列表（不可修改），如果不存在该通用样式，返回nullptr
+    */
+    std::shared_ptr<const AttributeList> GetClassAttributeList(const DString& strClassName) const;
+
     /** 删除一个通用样式
     * @param [in] strClassName 要删除的通用样式名称
     */
@@ -918,6 +953,10 @@ private:
     */
     std::map<DString, DString> m_defaultAttrHash;
 
+    /** 窗口配置中class名称与解析后的属性列表映射关系
+    */
+    std::unordered_map<DString, std::shared_ptr<const AttributeList>> m_classAttributes;
+
     /** 窗口颜色字符串与颜色值（ARGB）的映射关系
     */
     ColorMap m_colorMap;
@@ -938,6 +977,18 @@ private:
     */
     RenderBackendType m_renderBackendType;
 
+    /** 分块并行绘制使用的线程数（0或者1表示不使用并行绘制）
+    */
+    int32_t m_nParallelPaintThreads;
+
+    /** 是否预加载图片
+    */
+    bool m_bPrefetchImages;
+
+    /** 是否为窗口的首次绘制
+    */
+    bool m_bFirstPaint;
+
     /** 窗口的初始大小
     */
     UiSize m_szInitSize;
@@ -565,6 +565,9 @@ void WindowBase::OnDpiScaleChanged(uint32_t nOldDpiScale, uint32_t nNewDpiScale)
     m_rcSizeBox = Dpi().GetScaleRect(m_rcSizeBox, nOldDpiScale);
     m_szRoundCorner = Dpi().GetScaleSize(m_szRoundCorner, nOldDpiScale);
     m_rcCaption = Dpi().GetScaleRect(m_rcCaption, nOldDpiScale);
+
+    //文本排版结果的缓存无需清除：缓存的关键字包含按DPI缩放后的字体大小和区域大小，
+    //不同DPI的排版结果不会混用（其他窗口的DPI可能没有变化，仍然可以使用原来的缓存）
 }
 
 bool WindowBase::SetWindowRoundRectRgn(const UiRect& rcWnd, const UiSize& szRoundCorner, bool bRedraw)
@@ -583,6 +586,12 @@ void WindowBase::Invalidate(const UiRect& rcItem)
     m_pNativeWindow->Invalidate(rcItem);
 }
 
+bool WindowBase::ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    GlobalManager::Instance().AssertUIThread();
+    return m_pNativeWindow->ScrollWindowRect(rcScroll, dx, dy);
+}
+
 bool WindowBase::UpdateWindow() const
 {
     return m_pNativeWindow->UpdateWindow();
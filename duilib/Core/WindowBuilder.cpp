@@ -6,6 +6,7 @@
 #include "duilib/Core/ControlDragable.h"
 #include "duilib/Core/ScrollBar.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/SkinBinary.h"
 
 #include "duilib/Control/TreeView.h"
 #include "duilib/Control/Combo.h"
@@ -46,6 +47,9 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/ThreadPool.h"
+#include "duilib/Utils/MemoryMappedFile.h"
+#include "duilib/Utils/PerformanceUtil.h"
 
 #include "duilib/third_party/xml/pugixml.hpp"
 
@@ -203,12 +207,24 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath)
     if (xmlFilePath.IsEmpty()) {
         return false;
     }
+    if (GlobalManager::Instance().IsUseCompiledSkin() && ParseCompiledSkinFile(xmlFilePath)) {
+        m_xmlFilePath = xmlFilePath;
+        return true;
+    }
     bool isLoaded = false;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
         FilePath sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
+        //未压缩的文件直接从压缩包的内存中解析（load_buffer会复制数据），避免多复制一次
+        const uint8_t* pFileData = nullptr;
+        size_t nFileDataSize = 0;
         std::vector<unsigned char> file_data;
-        if (GlobalManager::Instance().Zip().GetZipData(sFile, file_data)) {
-            pugi::xml_parse_result result = m_xml->load_buffer(file_data.data(), file_data.size());
+        if (!GlobalManager::Instance().Zip().GetZipDataSpan(sFile, pFileData, nFileDataSize) &&
+            GlobalManager::Instance().Zip().GetZipData(sFile, file_data)) {
+            pFileData = file_data.data();
+            nFileDataSize = file_data.size();
+        }
+        if ((pFileData != nullptr) && (nFileDataSize > 0)) {
+            pugi::xml_parse_result result = m_xml->load_buffer(pFileData, nFileDataSize);
             if (result.status != pugi::status_ok) {
                 ASSERT(!_T("WindowBuilder::Create load xml from zip data failed!"));
                 return false;
@@ -239,6 +255,70 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath)
     return true;
 }
 
+bool WindowBuilder::ParseCompiledSkinFile(const FilePath& xmlFilePath)
+{
+    PerformanceStat statPerformance(_T("WindowBuilder::ParseCompiledSkinFile"));
+    const FilePath skinFilePath = SkinBinary::GetCompiledFilePath(xmlFilePath);
+    bool isLoaded = false;
+    //校验编译后的文件与XML文件是否一致（先比较长度，再比较哈希值），避免修改XML文件后未重新编译，
+    //不一致时返回false，由调用方改为加载XML文件；XML文件不存在时（只发布了编译后的文件），直接使用编译后的文件
+    if (GlobalManager::Instance().Zip().IsUseZip()) {
+        ZipManager& zipManager = GlobalManager::Instance().Zip();
+        const FilePath& resPath = GlobalManager::Instance().GetResourcePath();
+        FilePath sFile = FilePathUtil::JoinFilePath(resPath, skinFilePath);
+        const uint8_t* pFileData = nullptr;
+        size_t nFileDataSize = 0;
+        std::vector<unsigned char> fileData;
+        if (!zipManager.GetZipDataSpan(sFile, pFileData, nFileDataSize) && zipManager.GetZipData(sFile, fileData)) {
+            pFileData = fileData.data();
+            nFileDataSize = fileData.size();
+        }
+        if (pFileData != nullptr) {
+            FilePath xmlFile = FilePathUtil::JoinFilePath(resPath, xmlFilePath);
+            const uint8_t* pXmlData = nullptr;
+            size_t nXmlDataSize = 0;
+            std::vector<unsigned char> xmlFileData;
+            if (!zipManager.GetZipDataSpan(xmlFile, pXmlData, nXmlDataSize) && zipManager.GetZipData(xmlFile, xmlFileData)) {
+                pXmlData = xmlFileData.data();
+                nXmlDataSize = xmlFileData.size();
+            }
+            if ((pXmlData != nullptr) && !SkinBinary::IsUpToDate(pFileData, nFileDataSize, pXmlData, nXmlDataSize)) {
+                ASSERT(!_T("WindowBuilder: compiled skin file is out of date!"));
+                pFileData = nullptr;
+            }
+        }
+        if (pFileData != nullptr) {
+            isLoaded = SkinBinary::Load(pFileData, nFileDataSize, GlobalManager::Instance().GetClassHash(), *m_xml);
+        }
+    }
+    else {
+        FilePath xmlFileFullPath = xmlFilePath;
+        if (xmlFilePath.IsRelativePath()) {
+            xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
+        }
+        //编译后的文件映射到内存，直接由映射的数据构建XML文档
+        MemoryMappedFile mappedFile;
+        if (mappedFile.Open(SkinBinary::GetCompiledFilePath(xmlFileFullPath))) {
+            isLoaded = true;
+            //XML文件也映射到内存，避免复制文件数据
+            MemoryMappedFile xmlMappedFile;
+            if (xmlMappedFile.Open(xmlFileFullPath) &&
+                !SkinBinary::IsUpToDate(mappedFile.GetData(), mappedFile.GetSize(), xmlMappedFile.GetData(), xmlMappedFile.GetSize())) {
+                ASSERT(!_T("WindowBuilder: compiled skin file is out of date!"));
+                isLoaded = false;
+            }
+            if (isLoaded) {
+                isLoaded = SkinBinary::Load(mappedFile.GetData(), mappedFile.GetSize(),
+                                            GlobalManager::Instance().GetClassHash(), *m_xml);
+            }
+        }
+    }
+    if (!isLoaded) {
+        m_xml->reset();
+    }
+    return isLoaded;
+}
+
 Control* WindowBuilder::CreateControls(CreateControlCallback pCallback, Window* pWindow, Box* pParent, Box* pUserDefinedBox)
 {
     m_createControlCallback = pCallback;
@@ -552,6 +632,22 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
                 pWindow->SetLayeredWindow(strValue == _T("true"), false);
             }
         }
+        else if (strName == _T("parallel_paint")) {
+            //设置分块并行绘制使用的线程数（"true"表示使用所有CPU核）
+            if (strValue == _T("true")) {
+                pWindow->SetParallelPaintThreads((int32_t)ThreadPool::Instance().GetMaxThreadCount());
+            }
+            else if (strValue == _T("false")) {
+                pWindow->SetParallelPaintThreads(0);
+            }
+            else {
+                pWindow->SetParallelPaintThreads(StringUtil::StringToInt32(strValue));
+            }
+        }
+        else if (strName == _T("prefetch_images")) {
+            //设置是否预加载图片（创建控件时，在工作线程中并行加载控件的图片）
+            pWindow->SetPrefetchImages(strValue == _T("true"));
+        }
         else if (strName == _T("alpha")) {
             //设置窗口的透明度（0 - 255），仅当使用层窗口时有效，在在UpdateLayeredWindow函数中作为参数使用
             int32_t nAlpha = StringUtil::StringToInt32(strValue);
@@ -942,6 +1038,10 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
                 ++i;
                 pControl->SetAttribute(attr.name(), attr.value());
             }
+            if ((pWindow != nullptr) && pWindow->IsPrefetchImages()) {
+                //属性（含Class中的属性）设置完成后，控件的图片已经确定，开始预加载，与后续的控件创建和布局并行执行
+                pControl->PrefetchImages();
+            }
         }
 
         if (strClass == DUI_CTR_RICHTEXT) {
@@ -123,6 +123,12 @@ private:
     */
     bool IsXmlFileExists(const FilePath& xmlFilePath) const;
 
+    /** 加载XML文件对应的编译后的皮肤文件（见SkinBinary）
+    * @param [in] xmlFilePath XML文件的路径
+    * @return 编译后的文件不存在或者校验失败时返回false
+    */
+    bool ParseCompiledSkinFile(const FilePath& xmlFilePath);
+
     /** 解析字体节点
     */
     void ParseFontXmlNode(const pugi::xml_node& xmlNode) const;
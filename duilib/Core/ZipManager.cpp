@@ -4,18 +4,37 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/MemoryMappedFile.h"
 
 #include "duilib/third_party/zlib/zlib.h"
 #include "duilib/third_party/zlib/contrib/minizip/unzip.h"
 
+#include <climits>
+
 namespace ui 
 {
 /** 压缩包内的路径，最大长度
 */
 #define MAX_PATH_LEN (size_t)(1024)
 
+/** 句柄池中保留的空闲解压句柄个数上限
+*/
+static constexpr size_t kMaxFreeZipHandles = 8;
+
+ZipManager::TZipHandle::~TZipHandle()
+{
+    if (m_hzip != nullptr) {
+        ::unzClose(m_hzip);
+        m_hzip = nullptr;
+    }
+    m_pStreamIO.reset();
+}
+
 ZipManager::ZipManager():
-    m_hzip(nullptr)
+    m_bZipOpened(false),
+    m_pZipData(nullptr),
+    m_nZipDataSize(0)
 {
 }
 
@@ -27,7 +46,8 @@ ZipManager::~ZipManager()
 
 bool ZipManager::IsUseZip() const
 {
-    return m_hzip != nullptr;
+    std::shared_lock<std::shared_mutex> lock(m_zipMutex);
+    return m_bZipOpened;
 }
 
 #ifdef DUILIB_BUILD_FOR_WIN
@@ -45,190 +65,311 @@ bool ZipManager::OpenResZip(HMODULE hModule, LPCTSTR resourceName, LPCTSTR resou
     if ((pData == nullptr) || (nDataSize == 0)) {
         return false;
     }
-    CloseResZip();
+    std::unique_lock<std::shared_mutex> lock(m_zipMutex);
+    CloseZip();
     m_password = password;
-    m_pZipStreamIO = std::make_unique<ZipStreamIO>(pData, nDataSize);
-    zlib_filefunc_def pzlib_filefunc_def;
-    m_pZipStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
-    m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
-    return m_hzip != nullptr;
+    //资源数据已经在内存中，所有解压句柄直接读取资源数据
+    m_pZipData = pData;
+    m_nZipDataSize = nDataSize;
+    return InitZip();
 }
 #endif
 
 bool ZipManager::OpenZipFile(const FilePath& path, const DString& password)
 {
-    CloseResZip();
-    DStringA nativePath = path.NativePathA();
-    if (nativePath.empty()) {
+    std::unique_lock<std::shared_mutex> lock(m_zipMutex);
+    CloseZip();
+    if (path.IsEmpty()) {
         return false;
     }
     m_password = password;
-    m_hzip = ::unzOpen(nativePath.c_str());
-    return m_hzip != nullptr;
+    m_zipFilePath = path;
+    //将压缩包文件映射到内存，所有解压句柄共享同一份数据；如果无法映射（或者文件超过2GB），每个解压句柄各自打开文件读取
+    m_pMappedFile = std::make_unique<MemoryMappedFile>();
+    if (m_pMappedFile->Open(path) && (m_pMappedFile->GetSize() <= (size_t)INT32_MAX)) {
+        m_pZipData = m_pMappedFile->GetData();
+        m_nZipDataSize = m_pMappedFile->GetSize();
+    }
+    else {
+        m_pMappedFile.reset();
+    }
+    return InitZip();
 }
 
-bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const
+bool ZipManager::InitZip()
 {
-    fileData.clear();
-    GlobalManager::Instance().AssertUIThread();
-    ASSERT(m_hzip != nullptr);
-    if (m_hzip == nullptr) {
+    std::unique_ptr<TZipHandle> pZipHandle = CreateZipHandle();
+    if (pZipHandle == nullptr) {
+        CloseZip();
         return false;
     }
-    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
-    std::string filePathA;
-    if (!LocateFile(normalizePath, filePathA)) {
-        return false;
+    BuildZipFileIndex(pZipHandle->m_hzip);
+    ReleaseZipHandle(pZipHandle);
+    m_bZipOpened = true;
+    return true;
+}
+
+std::unique_ptr<ZipManager::TZipHandle> ZipManager::CreateZipHandle() const
+{
+    std::unique_ptr<TZipHandle> pZipHandle = std::make_unique<TZipHandle>();
+    if (m_pZipData != nullptr) {
+        //每个解压句柄使用独立的内存流（各自记录读取位置）
+        pZipHandle->m_pStreamIO = std::make_unique<ZipStreamIO>(m_pZipData, (uint32_t)m_nZipDataSize);
+        zlib_filefunc_def pzlib_filefunc_def;
+        pZipHandle->m_pStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
+        pZipHandle->m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
     }
+    else {
+        DStringA nativePath = m_zipFilePath.NativePathA();
+        if (!nativePath.empty()) {
+            pZipHandle->m_hzip = ::unzOpen(nativePath.c_str());
+        }
+    }
+    if (pZipHandle->m_hzip == nullptr) {
+        return nullptr;
+    }
+    return pZipHandle;
+}
 
-    size_t fileNameLen = std::max(filePathA.size() + 1, MAX_PATH_LEN);
-    std::vector<char> szFileName;
-    szFileName.resize(fileNameLen, 0);
-    unz_file_info file_info = {0, };
-    int nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
-    if (nRet != UNZ_OK) {
+std::unique_ptr<ZipManager::TZipHandle> ZipManager::AcquireZipHandle() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_handleMutex);
+        if (!m_freeHandles.empty()) {
+            std::unique_ptr<TZipHandle> pZipHandle = std::move(m_freeHandles.back());
+            m_freeHandles.pop_back();
+            return pZipHandle;
+        }
+    }
+    //没有空闲的句柄（其他线程正在读取），创建新的句柄
+    PerformanceUtil::Instance().AddCounter(_T("ZipManager::CreateZipHandle"));
+    return CreateZipHandle();
+}
+
+void ZipManager::ReleaseZipHandle(std::unique_ptr<TZipHandle>& pZipHandle) const
+{
+    if (pZipHandle == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_handleMutex);
+    if (m_freeHandles.size() < kMaxFreeZipHandles) {
+        m_freeHandles.push_back(std::move(pZipHandle));
+    }
+    pZipHandle.reset();
+}
+
+bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const
+{
+    fileData.clear();
+    std::shared_lock<std::shared_mutex> lock(m_zipMutex);
+    ASSERT(m_bZipOpened);
+    if (!m_bZipOpened) {
         return false;
     }
-    
-    if (file_info.uncompressed_size == 0) {
+    const TZipFileEntry* pFileEntry = FindFileEntry(path);
+    if ((pFileEntry == nullptr) || (pFileEntry->m_nUncompressedSize == 0)) {
         return false;
     }
 
-    //文件是否加密
-    bool bFileEncrypted = file_info.flag & 1;
-
-    nRet = ::unzStringFileNameCompare(szFileName.data(), filePathA.c_str(), 0);
-    ASSERT(nRet == 0);
-    if (nRet != 0) {
+    //解压句柄记录了当前定位的文件，每个读取线程使用独立的解压句柄，多个线程可以同时读取
+    std::unique_ptr<TZipHandle> pZipHandle = AcquireZipHandle();
+    if (pZipHandle == nullptr) {
         return false;
     }
-    if (!m_password.empty() && bFileEncrypted) {
-        //密码是本地编码的（ANSI）
-        std::string password;
+    void* hzip = pZipHandle->m_hzip;
+    const uint8_t* pStoredData = nullptr;
+    if (GetStoredData(hzip, *pFileEntry, pStoredData)) {
+        //未压缩的文件，直接从内存中复制，不需要经过解压流程
+        fileData.assign(pStoredData, pStoredData + pFileEntry->m_nUncompressedSize);
+        ReleaseZipHandle(pZipHandle);
+        return true;
+    }
+
+    //通过索引中记录的位置直接定位文件
+    unz64_file_pos filePos;
+    filePos.pos_in_zip_directory = pFileEntry->m_nPosInZipDirectory;
+    filePos.num_of_file = pFileEntry->m_nNumOfFile;
+    int nRet = ::unzGoToFilePos64(hzip, &filePos);
+    if (nRet == UNZ_OK) {
+        if (!m_password.empty() && pFileEntry->m_bEncrypted) {
+            //密码是本地编码的（ANSI）
+            std::string password;
 #ifdef DUILIB_BUILD_FOR_WIN
     #ifdef DUILIB_UNICODE
-        password = StringConvert::UnicodeToMBCS(m_password);
+            password = StringConvert::UnicodeToMBCS(m_password);
     #else
-        password = m_password;
+            password = m_password;
     #endif
 #else
-        password = StringConvert::TToUTF8(m_password);
+            password = StringConvert::TToUTF8(m_password);
 #endif
-        nRet = ::unzOpenCurrentFilePassword(m_hzip, password.c_str());
+            nRet = ::unzOpenCurrentFilePassword(hzip, password.c_str());
+        }
+        else {
+            nRet = ::unzOpenCurrentFile(hzip);
+        }
     }
-    else {
-        nRet = ::unzOpenCurrentFile(m_hzip);
+    if (nRet == UNZ_OK) {
+        fileData.resize((size_t)pFileEntry->m_nUncompressedSize);
+        nRet = ::unzReadCurrentFile(hzip, &fileData[0], (uLong)fileData.size());
+        ::unzCloseCurrentFile(hzip);
+        ASSERT(nRet == (int)fileData.size());
+        if (nRet != (int)fileData.size()) {
+            fileData.clear();
+        }
     }
-    if (nRet != UNZ_OK) {
+    ReleaseZipHandle(pZipHandle);
+    return !fileData.empty();
+}
+
+bool ZipManager::GetZipDataSpan(const FilePath& path, const uint8_t*& pData, size_t& nDataSize) const
+{
+    pData = nullptr;
+    nDataSize = 0;
+    std::shared_lock<std::shared_mutex> lock(m_zipMutex);
+    if (!m_bZipOpened || (m_pZipData == nullptr)) {
+        return false;
+    }
+    const TZipFileEntry* pFileEntry = FindFileEntry(path);
+    if ((pFileEntry == nullptr) || (pFileEntry->m_nUncompressedSize == 0)) {
+        return false;
+    }
+    std::unique_ptr<TZipHandle> pZipHandle = AcquireZipHandle();
+    if (pZipHandle == nullptr) {
         return false;
     }
+    if (GetStoredData(pZipHandle->m_hzip, *pFileEntry, pData)) {
+        nDataSize = (size_t)pFileEntry->m_nUncompressedSize;
+    }
+    ReleaseZipHandle(pZipHandle);
+    return pData != nullptr;
+}
 
-    fileData.resize(file_info.uncompressed_size);
-    nRet = ::unzReadCurrentFile(m_hzip, &fileData[0], (uLong)fileData.size());
-    ::unzCloseCurrentFile(m_hzip);
-    ASSERT(nRet == (int)fileData.size());
-    if (nRet != (int)fileData.size()) {
-        fileData.clear();
+bool ZipManager::GetStoredData(void* hzip, const TZipFileEntry& fileEntry, const uint8_t*& pData) const
+{
+    pData = nullptr;
+    if ((m_pZipData == nullptr) || (fileEntry.m_nCompressionMethod != 0) || fileEntry.m_bEncrypted ||
+        (fileEntry.m_nCompressedSize != fileEntry.m_nUncompressedSize)) {
+        //只有在内存中、未压缩并且未加密的文件，才能直接访问数据
+        return false;
+    }
+    unz64_file_pos filePos;
+    filePos.pos_in_zip_directory = fileEntry.m_nPosInZipDirectory;
+    filePos.num_of_file = fileEntry.m_nNumOfFile;
+    if (::unzGoToFilePos64(hzip, &filePos) != UNZ_OK) {
+        return false;
+    }
+    //本地文件头的长度是可变的，打开文件后才能得到文件数据的起始位置
+    if (::unzOpenCurrentFile(hzip) != UNZ_OK) {
         return false;
     }
+    const uint64_t nDataPos = (uint64_t)::unzGetCurrentFileZStreamPos64(hzip);
+    ::unzCloseCurrentFile(hzip);
+    if ((nDataPos == 0) || ((nDataPos + fileEntry.m_nUncompressedSize) > m_nZipDataSize)) {
+        return false;
+    }
+    pData = m_pZipData + nDataPos;
     return true;
 }
 
 bool ZipManager::IsZipResExist(const FilePath& path) const
 {
-    GlobalManager::Instance().AssertUIThread();
-    if ((m_hzip == nullptr) || path.IsEmpty()) {
+    std::shared_lock<std::shared_mutex> lock(m_zipMutex);
+    if (!m_bZipOpened || path.IsEmpty()) {
         return false;
     }
-    if (m_zipPathCache.empty()) {
-        //首次查询时，建立缓存，避免每次都需要遍历整个压缩包的文件（::unzLocateFile函数是采用遍历所有文件的方式实现的，性能比较差）
-        int nRet = ::unzGoToFirstFile(m_hzip);
-        while (nRet == UNZ_OK) {
-            size_t fileNameLen = MAX_PATH_LEN;
-            std::vector<char> szFileName;
-            szFileName.resize(fileNameLen, 0);
-            unz_file_info file_info = { 0, };
-            nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
-            if (nRet == UNZ_OK) {
-                //文件名的编码是否为UTF8格式
-                bool bUtf8 = file_info.flag & (1 << 11);
-                DString fileName = GetZipFilePath(szFileName.data(), bUtf8);
+    return FindFileEntry(path) != nullptr;
+}
 
+void ZipManager::BuildZipFileIndex(void* hzip)
+{
+    //打开压缩包时，遍历一次压缩包的中央目录，建立索引（::unzLocateFile函数是采用遍历所有文件的方式实现的，性能比较差）
+    PerformanceStat statPerformance(_T("ZipManager::BuildZipFileIndex"));
+    m_zipFileIndex.clear();
+    ASSERT(hzip != nullptr);
+    if (hzip == nullptr) {
+        return;
+    }
+    std::vector<char> szFileName;
+    szFileName.resize(MAX_PATH_LEN, 0);
+    int nRet = ::unzGoToFirstFile(hzip);
+    while (nRet == UNZ_OK) {
+        unz_file_info64 file_info = { 0, };
+        nRet = ::unzGetCurrentFileInfo64(hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
+        if (nRet != UNZ_OK) {
+            break;
+        }
+        unz64_file_pos filePos = { 0, };
+        nRet = ::unzGetFilePos64(hzip, &filePos);
+        if (nRet != UNZ_OK) {
+            break;
+        }
+
+        //文件名的编码是否为UTF8格式
+        bool bUtf8 = file_info.flag & (1 << 11);
 #ifdef DUILIB_BUILD_FOR_WIN
-                DStringW innerFilePath = StringConvert::MBCSToUnicode(szFileName.data(), bUtf8 ? CP_UTF8 : CP_ACP);
+        DStringW innerFilePath = StringConvert::MBCSToUnicode(szFileName.data(), bUtf8 ? CP_UTF8 : CP_ACP);
 #else
-                DStringW innerFilePath = StringConvert::UTF8ToWString(szFileName.data());
+        UNUSED_VARIABLE(bUtf8);
+        DStringW innerFilePath = StringConvert::UTF8ToWString(szFileName.data());
 #endif
-                //压缩包内的文件名，都不区分大小写，转换为小写再比较
-                innerFilePath = StringUtil::MakeLowerString(innerFilePath);
-                //加入缓存
-                m_zipPathCache.insert(innerFilePath);
+        //压缩包内的文件名，都不区分大小写，转换为小写再比较
+        innerFilePath = StringUtil::MakeLowerString(innerFilePath);
+        NormalizeZipFilePath(innerFilePath);
 
-                //下一个文件
-                nRet = ::unzGoToNextFile(m_hzip);
-            }
-        }
+        TZipFileEntry fileEntry;
+        fileEntry.m_nPosInZipDirectory = filePos.pos_in_zip_directory;
+        fileEntry.m_nNumOfFile = filePos.num_of_file;
+        fileEntry.m_nCompressedSize = file_info.compressed_size;
+        fileEntry.m_nUncompressedSize = file_info.uncompressed_size;
+        fileEntry.m_nCompressionMethod = (uint32_t)file_info.compression_method;
+        fileEntry.m_bEncrypted = (file_info.flag & 1) != 0;
+        //同名文件以第一个为准（与::unzLocateFile的行为一致）
+        m_zipFileIndex.emplace(innerFilePath, fileEntry);
+
+        //下一个文件
+        nRet = ::unzGoToNextFile(hzip);
     }
+    PerformanceUtil::Instance().AddCounter(_T("ZipManager::BuildZipFileIndex(Files)"), (int64_t)m_zipFileIndex.size());
+}
 
+const ZipManager::TZipFileEntry* ZipManager::FindFileEntry(const FilePath& path) const
+{
     const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
     DStringW innerFilePath = normalizePath.ToStringW();
     innerFilePath = StringUtil::MakeLowerString(innerFilePath);
     NormalizeZipFilePath(innerFilePath);
-    auto it = m_zipPathCache.find(innerFilePath);
-    if (it != m_zipPathCache.end()) {
-        return true;
+    auto iter = m_zipFileIndex.find(innerFilePath);
+    if (iter != m_zipFileIndex.end()) {
+        return &iter->second;
     }
-    return false;
+    return nullptr;
 }
 
-bool ZipManager::LocateFile(const FilePath& normalizePath, std::string& filePathA) const
+void ZipManager::CloseResZip()
 {
-    //压缩包内文件路径的编码是每个文件都不同的，定位的时候无法确定文件名编码，只能依次尝试
-    filePathA = normalizePath.NativePathA();//优先尝试MBCS编码
-    ASSERT(!filePathA.empty());
-    if (filePathA.empty()) {
-        return false;
-    }
-    NormalizeZipFilePath(filePathA);
-    const int iCaseSensitivity = 2; //不区分大小写
-    int nRet = ::unzLocateFile(m_hzip, filePathA.c_str(), iCaseSensitivity);
-    if (nRet == UNZ_OK) {
-        return true;
-    }
-
-    std::string oldFilePathA = filePathA;
-    filePathA = normalizePath.ToStringA();//再尝试UTF8编码
-    ASSERT(!filePathA.empty());
-    if (filePathA.empty()) {
-        return false;
-    }
-    NormalizeZipFilePath(filePathA);
-    if (oldFilePathA == filePathA) {
-        //路径无变化，不再重复查询
-        return false;
-    }
-    nRet = ::unzLocateFile(m_hzip, filePathA.c_str(), iCaseSensitivity);
-    if (nRet == UNZ_OK) {
-        return true;
-    }
-    filePathA.clear();
-    return false;
+    std::unique_lock<std::shared_mutex> lock(m_zipMutex);
+    CloseZip();
 }
 
-void ZipManager::CloseResZip()
+void ZipManager::CloseZip()
 {
-    if (m_hzip != nullptr) {
-        ::unzClose(m_hzip);
-        m_hzip = nullptr;
+    //持有独占锁时没有正在读取的线程，所有解压句柄都已放回句柄池
+    {
+        std::lock_guard<std::mutex> lock(m_handleMutex);
+        m_freeHandles.clear();
     }
-    m_zipPathCache.clear();
-    m_pZipStreamIO.reset();
+    m_bZipOpened = false;
+    m_zipFileIndex.clear();
+    m_pZipData = nullptr;
+    m_nZipDataSize = 0;
+    m_pMappedFile.reset();
+    m_zipFilePath.Clear();
 }
 
 bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& fileList) const
 {
     fileList.clear();
-    GlobalManager::Instance().AssertUIThread();
     DString filePath = dirPath.NativePath();
     if (!filePath.empty() &&
         (filePath[filePath.size() - 1] != _T('\\')) &&
@@ -236,13 +377,20 @@ bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& f
         filePath += _T("/");
     }
     DString innerPath = FilePathUtil::NormalizeFilePath(filePath);
-    if (innerPath.empty() || (m_hzip == nullptr)) {
+    std::shared_lock<std::shared_mutex> lock(m_zipMutex);
+    if (innerPath.empty() || !m_bZipOpened) {
         return false;
     }
     //路径分隔符统一替换成 '/'
     NormalizeZipFilePath(innerPath);
-    int nRet = ::unzGoToFirstFile(m_hzip);
+    std::unique_ptr<TZipHandle> pZipHandle = AcquireZipHandle();
+    if (pZipHandle == nullptr) {
+        return false;
+    }
+    void* hzip = pZipHandle->m_hzip;
+    int nRet = ::unzGoToFirstFile(hzip);
     if (nRet != UNZ_OK) {
+        ReleaseZipHandle(pZipHandle);
         return false;
     }
     DString fileName;
@@ -251,8 +399,9 @@ bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& f
         std::vector<char> szFileName;
         szFileName.resize(fileNameLen, 0);
         unz_file_info file_info = { 0, };
-        nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
+        nRet = ::unzGetCurrentFileInfo(hzip, &file_info, &szFileName[0], (uLong)szFileName.size() - 1, nullptr, 0, nullptr, 0);
         if (nRet != UNZ_OK) {
+            ReleaseZipHandle(pZipHandle);
             return false;
         }
 
@@ -286,8 +435,9 @@ bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& f
         }
 
         //跳到下一个文件
-        nRet = ::unzGoToNextFile(m_hzip);
+        nRet = ::unzGoToNextFile(hzip);
     }
+    ReleaseZipHandle(pZipHandle);
     return true;
 }
 
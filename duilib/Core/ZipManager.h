@@ -4,18 +4,22 @@
 #include "duilib/Utils/FilePath.h"
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 namespace ui 
 {
 class ZipStreamIO;
+class MemoryMappedFile;
 
 /**ZIP压缩包管理器
  * 说明：
  * （1）Zip压缩包支持的压缩算法是：Deflate算法，其他算法均不支持(也不支持Deflate64算法)
  * （2）使用7-Zip做压缩包的时候，如果自定义参数：cu=on，可以制作出文件名编码为UTF-8的压缩包；若不设置，默认文件名编码是本机编码
  * （3）如果设置了密码，需要使用传统的密码加密算法，否则无法解压。（使用"ZIP legacy encryption"模式 或者 "ZipCrypto"算法的密码）
+ * （4）所有接口都可以在多个线程中调用：压缩包只映射到内存一次，每个读取线程使用独立的解压句柄（从句柄池中获取），可以同时读取
  */
 class UILIB_API ZipManager
 {
@@ -53,6 +57,15 @@ public:
      */
     bool GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const;
 
+    /** 获取压缩包中未压缩（存储模式）文件的数据地址，不复制数据
+     * @param [in] path 要获取的文件的路径(压缩包内路径)
+     * @param [out] pData 返回文件数据的起始地址（指向压缩包的内存映射）
+     * @param [out] nDataSize 返回文件数据的长度
+     * @return 只有压缩包在内存中，并且文件未压缩、未加密时返回true；否则返回false，需要使用GetZipData获取
+     *  注：返回的地址在压缩包关闭（或者重新打开）之前有效，调用方需要保证关闭压缩包时没有正在使用的数据
+     */
+    bool GetZipDataSpan(const FilePath& path, const uint8_t*& pData, size_t& nDataSize) const;
+
     /** 判断资源是否存在zip当中
      * @param[in] path 要判断的资源路径(压缩包内路径)
      */
@@ -69,17 +82,82 @@ public:
     void CloseResZip();
 
 private:
+    /** 关闭压缩包（调用方需要持有独占锁）
+    */
+    void CloseZip();
+
+    /** 打开压缩包后的初始化：建立文件索引（调用方需要持有独占锁）
+    */
+    bool InitZip();
+
     /** 对Zip格式的路径进行规范化处理（'\\'替换成'/'）
     */
     void NormalizeZipFilePath(std::string& innerFilePath) const;
     void NormalizeZipFilePath(std::wstring& innerFilePath) const;
 
-    /** 在压缩包中定位文件
-    * @param [in] normalizePath 文件路径
-    * @param [out] filePathA 返回压缩包内的文件路径（MBCS或者UTF8编码）
-    * @return 定位成功返回true，否则返回false
+    /** 压缩包内一个文件的索引信息
+    */
+    struct TZipFileEntry
+    {
+        //文件在中央目录中的位置（对应unz64_file_pos）
+        uint64_t m_nPosInZipDirectory = 0;
+        uint64_t m_nNumOfFile = 0;
+
+        //压缩后的文件大小
+        uint64_t m_nCompressedSize = 0;
+
+        //解压后的文件大小
+        uint64_t m_nUncompressedSize = 0;
+
+        //压缩算法（0表示未压缩）
+        uint32_t m_nCompressionMethod = 0;
+
+        //文件是否加密
+        bool m_bEncrypted = false;
+    };
+
+    /** 一个解压句柄（每个句柄记录各自的当前文件和读取位置，同一时刻只能在一个线程中使用）
+    */
+    struct TZipHandle
+    {
+        //解压句柄
+        void* m_hzip = nullptr;
+
+        //内存流的读取接口（压缩包在内存中时使用）
+        std::unique_ptr<ZipStreamIO> m_pStreamIO;
+
+        ~TZipHandle();
+    };
+
+    /** 创建一个解压句柄（调用方需要持有锁）
     */
-    bool LocateFile(const FilePath& normalizePath, std::string& filePathA) const;
+    std::unique_ptr<TZipHandle> CreateZipHandle() const;
+
+    /** 从句柄池中获取一个解压句柄，如果没有空闲的句柄则创建一个（调用方需要持有共享锁）
+    */
+    std::unique_ptr<TZipHandle> AcquireZipHandle() const;
+
+    /** 将解压句柄放回句柄池（调用方需要持有共享锁）
+    */
+    void ReleaseZipHandle(std::unique_ptr<TZipHandle>& pZipHandle) const;
+
+    /** 获取未压缩文件在内存中的数据地址（调用方需要持有共享锁）
+    * @param [in] hzip 解压句柄
+    * @param [in] fileEntry 文件的索引信息
+    * @param [out] pData 返回文件数据的起始地址
+    */
+    bool GetStoredData(void* hzip, const TZipFileEntry& fileEntry, const uint8_t*& pData) const;
+
+    /** 遍历压缩包的中央目录，建立文件索引（调用方需要持有独占锁）
+    * @param [in] hzip 解压句柄
+    */
+    void BuildZipFileIndex(void* hzip);
+
+    /** 在索引中查找文件（调用方需要持有共享锁）
+    * @param [in] path 文件路径(压缩包内路径)
+    * @return 返回文件的索引信息，如果文件不存在返回nullptr
+    */
+    const TZipFileEntry* FindFileEntry(const FilePath& path) const;
 
     /** 获取压缩包内的路径(转换字符串编码)
     * @param [in] szInZipFilePath 要获取的文件路径(压缩包内路径)
@@ -89,21 +167,45 @@ private:
 
 private:
     
-    /** 打开的压缩包句柄
+    /** 压缩包是否已经打开
     */
-    void* m_hzip;
+    bool m_bZipOpened;
 
     /** 压缩包的解压密码
     */
     DString m_password;
 
-    /** 内存流的读取接口
+    /** 压缩包文件路径（压缩包无法映射到内存时，每个解压句柄各自打开文件）
+    */
+    FilePath m_zipFilePath;
+
+    /** 压缩包文件的内存映射
+    */
+    std::unique_ptr<MemoryMappedFile> m_pMappedFile;
+
+    /** 压缩包在内存中的数据（内存映射或者资源数据），为nullptr表示从文件中读取
+    */
+    const uint8_t* m_pZipData;
+
+    /** 压缩包在内存中的数据长度
+    */
+    size_t m_nZipDataSize;
+
+    /** 空闲的解压句柄
+    */
+    mutable std::vector<std::unique_ptr<TZipHandle>> m_freeHandles;
+
+    /** 句柄池的多线程同步锁
+    */
+    mutable std::mutex m_handleMutex;
+
+    /** 文件索引（Key为压缩包内的文件路径，小写，路径分隔符为'/'），打开压缩包时建立
     */
-    std::unique_ptr<ZipStreamIO> m_pZipStreamIO;
+    std::unordered_map<DStringW, TZipFileEntry> m_zipFileIndex;
 
-    /** 路径缓存
+    /** 压缩包访问的多线程同步锁：打开和关闭压缩包时使用独占锁，读取时使用共享锁
     */
-    mutable std::unordered_set<DStringW> m_zipPathCache;
+    mutable std::shared_mutex m_zipMutex;
 };
 
 }
@@ -2,7 +2,7 @@
 
 namespace ui 
 {
-ZipStreamIO::ZipStreamIO(uint8_t* pData, uint32_t nDataLen):
+ZipStreamIO::ZipStreamIO(const uint8_t* pData, uint32_t nDataLen):
     m_pData(pData),
     m_nDataLen((int32_t)nDataLen),
     m_nCurPos(0)
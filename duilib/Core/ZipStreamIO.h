@@ -15,7 +15,7 @@ public:
     * @param [in] pData 内存数据的起始地址
     * @param [in] nDataLen 内存数据的长度
     */
-    ZipStreamIO(uint8_t* pData, uint32_t nDataLen);
+    ZipStreamIO(const uint8_t* pData, uint32_t nDataLen);
     ~ZipStreamIO();
     ZipStreamIO(const ZipStreamIO&) = delete;
     ZipStreamIO& operator = (const ZipStreamIO&) = delete;
@@ -40,7 +40,7 @@ private:
 private:
     /** 内存数据的起始地址
     */
-    uint8_t* m_pData;
+    const uint8_t* m_pData;
 
     /** 内存数据的长度
     */
@@ -95,6 +95,9 @@ const std::shared_ptr<ImageInfo>& Image::GetImageCache() const
 
 void Image::SetImageCache(const std::shared_ptr<ImageInfo>& imageInfo)
 {
+    if (m_imageCache != imageInfo) {
+        m_pAtlasBitmap.reset();
+    }
     m_imageCache = imageInfo;
 }
 
@@ -102,6 +105,7 @@ void Image::ClearImageCache()
 {
     m_nCurrentFrame = 0;
     m_imageCache.reset();
+    m_pAtlasBitmap.reset();
 }
 
 void Image::SetCurrentFrame(uint32_t nCurrentFrame)
@@ -130,9 +134,47 @@ bool Image::IsMultiFrameImage() const
     return m_imageCache->IsMultiFrameImage();
 }
 
+void Image::SetAtlasBitmap(const std::shared_ptr<IBitmap>& pAtlasBitmap, const UiRect& rcAtlas)
+{
+    ASSERT((pAtlasBitmap == nullptr) || (m_imageCache != nullptr));
+    if (pAtlasBitmap == nullptr) {
+        if (m_pAtlasBitmap != nullptr) {
+            //图片信息中已经没有位图数据，需要重新加载
+            ClearImageCache();
+        }
+        m_rcAtlas.Clear();
+        return;
+    }
+    if (m_imageCache == nullptr) {
+        return;
+    }
+    if (m_imageCache->GetFrameCount() > 0) {
+        //图片数据已经复制到图集位图中：替换为不含位图数据的图片信息，不再保持原图片的引用
+        std::shared_ptr<ImageInfo> pAtlasImageInfo = std::make_shared<ImageInfo>();
+        pAtlasImageInfo->SetImageSize(m_imageCache->GetWidth(), m_imageCache->GetHeight());
+        pAtlasImageInfo->SetBitmapSizeDpiScaled(m_imageCache->IsBitmapSizeDpiScaled());
+        pAtlasImageInfo->SetLoadKey(m_imageCache->GetLoadKey());
+        pAtlasImageInfo->SetLoadDpiScale(m_imageCache->GetLoadDpiScale());
+        pAtlasImageInfo->SetImageKey(m_imageCache->GetImageKey());
+        m_imageCache = pAtlasImageInfo;
+    }
+    m_pAtlasBitmap = pAtlasBitmap;
+    m_rcAtlas = rcAtlas;
+}
+
+IBitmap* Image::GetAtlasBitmap(UiRect& rcAtlas) const
+{
+    if (m_pAtlasBitmap == nullptr) {
+        return nullptr;
+    }
+    rcAtlas = m_rcAtlas;
+    return m_pAtlasBitmap.get();
+}
+
 IBitmap* Image::GetCurrentBitmap() const
 {
-    if (!m_imageCache) {
+    if (!m_imageCache || (m_imageCache->GetFrameCount() == 0)) {
+        //图集中的图片，没有位图数据
         return nullptr;
     }
     if (m_nCurrentFrame < m_imageCache->GetFrameCount()) {
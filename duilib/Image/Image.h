@@ -125,6 +125,20 @@ public:
     */
     IBitmap* GetCurrentBitmap() const;
 
+    /** 设置图片在图集中的位置（参见ImageList::SetAtlasMode），图片信息变化时自动清除
+    *   设置后，图片信息替换为不含位图数据的副本（释放对原图片的引用，原图片的位图在没有其他引用时释放），绘制时只使用图集位图；
+    *   清除后（pAtlasBitmap为nullptr），图片信息也被清除，在下次绘制时重新加载
+    * @param [in] pAtlasBitmap 图片所在的图集位图
+    * @param [in] rcAtlas 图片在图集位图中的区域
+    */
+    void SetAtlasBitmap(const std::shared_ptr<IBitmap>& pAtlasBitmap, const UiRect& rcAtlas);
+
+    /** 获取图片所在的图集位图
+    * @param [out] rcAtlas 图片在图集位图中的区域
+    * @return 如果图片不在图集中，返回nullptr
+    */
+    IBitmap* GetAtlasBitmap(UiRect& rcAtlas) const;
+
     /** @} */
 
 public:
@@ -184,6 +198,14 @@ private:
     /** 图片信息
     */
     std::shared_ptr<ImageInfo> m_imageCache;
+
+    /** 图片所在的图集位图
+    */
+    std::shared_ptr<IBitmap> m_pAtlasBitmap;
+
+    /** 图片在图集位图中的区域
+    */
+    UiRect m_rcAtlas;
 };
 
 } // namespace ui
@@ -0,0 +1,166 @@
+#include "ImageAtlas.h"
+#include "duilib/Image/ImageInfo.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include <cstring>
+
+namespace ui 
+{
+/** 图片之间的间隔（像素）
+*/
+static constexpr int32_t kAtlasPadding = 1;
+
+ImageAtlas::ImageAtlas()
+{
+}
+
+ImageAtlas::~ImageAtlas()
+{
+}
+
+bool ImageAtlas::AddImage(const std::shared_ptr<ImageInfo>& imageInfo,
+                          std::shared_ptr<IBitmap>& pAtlasBitmap,
+                          UiRect& rcAtlas)
+{
+    if ((imageInfo == nullptr) || (imageInfo->GetFrameCount() != 1)) {
+        return false;
+    }
+    DString imageKey = imageInfo->GetImageKey();
+    if (imageKey.empty()) {
+        imageKey = imageInfo->GetLoadKey();
+    }
+    if (imageKey.empty()) {
+        return false;
+    }
+    IBitmap* pBitmap = imageInfo->GetBitmap(0);
+    if (pBitmap == nullptr) {
+        return false;
+    }
+    const int32_t nWidth = (int32_t)pBitmap->GetWidth();
+    const int32_t nHeight = (int32_t)pBitmap->GetHeight();
+    auto iter = m_items.find(imageKey);
+    if ((iter != m_items.end()) &&
+        (iter->second.m_rcAtlas.Width() == nWidth) && (iter->second.m_rcAtlas.Height() == nHeight)) {
+        //同一个图片已经在图集中（图片大小不同时，比如DPI变化后重新加载，重新加入图集）
+        pAtlasBitmap = iter->second.m_pBitmap;
+        rcAtlas = iter->second.m_rcAtlas;
+        return true;
+    }
+    if ((nWidth <= 0) || (nHeight <= 0) || (nWidth > kMaxAtlasImageSize) || (nHeight > kMaxAtlasImageSize)) {
+        return false;
+    }
+
+    //优先放入已有的图集位图中
+    UiRect rcAlloc;
+    TAtlasPage* pPage = nullptr;
+    for (TAtlasPage& page : m_pages) {
+        if (AllocRect(page, nWidth, nHeight, rcAlloc)) {
+            pPage = &page;
+            break;
+        }
+    }
+    if (pPage == nullptr) {
+        TAtlasPage page;
+        if (!CreatePage(page) || !AllocRect(page, nWidth, nHeight, rcAlloc)) {
+            return false;
+        }
+        m_pages.push_back(std::move(page));
+        pPage = &m_pages.back();
+    }
+
+    //复制图片数据到图集位图（按行复制）
+    const uint8_t* pSrcBits = (const uint8_t*)pBitmap->LockPixelBits();
+    uint8_t* pDestBits = (uint8_t*)pPage->m_pBitmap->LockPixelBits();
+    if ((pSrcBits != nullptr) && (pDestBits != nullptr)) {
+        const size_t nSrcRowBytes = (size_t)nWidth * 4;
+        const size_t nDestRowBytes = (size_t)kAtlasPageSize * 4;
+        for (int32_t nRow = 0; nRow < nHeight; ++nRow) {
+            ::memcpy(pDestBits + (size_t)(rcAlloc.top + nRow) * nDestRowBytes + (size_t)rcAlloc.left * 4,
+                     pSrcBits + (size_t)nRow * nSrcRowBytes,
+                     nSrcRowBytes);
+        }
+    }
+    pPage->m_pBitmap->UnLockPixelBits();
+    pBitmap->UnLockPixelBits();
+    if ((pSrcBits == nullptr) || (pDestBits == nullptr)) {
+        return false;
+    }
+
+    TAtlasItem& item = m_items[imageKey];
+    item.m_pBitmap = pPage->m_pBitmap;
+    item.m_rcAtlas = rcAlloc;
+    pAtlasBitmap = item.m_pBitmap;
+    rcAtlas = item.m_rcAtlas;
+    PerformanceUtil::Instance().AddCounter(_T("ImageAtlas::AddImage"));
+    return true;
+}
+
+void ImageAtlas::Clear()
+{
+    m_items.clear();
+    m_pages.clear();
+}
+
+size_t ImageAtlas::GetPageCount() const
+{
+    return m_pages.size();
+}
+
+bool ImageAtlas::AllocRect(TAtlasPage& page, int32_t nWidth, int32_t nHeight, UiRect& rcAlloc)
+{
+    const int32_t nAllocWidth = nWidth + kAtlasPadding;
+    const int32_t nAllocHeight = nHeight + kAtlasPadding;
+    //查找高度合适的行：不低于图片高度，且不超过太多（避免浪费空间）
+    for (TAtlasShelf& shelf : page.m_shelves) {
+        if ((nAllocHeight <= shelf.m_nHeight) &&
+            (nAllocHeight * 4 >= shelf.m_nHeight * 3) &&
+            ((shelf.m_nNextLeft + nAllocWidth) <= kAtlasPageSize)) {
+            rcAlloc = UiRect(shelf.m_nNextLeft, shelf.m_nTop,
+                             shelf.m_nNextLeft + nWidth, shelf.m_nTop + nHeight);
+            shelf.m_nNextLeft += nAllocWidth;
+            return true;
+        }
+    }
+    //新建一行
+    if ((page.m_nNextTop + nAllocHeight) > kAtlasPageSize) {
+        return false;
+    }
+    TAtlasShelf shelf;
+    shelf.m_nTop = page.m_nNextTop;
+    shelf.m_nHeight = nAllocHeight;
+    shelf.m_nNextLeft = nAllocWidth;
+    page.m_nNextTop += nAllocHeight;
+    page.m_shelves.push_back(shelf);
+    rcAlloc = UiRect(0, shelf.m_nTop, nWidth, shelf.m_nTop + nHeight);
+    return true;
+}
+
+bool ImageAtlas::CreatePage(TAtlasPage& page)
+{
+    IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactroy != nullptr);
+    if (pRenderFactroy == nullptr) {
+        return false;
+    }
+    std::shared_ptr<IBitmap> pBitmap(pRenderFactroy->CreateBitmap());
+    ASSERT(pBitmap != nullptr);
+    if ((pBitmap == nullptr) || !pBitmap->Init(kAtlasPageSize, kAtlasPageSize, true, nullptr)) {
+        return false;
+    }
+    //初始化为全透明
+    void* pPixelBits = pBitmap->LockPixelBits();
+    if (pPixelBits != nullptr) {
+        ::memset(pPixelBits, 0, (size_t)kAtlasPageSize * kAtlasPageSize * 4);
+    }
+    pBitmap->UnLockPixelBits();
+    if (pPixelBits == nullptr) {
+        return false;
+    }
+    page.m_pBitmap = pBitmap;
+    page.m_shelves.clear();
+    page.m_nNextTop = 0;
+    PerformanceUtil::Instance().AddCounter(_T("ImageAtlas::CreatePage"));
+    return true;
+}
+
+} // namespace ui
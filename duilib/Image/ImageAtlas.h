@@ -0,0 +1,112 @@
+#ifndef UI_IMAGE_IMAGE_ATLAS_H_
+#define UI_IMAGE_IMAGE_ATLAS_H_
+
+#include "duilib/Core/UiTypes.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ui 
+{
+class ImageInfo;
+class IBitmap;
+
+/** 图集：将多个小图片合并到少量的大位图中（比如列表中大量的图标），绘制时从同一个位图的不同区域绘制，
+*   避免每个小图片各自创建位图和绘制用的图片数据，并减少绘制时切换图片的次数
+*   图集中的图片按行（货架）排列，每个图片周围保留1个像素的透明间隔，避免绘制时采样到相邻的图片
+*/
+class UILIB_API ImageAtlas
+{
+public:
+    ImageAtlas();
+    ~ImageAtlas();
+    ImageAtlas(const ImageAtlas&) = delete;
+    ImageAtlas& operator = (const ImageAtlas&) = delete;
+
+    /** 图集位图的大小（宽度和高度）
+    */
+    static constexpr int32_t kAtlasPageSize = 512;
+
+    /** 可加入图集的图片大小上限（宽度和高度），超过此大小的图片不加入图集
+    */
+    static constexpr int32_t kMaxAtlasImageSize = 128;
+
+    /** 将图片加入图集（只支持单帧图片）
+    * @param [in] imageInfo 图片数据（图集按图片的KEY记录，不保持该图片的引用，复制到图集位图后原图片可以释放）
+    * @param [out] pAtlasBitmap 图片所在的图集位图
+    * @param [out] rcAtlas 图片在图集位图中的区域
+    * @return 如果图片不支持加入图集（多帧图片、图片太大等），返回false
+    */
+    bool AddImage(const std::shared_ptr<ImageInfo>& imageInfo,
+                  std::shared_ptr<IBitmap>& pAtlasBitmap,
+                  UiRect& rcAtlas);
+
+    /** 清空图集（已经分配出去的图集位图，在使用方释放后销毁）
+    */
+    void Clear();
+
+    /** 获取图集位图的个数
+    */
+    size_t GetPageCount() const;
+
+private:
+    /** 图集位图中的一行（货架）
+    */
+    struct TAtlasShelf
+    {
+        //起始的纵坐标
+        int32_t m_nTop = 0;
+
+        //行的高度
+        int32_t m_nHeight = 0;
+
+        //下一个图片的横坐标
+        int32_t m_nNextLeft = 0;
+    };
+
+    /** 一个图集位图
+    */
+    struct TAtlasPage
+    {
+        //位图
+        std::shared_ptr<IBitmap> m_pBitmap;
+
+        //已经分配的行
+        std::vector<TAtlasShelf> m_shelves;
+
+        //下一个行的起始纵坐标
+        int32_t m_nNextTop = 0;
+    };
+
+    /** 一个加入图集的图片
+    */
+    struct TAtlasItem
+    {
+        //所在的图集位图
+        std::shared_ptr<IBitmap> m_pBitmap;
+
+        //在图集位图中的区域
+        UiRect m_rcAtlas;
+    };
+
+    /** 在图集位图中分配一个区域（含间隔）
+    */
+    static bool AllocRect(TAtlasPage& page, int32_t nWidth, int32_t nHeight, UiRect& rcAlloc);
+
+    /** 创建一个新的图集位图
+    */
+    static bool CreatePage(TAtlasPage& page);
+
+private:
+    /** 图集位图
+    */
+    std::vector<TAtlasPage> m_pages;
+
+    /** 已经加入图集的图片（KEY为图片的KEY）
+    */
+    std::unordered_map<DString, TAtlasItem> m_items;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_IMAGE_ATLAS_H_
@@ -1,8 +1,14 @@
 #include "ImageDecoder.h"
 #include "duilib/Image/Image.h"
+#include "duilib/Image/ImageDiskCache.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
 #include "duilib/Utils/StringUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string_view>
 
 #include "duilib/third_party/apng/decoder-apng.h"
 
@@ -42,6 +48,8 @@
 #include "duilib/third_party/libwebp/src/webp/demux.h"
 
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/PixelUtil.h"
+#include "duilib/Utils/ThreadPool.h"
 
 namespace ui 
 {
@@ -140,29 +148,13 @@ namespace STBImageLoader
         if (((channels_in_file == 3) || (channels_in_file == 4)) && 
             (nWidth > 0) && (nHeight > 0)) {
             argbData.resize((size_t)nHeight * nWidth * desired_channels);
-            const size_t colorCount = (size_t)nHeight * nWidth;
 
-            //数据格式转换：ABGR[alpha, blue, green, red] -> ARGB[alpha, red, green, blue]                
-            for (size_t i = 0; i < colorCount; ++i) {
-                size_t colorIndex = i * 4;
-                if (channels_in_file == 4) {
-                    argbData[colorIndex + 3] = rgbaData[colorIndex + 3]; //A, alpha
-                }
-                else {
-                    argbData[colorIndex + 3] = 255; //A, alpha
-                }
-#ifdef DUILIB_BUILD_FOR_WIN
-                //数据格式：Window平台BGRA，其他平台RGBA
-                argbData[colorIndex + 0] = rgbaData[colorIndex + 2]; //B, blue
-                argbData[colorIndex + 1] = rgbaData[colorIndex + 1]; //G, green
-                argbData[colorIndex + 2] = rgbaData[colorIndex + 0]; //R, red
-#else
-                argbData[colorIndex + 0] = rgbaData[colorIndex + 0]; //R, red
-                argbData[colorIndex + 1] = rgbaData[colorIndex + 1]; //G, green
-                argbData[colorIndex + 2] = rgbaData[colorIndex + 2]; //B, blue
-#endif
+            //数据格式转换：RGBA -> 位图格式（Window平台BGRA，其他平台RGBA），并做Alpha预乘
+            uint32_t nFlags = PixelUtil::kPixelFromRGBA | PixelUtil::kPixelPremultiply;
+            if (channels_in_file != 4) {
+                nFlags |= PixelUtil::kPixelForceOpaque;
             }
-
+            imageData.bOpaque = PixelUtil::ConvertPixels(rgbaData, argbData.data(), nWidth, nHeight, nFlags);
             imageData.bFlipHeight = true;
             imageData.m_frameInterval = 0;
             imageData.m_imageWidth = nWidth;
@@ -189,36 +181,10 @@ namespace APNGImageLoader
             return false;
         }
 
-        //swap rgba to bgra and do premultiply
-        uint8_t* p = pngData->pdata;
+        const uint8_t* p = pngData->pdata;
         if (p == nullptr) {
             return false;
         }
-        int pixel_count = nWid * nHei * pngData->nFrames;
-        for (int i = 0; i < pixel_count; ++i) {
-            uint8_t a = p[3];
-            uint8_t t = p[0];
-            if (a)
-            {
-#ifdef DUILIB_BUILD_FOR_WIN
-                //数据格式：Window平台BGRA，其他平台RGBA
-                p[0] = (p[2] * a) / 255;
-                p[1] = (p[1] * a) / 255;
-                p[2] = (t * a) / 255;
-#else
-                p[0] = (p[0] * a) / 255;
-                p[1] = (p[1] * a) / 255;
-                p[2] = (p[2] * a) / 255;
-#endif
-            }
-            else
-            {
-                memset(p, 0, 4);
-            }
-            p += 4;
-        }
-
-        p = pngData->pdata;
 
         imageData.resize(pngData->nFrames);
         for (int i = 0; i < pngData->nFrames; ++i) {
@@ -229,7 +195,9 @@ namespace APNGImageLoader
             bitmapData.m_imageWidth = nWid;
             bitmapData.m_imageHeight = nHei;
             bitmapData.m_bitmapData.resize(imageDataSize);
-            ::memcpy(bitmapData.m_bitmapData.data(), p, imageDataSize);
+            //数据格式转换：RGBA -> 位图格式（Window平台BGRA，其他平台RGBA），并做Alpha预乘
+            bitmapData.bOpaque = PixelUtil::ConvertPixels(p, bitmapData.m_bitmapData.data(), nWid, nHei,
+                                                          PixelUtil::kPixelFromRGBA | PixelUtil::kPixelPremultiply);
 
             p += imageDataSize;
         }
@@ -268,6 +236,142 @@ namespace SVGImageLoader
         inline void operator()(NSVGrasterizer* x) const { nsvgDeleteRasterizer(x); }
     };
 
+    /** 解析后的SVG图片缓存：同一个SVG图片按不同的大小或者DPI加载时，不需要重复解析（可在多个线程中同时使用）
+    *   解析后的图片数据在光栅化时是只读的，多个线程可以同时光栅化同一个图片
+    */
+    class SvgImageCache
+    {
+    public:
+        /** 缓存的图片个数上限
+        */
+        static constexpr size_t kMaxSvgImageCount = 32;
+
+        static SvgImageCache& Instance()
+        {
+            static SvgImageCache self;
+            return self;
+        }
+
+        /** 获取解析后的SVG图片，如果不在缓存中，则解析后加入缓存
+        * @param [in] imagePath 图片路径
+        * @param [in] fileData 图片文件的数据，解析过程中内部有增加尾0的写操作
+        */
+        std::shared_ptr<NSVGimage> GetSvgImage(const DString& imagePath, std::vector<uint8_t>& fileData)
+        {
+            //图片文件的内容作为Key的一部分，图片文件修改后不会使用旧的解析结果
+            const size_t nDataHash = std::hash<std::string_view>()(std::string_view((const char*)fileData.data(), fileData.size()));
+            const size_t nDataSize = fileData.size();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto iter = m_svgImages.begin(); iter != m_svgImages.end(); ++iter) {
+                    if ((iter->m_nDataHash == nDataHash) && (iter->m_nDataSize == nDataSize) &&
+                        (iter->m_imagePath == imagePath)) {
+                        //标记为最近使用
+                        m_svgImages.splice(m_svgImages.begin(), m_svgImages, iter);
+                        PerformanceUtil::Instance().AddCounter(_T("SvgImageCache(Hit)"));
+                        return m_svgImages.front().m_svgImage;
+                    }
+                }
+            }
+
+            //在锁外解析（解析比较耗时，不阻塞其他线程）
+            bool hasAppended = false;
+            if (fileData.back() != '\0') {
+                //确保是含尾0的字符串，避免越界访问内存
+                fileData.push_back('\0');
+                hasAppended = true;
+            }
+            char* pData = (char*)fileData.data();
+            PerformanceUtil::Instance().BeginStat(_T("nsvgParse"));
+            std::shared_ptr<NSVGimage> svgImage(nsvgParse(pData, "px", 96.0f), SvgDeleter());//传入"px"时，第三个参数dpi是不起作用的。
+            PerformanceUtil::Instance().EndStat(_T("nsvgParse"));
+            if (hasAppended) {
+                fileData.pop_back();
+            }
+            if (svgImage == nullptr) {
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            TSvgImage item;
+            item.m_imagePath = imagePath;
+            item.m_nDataSize = nDataSize;
+            item.m_nDataHash = nDataHash;
+            item.m_svgImage = svgImage;
+            m_svgImages.push_front(std::move(item));
+            while (m_svgImages.size() > kMaxSvgImageCount) {
+                m_svgImages.pop_back();
+            }
+            return svgImage;
+        }
+
+    private:
+        /** 一个解析后的SVG图片
+        */
+        struct TSvgImage
+        {
+            //图片路径
+            DString m_imagePath;
+
+            //图片文件数据的长度和哈希值
+            size_t m_nDataSize = 0;
+            size_t m_nDataHash = 0;
+
+            //解析后的图片
+            std::shared_ptr<NSVGimage> m_svgImage;
+        };
+
+        /** 多线程同步锁
+        */
+        std::mutex m_mutex;
+
+        /** 缓存的图片（按最近使用排序，最近使用的在前面）
+        */
+        std::list<TSvgImage> m_svgImages;
+    };
+
+    /** 光栅化时，图片大小（像素数）超过此值时，按水平条带分块在多个线程中并行光栅化
+    */
+    static constexpr int32_t kParallelRasterizePixels = 512 * 512;
+
+    /** 并行光栅化时，每个条带的最小高度
+    */
+    static constexpr int32_t kMinRasterizeBandHeight = 64;
+
+    /** 光栅化SVG图片（大图片按水平条带分块并行光栅化，每个条带使用独立的光栅化器）
+    *   注：条带边界附近的抗锯齿边缘，与整体光栅化的结果可能有细微的差异（边的定点数步进误差，肉眼不可见）
+    * @param [in] svg 解析后的SVG图片
+    * @param [in] scale 缩放比
+    * @param [out] pBmpBits 位图数据（RGBA格式，已做Alpha预乘），数据长度为：width*height*4
+    */
+    bool RasterizeImage(NSVGimage* svg, float scale, uint8_t* pBmpBits, int32_t width, int32_t height)
+    {
+        constexpr const int32_t dataSize = 4;
+        const int32_t nStride = width * dataSize;
+        size_t nBandCount = 1;
+        if (((int64_t)width * height) >= kParallelRasterizePixels) {
+            nBandCount = std::min((size_t)(height / kMinRasterizeBandHeight), ThreadPool::Instance().GetMaxThreadCount());
+            nBandCount = std::max(nBandCount, (size_t)1);
+        }
+        std::atomic<bool> bRasterized{ true };
+        ThreadPool::Instance().ParallelFor(nBandCount, nBandCount, [&](size_t nBand) {
+                const int32_t nTop = (int32_t)(height * nBand / nBandCount);
+                const int32_t nBottom = (int32_t)(height * (nBand + 1) / nBandCount);
+                std::unique_ptr<NSVGrasterizer, RasterizerDeleter> rast(nsvgCreateRasterizer());
+                if (!rast) {
+                    bRasterized = false;
+                    return;
+                }
+                //向上平移，使条带的第一行位于目标位图的第一行
+                nsvgRasterize(rast.get(), svg, 0, -(float)nTop, scale,
+                              pBmpBits + (size_t)nTop * nStride, width, nBottom - nTop, nStride);
+            });
+        if (nBandCount > 1) {
+            PerformanceUtil::Instance().AddCounter(_T("SVGImageLoader::RasterizeImage(Parallel)"));
+        }
+        return bRasterized;
+    }
+
     /** 从内存数据加载svg图片
     * @param [in] fileData 图片文件的数据，部分格式加载过程中内部有增加尾0的写操作
     * @param [in] imageLoadAttribute 图片加载属性, 包括图片路径等
@@ -288,19 +392,10 @@ namespace SVGImageLoader
             return false;
         }
         bDpiScaled = false;
-        bool hasAppended = false;
-        if (fileData.back() != '\0') {
-            //确保是含尾0的字符串，避免越界访问内存
-            fileData.push_back('\0');
-            hasAppended = true;
-        }
-        char* pData = (char*)fileData.data();
-        NSVGimage* svgData = nsvgParse(pData, "px", 96.0f);//传入"px"时，第三个参数dpi是不起作用的。
-        if (hasAppended) {
-            fileData.pop_back();
+        std::shared_ptr<NSVGimage> svg = SvgImageCache::Instance().GetSvgImage(imageLoadAttribute.GetImageFullPath(), fileData);
+        if (svg == nullptr) {
+            return false;
         }
-
-        std::unique_ptr<NSVGimage, SvgDeleter> svg((NSVGimage*)svgData);
         int width = (int)svg->width;
         int height = (int)svg->height;
         if (width <= 0 || height <= 0) {
@@ -320,8 +415,7 @@ namespace SVGImageLoader
         float scale = (scaleX > scaleY) ? scaleX : scaleY; //取最大的缩放比
         width = static_cast<int>(width * scale);
         height = static_cast<int>(height * scale);
-        std::unique_ptr<NSVGrasterizer, RasterizerDeleter> rast(nsvgCreateRasterizer());        
-        if ((width <= 0) || (height <= 0) || !rast) {
+        if ((width <= 0) || (height <= 0)) {
             return false;
         }
 
@@ -332,23 +426,13 @@ namespace SVGImageLoader
         if (pBmpBits == nullptr) {
             return false;
         }
-        nsvgRasterize(rast.get(), svg.get(), 0, 0, scale, pBmpBits, width, height, width * dataSize);
+        if (!RasterizeImage(svg.get(), scale, pBmpBits, width, height)) {
+            return false;
+        }
 
-#ifdef DUILIB_BUILD_FOR_WIN
         //数据格式：Window平台BGRA，其他平台RGBA
-        // nanosvg内部已经做过alpha预乘，这里只做R和B的交换
-        for (int y = 0; y < height; ++y) {
-            unsigned char* row = &pBmpBits[y * width * dataSize];
-            for (int x = 0; x < width; ++x) {
-                //SVG    数据的各个颜色值：row[0]:R, row[1]: G, row[2]: B, row[3]: A
-                //输出    数据的各个颜色值：row[0]:B, row[1]: G, row[2]: R, row[3]: A
-                unsigned char r = row[0];
-                row[0] = row[2];
-                row[2] = r;
-                row += 4;
-            }
-        }
-#endif
+        //nanosvg内部已经做过alpha预乘，这里只做R和B的交换（原地转换）
+        imageData.bOpaque = PixelUtil::ConvertPixels(pBmpBits, pBmpBits, width, height, PixelUtil::kPixelFromRGBA);
 
         imageData.m_frameInterval = 0;
         imageData.bFlipHeight = true;
@@ -431,8 +515,10 @@ namespace CxImageLoader
             int32_t lPx = 0;
             int32_t lPy = 0;
             ImageDecoder::ImageData& bitmapData = imageData[index];
-            bitmapData.m_bitmapData.resize((size_t)nHeight * nWidth * 4);
-            RGBQUAD* pBit = (RGBQUAD*)bitmapData.m_bitmapData.data();
+            //读取的像素数据为BGRA格式（未做Alpha预乘），行顺序是从下到上的
+            std::vector<uint8_t> frameData;
+            frameData.resize((size_t)nHeight * nWidth * 4);
+            RGBQUAD* pBit = (RGBQUAD*)frameData.data();
             for (lPy = 0; lPy < (int32_t)nHeight; ++lPy) {
                 for (lPx = 0; lPx < (int32_t)nWidth; ++lPx) {
                     *pBit = cxFrame->GetPixelColor(lPx, lPy, true);
@@ -460,28 +546,20 @@ namespace CxImageLoader
                             }
                         }                                                                
                         pBit->rgbReserved = a;
-
-                        if ((a > 0) && (a < 255)) {
-                            pBit->rgbRed = pBit->rgbRed * a / 255;
-                            pBit->rgbGreen = pBit->rgbGreen * a / 255;
-                            pBit->rgbBlue = pBit->rgbBlue * a / 255;
-                        }
                     }
-#ifdef DUILIB_BUILD_FOR_WIN
-                    //数据格式：Window平台BGRA，其他平台RGBA
-#else
-                    //其他平台，交换R和B值
-                    uint8_t r = pBit->rgbRed;
-                    pBit->rgbRed = pBit->rgbBlue;
-                    pBit->rgbBlue = r;
-#endif
                     ++pBit;
                 }
             }
+            //数据格式转换：BGRA -> 位图格式（Window平台BGRA，其他平台RGBA），并做Alpha预乘和垂直翻转
+            bitmapData.m_bitmapData.resize(frameData.size());
+            bitmapData.bOpaque = PixelUtil::ConvertPixels(frameData.data(), bitmapData.m_bitmapData.data(), nWidth, nHeight,
+                                                          PixelUtil::kPixelFromBGRA |
+                                                          PixelUtil::kPixelPremultiply |
+                                                          PixelUtil::kPixelFlipVertical);
             bitmapData.m_frameInterval = frameDelay * 10;
             bitmapData.m_imageWidth = nWidth;
             bitmapData.m_imageHeight = nHeight;
-            bitmapData.bFlipHeight = false;
+            bitmapData.bFlipHeight = true;
         }
 
         if (isIconFile) {
@@ -528,7 +606,87 @@ namespace CxImageLoader
 */
 namespace WebPImageLoader
 {
-    bool LoadImageFromMemory(std::vector<uint8_t>& fileData, std::vector<ImageDecoder::ImageData>& imageData, int32_t& playCount)
+    /** 读取图片的宽度和高度（不解码图片数据）
+    * @param [out] bAnimation 是否为动画
+    */
+    bool GetImageSize(const std::vector<uint8_t>& fileData, uint32_t& nWidth, uint32_t& nHeight, bool& bAnimation)
+    {
+        WebPBitstreamFeatures features;
+        if (WebPGetFeatures(fileData.data(), fileData.size(), &features) != VP8_STATUS_OK) {
+            return false;
+        }
+        if ((features.width <= 0) || (features.height <= 0)) {
+            return false;
+        }
+        nWidth = (uint32_t)features.width;
+        nHeight = (uint32_t)features.height;
+        bAnimation = features.has_animation != 0;
+        return true;
+    }
+
+    /** 从内存数据加载动画的所有帧（每帧都是合成后的完整画布，由WebPAnimDecoder处理帧的dispose和blend方式）
+    */
+    bool LoadAnimationFromMemory(const std::vector<uint8_t>& fileData, std::vector<ImageDecoder::ImageData>& imageData, int32_t& playCount)
+    {
+        imageData.clear();
+        playCount = 0;
+        WebPBitstreamFeatures features;
+        if (WebPGetFeatures(fileData.data(), fileData.size(), &features) != VP8_STATUS_OK) {
+            return false;
+        }
+        WebPAnimDecoderOptions options;
+        if (!WebPAnimDecoderOptionsInit(&options)) {
+            return false;
+        }
+#ifdef DUILIB_BUILD_FOR_WIN
+        //数据格式：Window平台BGRA，其他平台RGBA（Alpha预乘）
+        options.color_mode = MODE_bgrA;
+#else
+        options.color_mode = MODE_rgbA;
+#endif
+        WebPData wd = { fileData.data() , fileData.size() };
+        WebPAnimDecoder* decoder = WebPAnimDecoderNew(&wd, &options);
+        if (decoder == nullptr) {
+            return false;
+        }
+        WebPAnimInfo animInfo;
+        if (!WebPAnimDecoderGetInfo(decoder, &animInfo) || (animInfo.frame_count == 0)) {
+            WebPAnimDecoderDelete(decoder);
+            return false;
+        }
+        const uint32_t width = animInfo.canvas_width;
+        const uint32_t hight = animInfo.canvas_height;
+        const size_t dataSize = (size_t)width * hight * 4;
+        imageData.reserve(animInfo.frame_count);
+        int nLastTimestamp = 0;
+        while (WebPAnimDecoderHasMoreFrames(decoder)) {
+            uint8_t* pCanvas = nullptr;
+            int nTimestamp = 0;
+            if (!WebPAnimDecoderGetNext(decoder, &pCanvas, &nTimestamp) || (pCanvas == nullptr)) {
+                imageData.clear();
+                break;
+            }
+            imageData.emplace_back();
+            ImageDecoder::ImageData& bitmapData = imageData.back();
+            bitmapData.m_bitmapData.assign(pCanvas, pCanvas + dataSize);
+            bitmapData.m_imageWidth = width;
+            bitmapData.m_imageHeight = hight;
+            bitmapData.bOpaque = (features.has_alpha == 0);
+            //时间戳为该帧结束时的时间
+            bitmapData.m_frameInterval = (uint32_t)std::max(nTimestamp - nLastTimestamp, 0);
+            nLastTimestamp = nTimestamp;
+        }
+        WebPAnimDecoderDelete(decoder);
+        playCount = (int32_t)animInfo.loop_count;
+        return !imageData.empty();
+    }
+
+    /** 从内存数据加载图片
+    * @param [in] nDecodeWidth 解码后的宽度，为0表示按原图大小解码（仅对单帧图片有效，解码时直接缩放，不需要先解码原图）
+    * @param [in] nDecodeHeight 解码后的高度，为0表示按原图大小解码
+    */
+    bool LoadImageFromMemory(std::vector<uint8_t>& fileData, std::vector<ImageDecoder::ImageData>& imageData, int32_t& playCount,
+                             uint32_t nDecodeWidth, uint32_t nDecodeHeight)
     {
         ASSERT(!fileData.empty());
         if (fileData.empty()) {
@@ -547,8 +705,14 @@ namespace WebPImageLoader
         //uint32_t backGroundColor = WebPDemuxGetI(demuxer, WEBP_FF_BACKGROUND_COLOR);
         uint32_t frameCount = WebPDemuxGetI(demuxer, WEBP_FF_FRAME_COUNT);
         if (frameCount == 0) {
+            WebPDemuxDelete(demuxer);
             return false;
         }
+        if (frameCount > 1) {
+            //动画：每帧需要基于前一帧的画布合成
+            WebPDemuxDelete(demuxer);
+            return LoadAnimationFromMemory(fileData, imageData, playCount);
+        }
 
         imageData.resize(frameCount);
 
@@ -562,29 +726,55 @@ namespace WebPImageLoader
                 WebPDemuxReleaseIterator(&iter);
                 break;
             }
-            int width = 0;
-            int hight = 0;
-            uint8_t* decode_data = nullptr;
-#ifdef DUILIB_BUILD_FOR_WIN
-            //数据格式：Window平台BGRA，其他平台RGBA
-            decode_data = WebPDecodeBGRA(iter.fragment.bytes, iter.fragment.size, &width, &hight);
-#else
-            decode_data = WebPDecodeRGBA(iter.fragment.bytes, iter.fragment.size, &width, &hight);
-#endif
-            
-            ASSERT((decode_data != nullptr) && (width > 0) && (hight > 0));
-            if ((decode_data == nullptr) || (width <= 0) || (hight <= 0)) {
+            WebPDecoderConfig config;
+            if (!WebPInitDecoderConfig(&config)) {
+                imageData.clear();
+                WebPDemuxReleaseIterator(&iter);
+                break;
+            }
+            int width = iter.width;
+            int hight = iter.height;
+            if ((nDecodeWidth > 0) && (nDecodeHeight > 0)) {
+                //解码时直接缩放到目标大小
+                config.options.use_scaling = 1;
+                config.options.scaled_width = (int)nDecodeWidth;
+                config.options.scaled_height = (int)nDecodeHeight;
+                width = (int)nDecodeWidth;
+                hight = (int)nDecodeHeight;
+            }
+            ASSERT((width > 0) && (hight > 0));
+            if ((width <= 0) || (hight <= 0)) {
                 imageData.clear();
                 WebPDemuxReleaseIterator(&iter);
                 break;
             }
+
+            //直接解码到位图数据中，避免内存复制
             ImageDecoder::ImageData& bitmapData = imageData[(size_t)frame_idx - 1];
             const size_t dataSize = (size_t)width * hight * 4;
             bitmapData.m_bitmapData.resize(dataSize);
-            ::memcpy(bitmapData.m_bitmapData.data(), decode_data, dataSize);
+#ifdef DUILIB_BUILD_FOR_WIN
+            //数据格式：Window平台BGRA，其他平台RGBA（Alpha预乘）
+            config.output.colorspace = MODE_bgrA;
+#else
+            config.output.colorspace = MODE_rgbA;
+#endif
+            config.output.is_external_memory = 1;
+            config.output.u.RGBA.rgba = bitmapData.m_bitmapData.data();
+            config.output.u.RGBA.stride = width * 4;
+            config.output.u.RGBA.size = dataSize;
+            VP8StatusCode status = WebPDecode(iter.fragment.bytes, iter.fragment.size, &config);
+            WebPFreeDecBuffer(&config.output);
+            ASSERT(status == VP8_STATUS_OK);
+            if (status != VP8_STATUS_OK) {
+                imageData.clear();
+                WebPDemuxReleaseIterator(&iter);
+                break;
+            }
             bitmapData.m_imageWidth = width;
             bitmapData.m_imageHeight = hight;
             bitmapData.m_frameInterval = iter.duration;
+            bitmapData.bOpaque = (iter.has_alpha == 0);
 
             WebPDemuxReleaseIterator(&iter);
         }
@@ -594,6 +784,247 @@ namespace WebPImageLoader
     }
 }
 
+/** 按需解码WebP动画的图片帧
+*/
+namespace WebPImageLoader
+{
+    /** 获取动画的帧数
+    */
+    uint32_t GetFrameCount(const std::vector<uint8_t>& fileData)
+    {
+        WebPData wd = { fileData.data() , fileData.size() };
+        WebPDemuxer* demuxer = WebPDemux(&wd);
+        if (demuxer == nullptr) {
+            return 0;
+        }
+        uint32_t frameCount = WebPDemuxGetI(demuxer, WEBP_FF_FRAME_COUNT);
+        WebPDemuxDelete(demuxer);
+        return frameCount;
+    }
+
+    /** WebP动画的图片帧数据源：保留压缩的图片数据，播放时按需解码，只缓存最近使用的几帧
+    *   动画的每一帧基于前一帧的画布合成（由WebPAnimDecoder处理帧的dispose和blend方式），所以按顺序解码，
+    *   正常播放时每次只需解码一帧；需要的帧在已解码位置之前时，从第一帧开始重新解码
+    */
+    class WebPFrameSource: public IImageFrameSource
+    {
+    public:
+        /** 缓存的图片帧个数
+        */
+        static constexpr size_t kCachedFrameCount = 3;
+
+        WebPFrameSource():
+            m_pDecoder(nullptr),
+            m_nFrameCount(0),
+            m_nNextFrame(0),
+            m_nCanvasWidth(0),
+            m_nCanvasHeight(0),
+            m_nWidth(0),
+            m_nHeight(0),
+            m_nLoopCount(0)
+        {
+        }
+
+        virtual ~WebPFrameSource() override
+        {
+            m_cachedFrames.clear();
+            if (m_pDecoder != nullptr) {
+                WebPAnimDecoderDelete(m_pDecoder);
+                m_pDecoder = nullptr;
+            }
+        }
+
+        WebPFrameSource(const WebPFrameSource&) = delete;
+        WebPFrameSource& operator = (const WebPFrameSource&) = delete;
+
+        /** 初始化
+        * @param [in] fileData 图片文件数据（内部保存一份，解码时使用）
+        * @param [in] nWidth 图片帧的目标宽度（与画布大小不同时，解码后缩放）
+        * @param [in] nHeight 图片帧的目标高度
+        */
+        bool Init(const std::vector<uint8_t>& fileData, uint32_t nWidth, uint32_t nHeight)
+        {
+            ASSERT(m_pDecoder == nullptr);
+            ASSERT((nWidth > 0) && (nHeight > 0));
+            if ((m_pDecoder != nullptr) || fileData.empty() || (nWidth == 0) || (nHeight == 0)) {
+                return false;
+            }
+            m_fileData = fileData;
+            WebPAnimDecoderOptions options;
+            if (!WebPAnimDecoderOptionsInit(&options)) {
+                return false;
+            }
+#ifdef DUILIB_BUILD_FOR_WIN
+            //数据格式：Window平台BGRA，其他平台RGBA（Alpha预乘）
+            options.color_mode = MODE_bgrA;
+#else
+            options.color_mode = MODE_rgbA;
+#endif
+            options.use_threads = 0;
+            WebPData wd = { m_fileData.data() , m_fileData.size() };
+            m_pDecoder = WebPAnimDecoderNew(&wd, &options);
+            if (m_pDecoder == nullptr) {
+                return false;
+            }
+            WebPAnimInfo animInfo;
+            if (!WebPAnimDecoderGetInfo(m_pDecoder, &animInfo) ||
+                (animInfo.frame_count == 0) || (animInfo.canvas_width == 0) || (animInfo.canvas_height == 0)) {
+                return false;
+            }
+            m_nFrameCount = animInfo.frame_count;
+            m_nCanvasWidth = animInfo.canvas_width;
+            m_nCanvasHeight = animInfo.canvas_height;
+            m_nLoopCount = animInfo.loop_count;
+            m_nWidth = nWidth;
+            m_nHeight = nHeight;
+
+            //读取每帧的播放时间间隔（不需要解码）
+            m_frameIntervals.resize(m_nFrameCount, 0);
+            const WebPDemuxer* demuxer = WebPAnimDecoderGetDemuxer(m_pDecoder);
+            for (uint32_t nIndex = 0; nIndex < m_nFrameCount; ++nIndex) {
+                WebPIterator iter;
+                if (WebPDemuxGetFrame(demuxer, (int)nIndex + 1, &iter)) {
+                    m_frameIntervals[nIndex] = iter.duration;
+                }
+                WebPDemuxReleaseIterator(&iter);
+            }
+            return true;
+        }
+
+        /** 获取每帧的播放时间间隔
+        */
+        const std::vector<int32_t>& GetFrameIntervals() const { return m_frameIntervals; }
+
+        /** 获取循环播放次数
+        */
+        uint32_t GetLoopCount() const { return m_nLoopCount; }
+
+        virtual uint32_t GetFrameCount() const override
+        {
+            return m_nFrameCount;
+        }
+
+        virtual uint64_t GetDataSize() const override
+        {
+            //压缩的图片数据 + 解码器的画布（两份） + 缓存的图片帧
+            uint64_t nDataSize = m_fileData.size();
+            nDataSize += (uint64_t)m_nCanvasWidth * m_nCanvasHeight * 4 * 2;
+            nDataSize += (uint64_t)m_nWidth * m_nHeight * 4 * m_cachedFrames.size();
+            return nDataSize;
+        }
+
+        virtual IBitmap* GetFrameBitmap(uint32_t nIndex) override
+        {
+            if ((m_pDecoder == nullptr) || (nIndex >= m_nFrameCount)) {
+                return nullptr;
+            }
+            for (size_t i = 0; i < m_cachedFrames.size(); ++i) {
+                if (m_cachedFrames[i].m_nIndex == nIndex) {
+                    //移到最前面（最近使用）
+                    std::rotate(m_cachedFrames.begin(), m_cachedFrames.begin() + i, m_cachedFrames.begin() + i + 1);
+                    return m_cachedFrames.front().m_pBitmap.get();
+                }
+            }
+
+            if (nIndex < m_nNextFrame) {
+                WebPAnimDecoderReset(m_pDecoder);
+                m_nNextFrame = 0;
+            }
+            uint8_t* pCanvas = nullptr;
+            int nTimestamp = 0;
+            while (m_nNextFrame <= nIndex) {
+                if (!WebPAnimDecoderGetNext(m_pDecoder, &pCanvas, &nTimestamp)) {
+                    WebPAnimDecoderReset(m_pDecoder);
+                    m_nNextFrame = 0;
+                    return nullptr;
+                }
+                ++m_nNextFrame;
+            }
+            PerformanceUtil::Instance().AddCounter(_T("WebPFrameSource::DecodeFrame"));
+
+            std::vector<uint8_t> resizedData;
+            if ((m_nWidth != m_nCanvasWidth) || (m_nHeight != m_nCanvasHeight)) {
+                resizedData.resize((size_t)m_nWidth * m_nHeight * 4);
+                if (stbir_resize_uint8_linear(pCanvas, (int)m_nCanvasWidth, (int)m_nCanvasHeight, 0,
+                                              resizedData.data(), (int)m_nWidth, (int)m_nHeight, 0,
+                                              STBIR_RGBA_PM) == nullptr) {
+                    return nullptr;
+                }
+                pCanvas = resizedData.data();
+            }
+
+            IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+            ASSERT(pRenderFactroy != nullptr);
+            if (pRenderFactroy == nullptr) {
+                return nullptr;
+            }
+            std::unique_ptr<IBitmap> pBitmap(pRenderFactroy->CreateBitmap());
+            ASSERT(pBitmap != nullptr);
+            if ((pBitmap == nullptr) || !pBitmap->Init(m_nWidth, m_nHeight, true, pCanvas)) {
+                return nullptr;
+            }
+            if (m_cachedFrames.size() >= kCachedFrameCount) {
+                m_cachedFrames.pop_back();
+            }
+            TCachedFrame cachedFrame;
+            cachedFrame.m_nIndex = nIndex;
+            cachedFrame.m_pBitmap = std::move(pBitmap);
+            m_cachedFrames.insert(m_cachedFrames.begin(), std::move(cachedFrame));
+            return m_cachedFrames.front().m_pBitmap.get();
+        }
+
+    private:
+        /** 缓存的图片帧
+        */
+        struct TCachedFrame
+        {
+            //图片帧的序号
+            uint32_t m_nIndex = 0;
+
+            //图片帧的位图
+            std::unique_ptr<IBitmap> m_pBitmap;
+        };
+
+        /** 图片文件数据（解码器使用，生命周期内不能修改）
+        */
+        std::vector<uint8_t> m_fileData;
+
+        /** 动画解码器
+        */
+        WebPAnimDecoder* m_pDecoder;
+
+        /** 帧数
+        */
+        uint32_t m_nFrameCount;
+
+        /** 解码器下一个解码的帧序号
+        */
+        uint32_t m_nNextFrame;
+
+        /** 画布（原图）的宽度和高度
+        */
+        uint32_t m_nCanvasWidth;
+        uint32_t m_nCanvasHeight;
+
+        /** 图片帧的宽度和高度
+        */
+        uint32_t m_nWidth;
+        uint32_t m_nHeight;
+
+        /** 循环播放次数
+        */
+        uint32_t m_nLoopCount;
+
+        /** 每帧的播放时间间隔
+        */
+        std::vector<int32_t> m_frameIntervals;
+
+        /** 缓存的图片帧（按最近使用排序，最近使用的在前面）
+        */
+        std::vector<TCachedFrame> m_cachedFrames;
+    };
+}
+
 ImageDecoder::ImageFormat ImageDecoder::GetImageFormat(const DString& path)
 {
     ImageFormat imageFormat = ImageFormat::kUnknown;
@@ -649,21 +1080,41 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
         return nullptr;
     }
 
+    //帧数较多的动画图片：按需解码图片帧
+    std::unique_ptr<ImageInfo> frameSourceImage = LoadFrameSourceImage(fileData, imageLoadAttribute,
+                                                                       bEnableDpiScale, nImageDpiScale, dpi);
+    if (frameSourceImage != nullptr) {
+        return frameSourceImage;
+    }
+
+    //从磁盘缓存中加载（缓存的Key需要在解码前生成，部分格式解码时会修改文件数据）
+    std::string diskCacheKey;
+    if (!m_diskCachePath.IsEmpty()) {
+        PerformanceUtil::Instance().BeginStat(_T("ImageDiskCache::LoadImageInfo"));
+        ImageDiskCache diskCache(m_diskCachePath);
+        diskCacheKey = ImageDiskCache::MakeCacheKey(fileData, imageLoadAttribute, bEnableDpiScale, nImageDpiScale, dpi);
+        std::unique_ptr<ImageInfo> cachedImage = diskCache.LoadImageInfo(diskCacheKey);
+        PerformanceUtil::Instance().EndStat(_T("ImageDiskCache::LoadImageInfo"));
+        if (cachedImage != nullptr) {
+            return cachedImage;
+        }
+    }
+
     std::vector<ImageData> imageData;
     bool bDpiScaled = false; //是否根据DPI做过按比例缩放操作
+    bool bLoadSizeApplied = false; //解码时是否已经缩放到目标大小
     int32_t playCount = -1;
 
     PerformanceUtil::Instance().BeginStat(_T("DecodeImageData"));
     bool isLoaded = DecodeImageData(fileData, imageLoadAttribute, 
                                     bEnableDpiScale, nImageDpiScale, dpi, 
-                                    imageData, playCount, bDpiScaled);
+                                    imageData, playCount, bDpiScaled, bLoadSizeApplied);
     PerformanceUtil::Instance().EndStat(_T("DecodeImageData"));
     if (!isLoaded || imageData.empty()) {
         return nullptr;
     }
 
-    ImageFormat imageFormat = GetImageFormat(imageLoadAttribute.GetImageFullPath());
-    if (imageFormat != ImageFormat::kSVG) {
+    if (!bLoadSizeApplied) {
         //加载图片的时候，应该未做过DPI自适应
         ASSERT(!bDpiScaled);
         //计算缩放后的大小
@@ -684,6 +1135,12 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
         }
     }
 
+    if (!diskCacheKey.empty()) {
+        //保存到磁盘缓存中（保存失败不影响图片的加载）
+        ImageDiskCache diskCache(m_diskCachePath);
+        diskCache.SaveImageData(diskCacheKey, imageData, playCount, bDpiScaled);
+    }
+
     std::unique_ptr<ImageInfo> imageInfo(new ImageInfo);
     std::vector<IBitmap*> frameBitmaps;
     std::vector<int> frameIntervals;
@@ -707,7 +1164,8 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
         if (pBitmap == nullptr) {
             return nullptr;
         }
-        pBitmap->Init(bitmapData.m_imageWidth, bitmapData.m_imageHeight, bitmapData.bFlipHeight, bitmapData.m_bitmapData.data());
+        pBitmap->Init(bitmapData.m_imageWidth, bitmapData.m_imageHeight, bitmapData.bFlipHeight, bitmapData.m_bitmapData.data(),
+                      bitmapData.bOpaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
         frameBitmaps.push_back(pBitmap);
     }
     imageInfo->SetFrameBitmap(frameBitmaps);
@@ -721,6 +1179,67 @@ std::unique_ptr<ImageInfo> ImageDecoder::LoadImageData(std::vector<uint8_t>& fil
     return imageInfo;
 }
 
+void ImageDecoder::SetDiskCachePath(const FilePath& diskCachePath)
+{
+    m_diskCachePath = diskCachePath;
+}
+
+std::unique_ptr<ImageInfo> ImageDecoder::LoadFrameSourceImage(std::vector<uint8_t>& fileData,
+                                                              const ImageLoadAttribute& imageLoadAttribute,
+                                                              bool bEnableDpiScale,
+                                                              uint32_t nImageDpiScale,
+                                                              const DpiManager& dpi)
+{
+    //目前只支持WebP动画（GIF和APNG的解码器只支持一次解码所有帧）
+    ImageFormat imageFormat = GetImageFormat(imageLoadAttribute.GetImageFullPath());
+    if (imageFormat != ImageFormat::kWEBP) {
+        return nullptr;
+    }
+    uint32_t nImageWidth = 0;
+    uint32_t nImageHeight = 0;
+    bool bAnimation = false;
+    if (!WebPImageLoader::GetImageSize(fileData, nImageWidth, nImageHeight, bAnimation) || !bAnimation) {
+        return nullptr;
+    }
+    uint32_t nFrameCount = WebPImageLoader::GetFrameCount(fileData);
+    if (nFrameCount < 2) {
+        return nullptr;
+    }
+
+    //计算缩放后的大小
+    uint32_t nLoadWidth = nImageWidth;
+    uint32_t nLoadHeight = nImageHeight;
+    bool bDpiScaled = false;
+    ImageLoader::CalcImageLoadSize(imageLoadAttribute,
+                                   bEnableDpiScale, nImageDpiScale, dpi, bDpiScaled,
+                                   nLoadWidth, nLoadHeight);
+    if ((nLoadWidth == 0) || (nLoadHeight == 0)) {
+        return nullptr;
+    }
+
+    //所有帧解码后的总大小不超过上限时，一次解码所有帧（播放时不需要再解码）
+    const uint64_t nFrameBytes = (uint64_t)std::max(nImageWidth, nLoadWidth) * std::max(nImageHeight, nLoadHeight) * 4;
+    if (nFrameBytes * nFrameCount <= kMaxDecodedAnimationBytes) {
+        return nullptr;
+    }
+
+    std::unique_ptr<WebPImageLoader::WebPFrameSource> pFrameSource = std::make_unique<WebPImageLoader::WebPFrameSource>();
+    if (!pFrameSource->Init(fileData, nLoadWidth, nLoadHeight)) {
+        return nullptr;
+    }
+    std::vector<int32_t> frameIntervals = pFrameSource->GetFrameIntervals();
+    int32_t playCount = (int32_t)pFrameSource->GetLoopCount();
+
+    std::unique_ptr<ImageInfo> imageInfo(new ImageInfo);
+    imageInfo->SetFrameSource(std::move(pFrameSource));
+    imageInfo->SetFrameInterval(frameIntervals);
+    imageInfo->SetImageSize(nLoadWidth, nLoadHeight);
+    imageInfo->SetPlayCount(playCount);
+    imageInfo->SetBitmapSizeDpiScaled(bDpiScaled);
+    PerformanceUtil::Instance().AddCounter(_T("ImageDecoder::LoadFrameSourceImage"));
+    return imageInfo;
+}
+
 bool ImageDecoder::ResizeImageData(std::vector<ImageData>& imageData,
                                    uint32_t nNewWidth,
                                    uint32_t nNewHeight)
@@ -757,7 +1276,8 @@ bool ImageDecoder::ResizeImageData(std::vector<ImageData>& imageData,
         int output_w = nNewWidth;
         int output_h = nNewHeight;
         int output_stride_in_bytes = 0;
-        stbir_pixel_layout num_channels = STBIR_RGBA;
+        //图片数据已经做过Alpha预乘
+        stbir_pixel_layout num_channels = STBIR_RGBA_PM;
         unsigned char* result = stbir_resize_uint8_linear(input_pixels, input_w, input_h, input_stride_in_bytes,
                                                           output_pixels, output_w, output_h, output_stride_in_bytes,
                                                           num_channels);
@@ -781,7 +1301,8 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
                                    const DpiManager& dpi,
                                    std::vector<ImageData>& imageData,
                                    int32_t& playCount,
-                                   bool& bDpiScaled)
+                                   bool& bDpiScaled,
+                                   bool& bLoadSizeApplied)
 {
     ASSERT(!fileData.empty());
     if (fileData.empty()) {
@@ -791,6 +1312,7 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
     imageData.clear();
     playCount = -1;
     bDpiScaled = false;
+    bLoadSizeApplied = false;
 
     bool isLoaded = false;
     ImageFormat imageFormat = GetImageFormat(imageLoadAttribute.GetImageFullPath());
@@ -804,6 +1326,7 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
         isLoaded = SVGImageLoader::LoadImageFromMemory(fileData, imageLoadAttribute, 
                                                        bEnableDpiScale, nImageDpiScale, dpi, 
                                                        imageData[0], bDpiScaled);
+        bLoadSizeApplied = true;
         break;
     case ImageFormat::kJPEG:
     case ImageFormat::kBMP:
@@ -819,7 +1342,34 @@ bool ImageDecoder::DecodeImageData(std::vector<uint8_t>& fileData,
                                                       true, imageLoadAttribute.GetIconSize());
         break;
     case ImageFormat::kWEBP:
-        isLoaded = WebPImageLoader::LoadImageFromMemory(fileData, imageData, playCount);
+        {
+            //单帧图片缩小时，解码过程中直接缩放到目标大小（不需要先解码原图再缩放，减少内存占用和计算量）
+            uint32_t nDecodeWidth = 0;
+            uint32_t nDecodeHeight = 0;
+            uint32_t nImageWidth = 0;
+            uint32_t nImageHeight = 0;
+            bool bAnimation = false;
+            bool bScaled = false;
+            if (WebPImageLoader::GetImageSize(fileData, nImageWidth, nImageHeight, bAnimation) && !bAnimation) {
+                uint32_t nLoadWidth = nImageWidth;
+                uint32_t nLoadHeight = nImageHeight;
+                ImageLoader::CalcImageLoadSize(imageLoadAttribute,
+                                               bEnableDpiScale, nImageDpiScale, dpi, bScaled,
+                                               nLoadWidth, nLoadHeight);
+                if ((nLoadWidth > 0) && (nLoadHeight > 0) &&
+                    (nLoadWidth <= nImageWidth) && (nLoadHeight <= nImageHeight) &&
+                    ((nLoadWidth != nImageWidth) || (nLoadHeight != nImageHeight))) {
+                    nDecodeWidth = nLoadWidth;
+                    nDecodeHeight = nLoadHeight;
+                }
+            }
+            isLoaded = WebPImageLoader::LoadImageFromMemory(fileData, imageData, playCount,
+                                                            nDecodeWidth, nDecodeHeight);
+            if (isLoaded && (nDecodeWidth > 0) && (nDecodeHeight > 0)) {
+                bLoadSizeApplied = true;
+                bDpiScaled = bScaled;
+            }
+        }
         break;
     
     default:
@@ -2,6 +2,7 @@
 #define UI_IMAGE_IMAGE_DECODER_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Utils/FilePath.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -30,13 +31,23 @@ public:
                                              uint32_t nImageDpiScale,
                                              const DpiManager& dpi);
 
+    /** 设置解码结果的磁盘缓存目录（为空表示不使用磁盘缓存），设置后解码并缩放后的位图数据保存到该目录中，
+    *   再次加载同一个图片时（即使程序重新启动），直接从缓存文件中创建位图，不需要再解码
+    */
+    void SetDiskCachePath(const FilePath& diskCachePath);
+
 public:
+    /** 动画图片所有帧解码后的总大小上限（字节），超过时按需解码图片帧
+    */
+    static constexpr uint64_t kMaxDecodedAnimationBytes = 32 * 1024 * 1024;
+
     /** 加载后的图片数据
     */
     struct ImageData
     {
         /** 位图数据，每帧图片的数据长度固定为：图像数据长度为 (m_imageHeight*m_imageWidth*4)
-        *   每个像素数据固定占4个字节，格式为ARGB格式，位数顺序从高位到低位分别为[第3位:A，第2位:R，第1位:G,第0位:B]
+        *   每个像素数据固定占4个字节，格式为ARGB格式，位数顺序从高位到低位分别为[第3位:A，第2位:R，第1位:G,第0位:B]，
+        *   颜色值已经做过Alpha预乘
         */
         std::vector<uint8_t> m_bitmapData;
 
@@ -55,6 +66,10 @@ public:
         /** 创建位图的时候，是否需要翻转高度（不同加载引擎，此属性可能不同）
         */
         bool bFlipHeight = true;
+
+        /** 是否所有像素都是不透明的（创建位图时指定为不透明图片，绘制时不需要混合）
+        */
+        bool bOpaque = false;
     };
 
 private:
@@ -67,6 +82,7 @@ private:
     * @param [out] imageData 加载成功的图片数据，每个图片帧一个元素
     * @param [out] playCount 动画播放的循环次数(-1表示无效值；大于等于0时表示值有效，如果等于0，表示动画是循环播放的, APNG格式支持设置循环播放次数)
     * @param [out] bDpiScaled 图片加载的时候，图片大小是否进行了DPI自适应操作
+    * @param [out] bLoadSizeApplied 解码时是否已经按照加载属性和DPI缩放到目标大小（SVG图片、支持缩放解码的格式），如果为false，需要解码后再缩放
     */
     bool DecodeImageData(std::vector<uint8_t>& fileData, 
                          const ImageLoadAttribute& imageLoadAttribute,
@@ -75,7 +91,17 @@ private:
                          const DpiManager& dpi,
                          std::vector<ImageData>& imageData,
                          int32_t& playCount,
-                         bool& bDpiScaled);
+                         bool& bDpiScaled,
+                         bool& bLoadSizeApplied);
+
+    /** 加载帧数较多的动画图片：不解码所有的帧，创建按需解码的图片帧数据源（参数同LoadImageData）
+    * @return 如果不是动画图片，或者所有帧解码后的总大小不超过kMaxDecodedAnimationBytes，返回nullptr
+    */
+    std::unique_ptr<ImageInfo> LoadFrameSourceImage(std::vector<uint8_t>& fileData,
+                                                    const ImageLoadAttribute& imageLoadAttribute,
+                                                    bool bEnableDpiScale,
+                                                    uint32_t nImageDpiScale,
+                                                    const DpiManager& dpi);
 
     /** 对图片数据进行大小缩放
     * @param [in] imageData 需要缩放的图片数据
@@ -102,6 +128,11 @@ private:
     /** 根据图片文件的扩展名获取图片格式
     */
     static ImageFormat GetImageFormat(const DString& path);
+
+private:
+    /** 解码结果的磁盘缓存目录
+    */
+    FilePath m_diskCachePath;
 };
 
 } // namespace ui
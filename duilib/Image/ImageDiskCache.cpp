@@ -0,0 +1,321 @@
+#include "ImageDiskCache.h"
+#include "duilib/Image/ImageInfo.h"
+#include "duilib/Image/ImageLoadAttribute.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Core/DpiManager.h"
+#include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/MemoryMappedFile.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace ui 
+{
+/** 缓存文件的标识和格式版本（文件格式或者解码结果有变化时，需要修改版本号，使旧的缓存失效）
+*/
+static constexpr uint32_t kImageCacheMagic = 0x43494455; //"UDIC"
+static constexpr uint32_t kImageCacheVersion = 2;
+
+/** 缓存文件头，其后依次为：缓存的Key（按4字节对齐），每个图片帧的帧头和位图数据
+*/
+struct TImageCacheHeader
+{
+    uint32_t m_nMagic;
+    uint32_t m_nVersion;
+    uint32_t m_nKeySize;
+    uint32_t m_nFrameCount;
+    int32_t m_nPlayCount;
+    uint32_t m_nDpiScaled;
+};
+
+/** 图片帧的帧头，其后为位图数据（长度为：m_nWidth*m_nHeight*4）
+*/
+struct TImageCacheFrame
+{
+    uint32_t m_nWidth;
+    uint32_t m_nHeight;
+    uint32_t m_nFrameInterval;
+    uint32_t m_nFlipHeight;
+    uint32_t m_nOpaque;
+};
+
+/** 计算数据的哈希值（FNV-1a算法）
+*/
+static uint64_t HashData(const uint8_t* pData, size_t nSize, uint64_t nHash = 14695981039346656037ULL)
+{
+    for (size_t nIndex = 0; nIndex < nSize; ++nIndex) {
+        nHash ^= pData[nIndex];
+        nHash *= 1099511628211ULL;
+    }
+    return nHash;
+}
+
+/** 按4字节对齐
+*/
+static size_t AlignSize(size_t nSize)
+{
+    return (nSize + 3) & ~((size_t)3);
+}
+
+ImageDiskCache::ImageDiskCache(const FilePath& cachePath):
+    m_cachePath(cachePath)
+{
+}
+
+std::string ImageDiskCache::MakeCacheKey(const std::vector<uint8_t>& fileData,
+                                         const ImageLoadAttribute& imageLoadAttribute,
+                                         bool bEnableDpiScale,
+                                         uint32_t nImageDpiScale,
+                                         const DpiManager& dpi)
+{
+    //图片路径和加载属性、DPI缩放比，以及图片文件内容（文件修改后，缓存自动失效）
+    std::string cacheKey = StringConvert::TToUTF8(imageLoadAttribute.GetCacheKey(dpi.GetScale()));
+    cacheKey += StringUtil::Printf("|%u|%u|%u|%u|%u|%u|%llu|%016llx",
+                                   kImageCacheVersion,
+                                   (uint32_t)bEnableDpiScale,
+                                   (uint32_t)imageLoadAttribute.NeedDpiScale(),
+                                   nImageDpiScale,
+                                   dpi.GetScale(),
+                                   imageLoadAttribute.GetIconSize(),
+                                   (unsigned long long)fileData.size(),
+                                   (unsigned long long)HashData(fileData.data(), fileData.size()));
+    return cacheKey;
+}
+
+FilePath ImageDiskCache::GetCacheFilePath(const std::string& cacheKey) const
+{
+    uint64_t nHash = HashData((const uint8_t*)cacheKey.data(), cacheKey.size());
+    DString fileName = StringUtil::Printf(_T("%016llx.imgcache"), (unsigned long long)nHash);
+    return FilePathUtil::JoinFilePath(m_cachePath, FilePath(fileName));
+}
+
+std::unique_ptr<ImageInfo> ImageDiskCache::LoadImageInfo(const std::string& cacheKey) const
+{
+    if (m_cachePath.IsEmpty() || cacheKey.empty()) {
+        return nullptr;
+    }
+    IRenderFactory* pRenderFactroy = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactroy != nullptr);
+    if (pRenderFactroy == nullptr) {
+        return nullptr;
+    }
+    //映射缓存文件，位图数据从映射的内存直接复制到位图中
+    MemoryMappedFile cacheFile;
+    if (!cacheFile.Open(GetCacheFilePath(cacheKey))) {
+        PerformanceUtil::Instance().AddCounter(_T("ImageDiskCache(Miss)"));
+        return nullptr;
+    }
+    const uint8_t* pData = cacheFile.GetData();
+    const size_t nSize = cacheFile.GetSize();
+    if (nSize < sizeof(TImageCacheHeader)) {
+        return nullptr;
+    }
+    TImageCacheHeader header;
+    ::memcpy(&header, pData, sizeof(header));
+    if ((header.m_nMagic != kImageCacheMagic) || (header.m_nVersion != kImageCacheVersion) ||
+        (header.m_nKeySize != cacheKey.size()) || (header.m_nFrameCount == 0)) {
+        return nullptr;
+    }
+    size_t nOffset = sizeof(TImageCacheHeader);
+    if ((nSize - nOffset) < AlignSize(header.m_nKeySize)) {
+        return nullptr;
+    }
+    //文件名是Key的哈希值，需要比较完整的Key，避免哈希冲突
+    if (::memcmp(pData + nOffset, cacheKey.data(), cacheKey.size()) != 0) {
+        PerformanceUtil::Instance().AddCounter(_T("ImageDiskCache(Miss)"));
+        return nullptr;
+    }
+    nOffset += AlignSize(header.m_nKeySize);
+
+    std::vector<IBitmap*> frameBitmaps;
+    std::vector<int32_t> frameIntervals;
+    bool bValid = true;
+    for (uint32_t nFrame = 0; nFrame < header.m_nFrameCount; ++nFrame) {
+        TImageCacheFrame frame;
+        if ((nSize - nOffset) < sizeof(frame)) {
+            bValid = false;
+            break;
+        }
+        ::memcpy(&frame, pData + nOffset, sizeof(frame));
+        nOffset += sizeof(frame);
+        const uint64_t nBitmapSize = (uint64_t)frame.m_nWidth * frame.m_nHeight * 4;
+        if ((nBitmapSize == 0) || ((uint64_t)(nSize - nOffset) < nBitmapSize)) {
+            bValid = false;
+            break;
+        }
+        IBitmap* pBitmap = pRenderFactroy->CreateBitmap();
+        ASSERT(pBitmap != nullptr);
+        if ((pBitmap == nullptr) ||
+            !pBitmap->Init(frame.m_nWidth, frame.m_nHeight, frame.m_nFlipHeight != 0, pData + nOffset,
+                           (frame.m_nOpaque != 0) ? kOpaque_SkAlphaType : kPremul_SkAlphaType)) {
+            if (pBitmap != nullptr) {
+                delete pBitmap;
+            }
+            bValid = false;
+            break;
+        }
+        nOffset += (size_t)nBitmapSize;
+        frameBitmaps.push_back(pBitmap);
+        frameIntervals.push_back((int32_t)frame.m_nFrameInterval);
+    }
+    if (!bValid) {
+        for (IBitmap* pBitmap : frameBitmaps) {
+            delete pBitmap;
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<ImageInfo> imageInfo(new ImageInfo);
+    //多帧图片时，以第一帧图片作为图片的大小信息
+    imageInfo->SetImageSize((int32_t)frameBitmaps[0]->GetWidth(), (int32_t)frameBitmaps[0]->GetHeight());
+    imageInfo->SetFrameBitmap(frameBitmaps);
+    if (frameIntervals.size() > 1) {
+        imageInfo->SetFrameInterval(frameIntervals);
+    }
+    imageInfo->SetPlayCount(header.m_nPlayCount);
+    imageInfo->SetBitmapSizeDpiScaled(header.m_nDpiScaled != 0);
+    cacheFile.Close();
+    //更新缓存文件的修改时间，清理缓存时按修改时间从旧到新删除（最近使用的缓存文件保留）
+    std::error_code errorCode;
+    std::filesystem::last_write_time(GetCacheFilePath(cacheKey).NativePath(), std::filesystem::file_time_type::clock::now(), errorCode);
+    PerformanceUtil::Instance().AddCounter(_T("ImageDiskCache(Hit)"));
+    return imageInfo;
+}
+
+bool ImageDiskCache::SaveImageData(const std::string& cacheKey,
+                                   const std::vector<ImageDecoder::ImageData>& imageData,
+                                   int32_t playCount,
+                                   bool bDpiScaled) const
+{
+    if (m_cachePath.IsEmpty() || cacheKey.empty() || imageData.empty()) {
+        return false;
+    }
+    size_t nFileSize = sizeof(TImageCacheHeader) + AlignSize(cacheKey.size());
+    for (const ImageDecoder::ImageData& bitmapData : imageData) {
+        if (bitmapData.m_bitmapData.size() != ((size_t)bitmapData.m_imageWidth * bitmapData.m_imageHeight * 4)) {
+            return false;
+        }
+        nFileSize += sizeof(TImageCacheFrame) + bitmapData.m_bitmapData.size();
+    }
+
+    std::vector<uint8_t> fileData;
+    fileData.resize(nFileSize, 0);
+    uint8_t* pData = fileData.data();
+    TImageCacheHeader header;
+    header.m_nMagic = kImageCacheMagic;
+    header.m_nVersion = kImageCacheVersion;
+    header.m_nKeySize = (uint32_t)cacheKey.size();
+    header.m_nFrameCount = (uint32_t)imageData.size();
+    header.m_nPlayCount = playCount;
+    header.m_nDpiScaled = bDpiScaled ? 1 : 0;
+    ::memcpy(pData, &header, sizeof(header));
+    size_t nOffset = sizeof(header);
+    ::memcpy(pData + nOffset, cacheKey.data(), cacheKey.size());
+    nOffset += AlignSize(cacheKey.size());
+    for (const ImageDecoder::ImageData& bitmapData : imageData) {
+        TImageCacheFrame frame;
+        frame.m_nWidth = bitmapData.m_imageWidth;
+        frame.m_nHeight = bitmapData.m_imageHeight;
+        frame.m_nFrameInterval = bitmapData.m_frameInterval;
+        frame.m_nFlipHeight = bitmapData.bFlipHeight ? 1 : 0;
+        frame.m_nOpaque = bitmapData.bOpaque ? 1 : 0;
+        ::memcpy(pData + nOffset, &frame, sizeof(frame));
+        nOffset += sizeof(frame);
+        ::memcpy(pData + nOffset, bitmapData.m_bitmapData.data(), bitmapData.m_bitmapData.size());
+        nOffset += bitmapData.m_bitmapData.size();
+    }
+    ASSERT(nOffset == nFileSize);
+
+    if (!m_cachePath.IsExistsDirectory() && !FilePathUtil::CreateDirectories(m_cachePath.ToString())) {
+        return false;
+    }
+    //先写入临时文件，再改名为缓存文件，避免其他线程或者进程读到不完整的文件
+    static std::atomic<uint32_t> s_nTempFileIndex{ 0 };
+    const FilePath cacheFilePath = GetCacheFilePath(cacheKey);
+    FilePath tempFilePath = cacheFilePath;
+    tempFilePath += StringUtil::Printf(_T(".%llx.%u.tmp"),
+                                       (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id()),
+                                       (uint32_t)s_nTempFileIndex.fetch_add(1));
+    if (!FileUtil::WriteFileData(tempFilePath, fileData)) {
+        std::error_code errorCode;
+        std::filesystem::remove(tempFilePath.NativePath(), errorCode);
+        return false;
+    }
+    std::error_code errorCode;
+    std::filesystem::rename(tempFilePath.NativePath(), cacheFilePath.NativePath(), errorCode);
+    if (errorCode) {
+        std::filesystem::remove(tempFilePath.NativePath(), errorCode);
+        return false;
+    }
+    PerformanceUtil::Instance().AddCounter(_T("ImageDiskCache(Save)"));
+    return true;
+}
+
+size_t ImageDiskCache::TrimCacheFiles(const FilePath& cachePath, uint64_t nMaxBytes)
+{
+    if (cachePath.IsEmpty() || !cachePath.IsExistsDirectory()) {
+        return 0;
+    }
+    PerformanceStat statPerformance(_T("ImageDiskCache::TrimCacheFiles"));
+    struct TCacheFile
+    {
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_lastWriteTime;
+        uint64_t m_nFileSize = 0;
+    };
+    std::vector<TCacheFile> cacheFiles;
+    uint64_t nTotalBytes = 0;
+    size_t nRemoved = 0;
+    std::error_code errorCode;
+    for (const auto& entry : std::filesystem::directory_iterator(cachePath.NativePath(), errorCode)) {
+        std::error_code entryError;
+        if (!entry.is_regular_file(entryError)) {
+            continue;
+        }
+        const std::filesystem::path& filePath = entry.path();
+        if (filePath.extension() == _T(".tmp")) {
+            //写入失败或者进程退出时遗留的临时文件（正在写入的临时文件删除失败时忽略）
+            if (std::filesystem::remove(filePath, entryError)) {
+                ++nRemoved;
+            }
+            continue;
+        }
+        if (filePath.extension() != _T(".imgcache")) {
+            continue;
+        }
+        TCacheFile cacheFile;
+        cacheFile.m_path = filePath;
+        cacheFile.m_lastWriteTime = entry.last_write_time(entryError);
+        cacheFile.m_nFileSize = entry.file_size(entryError);
+        if (entryError) {
+            continue;
+        }
+        nTotalBytes += cacheFile.m_nFileSize;
+        cacheFiles.push_back(cacheFile);
+    }
+    if (nTotalBytes <= nMaxBytes) {
+        return nRemoved;
+    }
+    //按最后使用时间排序，从最旧的开始删除
+    std::sort(cacheFiles.begin(), cacheFiles.end(), [](const TCacheFile& a, const TCacheFile& b) {
+            return a.m_lastWriteTime < b.m_lastWriteTime;
+        });
+    for (const TCacheFile& cacheFile : cacheFiles) {
+        if (nTotalBytes <= nMaxBytes) {
+            break;
+        }
+        if (std::filesystem::remove(cacheFile.m_path, errorCode)) {
+            nTotalBytes -= cacheFile.m_nFileSize;
+            ++nRemoved;
+        }
+    }
+    PerformanceUtil::Instance().AddCounter(_T("ImageDiskCache(Trim)"), (int64_t)nRemoved);
+    return nRemoved;
+}
+
+} // namespace ui
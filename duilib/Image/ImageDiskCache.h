@@ -0,0 +1,69 @@
+#ifndef UI_IMAGE_IMAGE_DISK_CACHE_H_
+#define UI_IMAGE_IMAGE_DISK_CACHE_H_
+
+#include "duilib/Image/ImageDecoder.h"
+#include "duilib/Utils/FilePath.h"
+
+namespace ui 
+{
+class ImageInfo;
+
+/** 图片解码结果的磁盘缓存：保存解码并缩放后的位图数据，下次启动时直接映射缓存文件创建位图，不需要再解码图片
+*   缓存的Key包含图片文件内容的哈希值，图片文件变化后自动失效（旧的缓存文件不再被使用）
+*   所有函数均可在工作线程中调用（不同线程同时写入同一个缓存文件时，写入临时文件后再改名，不会读到不完整的数据）
+*/
+class ImageDiskCache
+{
+public:
+    /** 构造函数
+    * @param [in] cachePath 缓存文件所在的目录
+    */
+    explicit ImageDiskCache(const FilePath& cachePath);
+
+    /** 生成缓存的Key（参数同ImageDecoder::LoadImageData，需要在解码前调用，部分格式解码时会修改文件数据）
+    */
+    static std::string MakeCacheKey(const std::vector<uint8_t>& fileData,
+                                    const ImageLoadAttribute& imageLoadAttribute,
+                                    bool bEnableDpiScale,
+                                    uint32_t nImageDpiScale,
+                                    const DpiManager& dpi);
+
+    /** 从缓存中加载图片
+    * @param [in] cacheKey 缓存的Key
+    * @return 缓存不存在或者无效时，返回nullptr
+    */
+    std::unique_ptr<ImageInfo> LoadImageInfo(const std::string& cacheKey) const;
+
+    /** 将解码后的图片数据保存到缓存中
+    * @param [in] cacheKey 缓存的Key
+    * @param [in] imageData 图片数据，每个图片帧一个元素
+    * @param [in] playCount 动画播放的循环次数
+    * @param [in] bDpiScaled 图片大小是否进行了DPI自适应操作
+    */
+    bool SaveImageData(const std::string& cacheKey,
+                       const std::vector<ImageDecoder::ImageData>& imageData,
+                       int32_t playCount,
+                       bool bDpiScaled) const;
+
+    /** 按大小上限清理缓存目录：删除遗留的临时文件，缓存文件的总大小超过上限时，按最后使用时间从旧到新删除
+    *   缓存文件被使用时（LoadImageInfo命中）会更新其修改时间，所以最近使用的缓存文件会保留
+    * @param [in] cachePath 缓存文件所在的目录
+    * @param [in] nMaxBytes 缓存文件总大小的上限（字节），为0表示删除所有缓存文件
+    * @return 返回删除的缓存文件个数
+    */
+    static size_t TrimCacheFiles(const FilePath& cachePath, uint64_t nMaxBytes);
+
+private:
+    /** 获取缓存文件的路径
+    */
+    FilePath GetCacheFilePath(const std::string& cacheKey) const;
+
+private:
+    /** 缓存文件所在的目录
+    */
+    FilePath m_cachePath;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_IMAGE_DISK_CACHE_H_
@@ -48,6 +48,7 @@ void ImageInfo::SetFrameBitmap(const std::vector<IBitmap*>& frameBitmaps)
         delete m_pFrameBitmaps;
         m_pFrameBitmaps = nullptr;
     }
+    m_pFrameSource.reset();
     m_nFrameCount = (uint32_t)frameBitmaps.size();
     if (m_nFrameCount > 0) {
         m_pFrameBitmaps = new IBitmap*[m_nFrameCount];
@@ -57,8 +58,19 @@ void ImageInfo::SetFrameBitmap(const std::vector<IBitmap*>& frameBitmaps)
     }    
 }
 
+void ImageInfo::SetFrameSource(std::unique_ptr<IImageFrameSource> pFrameSource)
+{
+    SetFrameBitmap(std::vector<IBitmap*>());
+    m_pFrameSource = std::move(pFrameSource);
+    m_nFrameCount = (m_pFrameSource != nullptr) ? m_pFrameSource->GetFrameCount() : 0;
+}
+
 IBitmap* ImageInfo::GetBitmap(uint32_t nIndex) const
 {
+    if (m_pFrameSource != nullptr) {
+        ASSERT(nIndex < m_nFrameCount);
+        return (nIndex < m_nFrameCount) ? m_pFrameSource->GetFrameBitmap(nIndex) : nullptr;
+    }
     ASSERT((nIndex < m_nFrameCount) && (m_pFrameBitmaps != nullptr));
     if ((nIndex < m_nFrameCount) && (m_pFrameBitmaps != nullptr)){
         return m_pFrameBitmaps[nIndex];
@@ -66,6 +78,22 @@ IBitmap* ImageInfo::GetBitmap(uint32_t nIndex) const
     return nullptr;
 }
 
+uint64_t ImageInfo::GetBitmapDataSize() const
+{
+    if (m_pFrameSource != nullptr) {
+        return m_pFrameSource->GetDataSize();
+    }
+    uint64_t nDataSize = 0;
+    if (m_pFrameBitmaps != nullptr) {
+        for (uint32_t i = 0; i < m_nFrameCount; ++i) {
+            if (m_pFrameBitmaps[i] != nullptr) {
+                nDataSize += (uint64_t)m_pFrameBitmaps[i]->GetWidth() * m_pFrameBitmaps[i]->GetHeight() * 4;
+            }
+        }
+    }
+    return nDataSize;
+}
+
 void ImageInfo::SetImageSize(int32_t nWidth, int32_t nHeight)
 {
     ASSERT(nWidth > 0);
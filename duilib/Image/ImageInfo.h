@@ -9,6 +9,28 @@ namespace ui
     class IRender;
     class Control;
 
+/** 多帧图片的图片帧数据源：按需解码图片帧（用于帧数较多的动画图片，避免一次解码所有的帧而占用大量内存）
+*/
+class UILIB_API IImageFrameSource
+{
+public:
+    virtual ~IImageFrameSource() = default;
+
+    /** 获取图片的帧数
+    */
+    virtual uint32_t GetFrameCount() const = 0;
+
+    /** 获取一个图片帧数据
+    * @param [in] nIndex 图片帧的序号
+    * @return 返回图片帧的位图，由数据源管理（只缓存最近使用的几帧），调用方使用后不应保存
+    */
+    virtual IBitmap* GetFrameBitmap(uint32_t nIndex) = 0;
+
+    /** 获取占用的内存大小（字节，包含压缩的图片数据和缓存的图片帧）
+    */
+    virtual uint64_t GetDataSize() const = 0;
+};
+
 /** 图片信息
 */
 class UILIB_API ImageInfo
@@ -46,10 +68,19 @@ public:
     */
     void SetFrameBitmap(const std::vector<IBitmap*>& frameBitmaps);
 
+    /** 设置图片帧数据源（按需解码图片帧）, 设置后该资源由该类内部托管，替代SetFrameBitmap设置的图片帧数据
+    */
+    void SetFrameSource(std::unique_ptr<IImageFrameSource> pFrameSource);
+
     /** 获取一个图片帧数据
+    *   如果设置了图片帧数据源，返回的位图只在短时间内有效（绘制时使用，不应保存）
     */
     IBitmap* GetBitmap(uint32_t nIndex) const;
 
+    /** 获取图片帧数据占用的内存大小（字节）
+    */
+    uint64_t GetBitmapDataSize() const;
+
     /** 设置图片的多帧播放事件间隔（毫秒为单位 ）
     */
     void SetFrameInterval(const std::vector<int32_t>& frameIntervals);
@@ -122,6 +153,9 @@ private:
     //图片帧数量
     uint32_t m_nFrameCount;
 
+    //图片帧数据源（按需解码图片帧，设置后不使用m_pFrameBitmaps）
+    std::unique_ptr<IImageFrameSource> m_pFrameSource;
+
     //循环播放次数(大于等于0，如果等于0，表示动画是循环播放的, APNG格式支持设置循环播放次数)
     int32_t m_nPlayCount;
 
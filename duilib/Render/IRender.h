@@ -5,6 +5,7 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/SharePtr.h"
 #include <map>
+#include <vector>
 
 namespace ui 
 {
@@ -87,7 +88,7 @@ public:
     */
     virtual void ClearFontFiles() = 0;
 
-    /** 清除字体缓存
+    /** 清除字体缓存（包括字体相关的文本排版结果缓存），字体发生变化时调用
     */
     virtual void ClearFontCache() = 0;
 };
@@ -440,6 +441,29 @@ public:
     * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
     */
     virtual bool GetUpdateRect(UiRect& rcUpdate) const = 0;
+
+    /** 获取界面需要绘制的多个区域，以实现局部绘制（各个区域分别绘制，避免合并成一个大的区域后绘制的范围过大）
+    * @param [out] updateRects 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& updateRects) const
+    {
+        updateRects.clear();
+        UiRect rcUpdate;
+        bool bRet = GetUpdateRect(rcUpdate);
+        if (bRet && !rcUpdate.IsEmpty()) {
+            updateRects.push_back(rcUpdate);
+        }
+        return bRet;
+    }
+
+    /** 获取无需重新绘制、但需要更新到窗口的区域（比如滚动时，已经通过移动像素完成更新的区域）
+    * @param [out] scrolledRects 返回区域矩形列表
+    */
+    virtual void GetScrolledRects(std::vector<UiRect>& scrolledRects) const
+    {
+        scrolledRects.clear();
+    }
 };
 
 /** 光栅操作代码
@@ -773,6 +797,14 @@ public:
                         IRender* pSrcRender, int32_t xSrc, int32_t ySrc,
                         RopMode rop) = 0;
 
+    /** 将指定区域内的像素整体移动（用于滚动时复用已经绘制的内容），移出区域的像素丢弃，移入后空出的部分保留原数据（需要重绘）
+    * @param [in] rcScroll 移动的区域（像素坐标，不受窗口原点的影响）
+    * @param [in] dx X轴方向移动的距离，正数向右移动，负数向左移动
+    * @param [in] dy Y轴方向移动的距离，正数向下移动，负数向上移动
+    * @return 成功返回true，如果不支持（比如非CPU绘制）返回false
+    */
+    virtual bool ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy) = 0;
+
     /** 函数将一个位图从源矩形复制到目标矩形中，并拉伸或压缩位图以适应目标矩形的尺寸（如有必要）。 
         系统根据当前在目标设备上下文中设置的拉伸模式拉伸或压缩位图。
     * @param [in] xDest 目标矩形左上角的 x 坐标
@@ -1233,6 +1265,15 @@ public:
     */
     virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) = 0;
 
+    /** 分块并行绘制：先在调用线程中把绘制过程录制下来，然后将绘制区域切分为多个分块，在多个线程中并行回放到当前Render
+    * @param [in] rcPaint 绘制区域
+    * @param [in] nThreadCount 参与绘制的线程数（含调用线程）
+    * @param [in] recordFunc 录制回调函数，参数为录制使用的Render对象（坐标与当前Render一致），在调用线程中执行
+    * @return 绘制完成返回true；如果不支持并行绘制（比如GPU绘制），或者录制时使用了无法录制的操作（比如ReadPixels），
+    *         返回false，此时当前Render的内容没有被修改，调用方应按普通方式绘制
+    */
+    virtual bool PaintParallel(const UiRect& rcPaint, int32_t nThreadCount,
+                               const std::function<void(IRender* pRecordRender)>& recordFunc) = 0;
 };
 
 /** 渲染接口管理，用于创建Font、Pen、Brush、Path、Matrix、Bitmap、Render等渲染实现对象
@@ -1,9 +1,13 @@
 #include "Bitmap_Skia.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/PixelUtil.h"
 
 #pragma warning (push)
 #pragma warning (disable: 4244 4201)
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPixelRef.h"
 
 #pragma warning (pop)
 
@@ -17,6 +21,7 @@ Bitmap_Skia::Bitmap_Skia()
 
 Bitmap_Skia::~Bitmap_Skia()
 {
+    m_skImage.reset();
     m_pSkBitmap.reset();
 }
 
@@ -28,19 +33,8 @@ bool Bitmap_Skia::Init(uint32_t nWidth, uint32_t nHeight, bool flipHeight,
         return false;
     }
 
-    std::vector<uint8_t> flipPixelBits;
-    if (!flipHeight) {
-        //避免图像是倒着的，此处对图片数据进行翻转处理（Skia似乎不支持flipHeight的情况）
-        ASSERT(pPixelBits != nullptr);
-        if (pPixelBits != nullptr) {
-            //需要对图片数据进行垂直翻转，否则图片是倒着的
-            flipPixelBits.resize(nWidth * nHeight * sizeof(uint32_t));
-            FlipPixelBits((const uint8_t*)pPixelBits, nWidth, nHeight, flipPixelBits);
-            pPixelBits = flipPixelBits.data();
-            flipHeight = true;
-        }
-    }
-
+    ASSERT(flipHeight || (pPixelBits != nullptr));
+    m_skImage.reset();
     m_pSkBitmap->reset();
     m_pSkBitmap->setInfo(SkImageInfo::Make(nWidth, nHeight, kN32_SkColorType, static_cast<SkAlphaType>(alphaType)));
     m_pSkBitmap->allocPixels();
@@ -54,26 +48,28 @@ bool Bitmap_Skia::Init(uint32_t nWidth, uint32_t nHeight, bool flipHeight,
     if (pBits == nullptr) {
         return false;
     }
-    //复制图片数据到位图
     if (pPixelBits != nullptr) {
-        ::memcpy(pBits, pPixelBits, nWidth * nHeight * sizeof(uint32_t));
+        //复制图片数据到位图：如果图像是倒着的，同时进行垂直翻转（Skia似乎不支持flipHeight的情况）；
+        //如果是不透明图片，同时更新图片的透明通道数据
+        uint32_t nFlags = 0;
+        if (!flipHeight) {
+            nFlags |= PixelUtil::kPixelFlipVertical;
+        }
+        if (alphaType == kOpaque_SkAlphaType) {
+            nFlags |= PixelUtil::kPixelForceOpaque;
+        }
+        if (nFlags == 0) {
+            ::memcpy(pBits, pPixelBits, nWidth * nHeight * sizeof(uint32_t));
+        }
+        else {
+            PixelUtil::ConvertPixels((const uint8_t*)pPixelBits, (uint8_t*)pBits, nWidth, nHeight, nFlags);
+        }
     }
-    
-    //更新图片的透明通道数据
-    UpdateAlphaFlag((uint8_t*)pBits);
-    return true;
-}
-
-void Bitmap_Skia::FlipPixelBits(const uint8_t* pPixelBits, uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& flipBits)
-{
-    ASSERT(flipBits.size() == nWidth* nHeight*4);
-
-    const uint32_t dwEffWidth = nWidth * 4;//每行数据字节数, 按行复制数据
-    for (uint32_t row = 0; row < nHeight; ++row) {
-        uint8_t* dest = flipBits.data() + row * dwEffWidth;
-        const uint8_t* src = pPixelBits + (nHeight - 1 - row) * dwEffWidth;
-        ::memcpy(dest, src, dwEffWidth);
+    else {
+        //更新图片的透明通道数据
+        UpdateAlphaFlag((uint8_t*)pBits);
     }
+    return true;
 }
 
 uint32_t Bitmap_Skia::GetWidth() const
@@ -93,6 +89,18 @@ UiSize Bitmap_Skia::GetSize() const
 
 void* Bitmap_Skia::LockPixelBits()
 {
+    //调用方可能会修改位图数据，缓存的图片需要重新生成
+    m_skImage.reset();
+    //写时复制：图片直接引用位图的像素数据，并要求像素数据在图片的生命周期内不变，
+    //如果还有其他图片引用像素数据（比如录制的SkPicture中引用了该图片，尚未回放），则位图使用新复制的像素数据，不影响已有的图片
+    SkPixelRef* pPixelRef = m_pSkBitmap->pixelRef();
+    if ((pPixelRef != nullptr) && !pPixelRef->unique()) {
+        SkBitmap skBitmap;
+        if (skBitmap.tryAllocPixels(m_pSkBitmap->info()) && m_pSkBitmap->readPixels(skBitmap.pixmap())) {
+            PerformanceUtil::Instance().AddCounter(_T("Bitmap_Skia(CopyBytes)"), (int64_t)m_pSkBitmap->computeByteSize());
+            m_pSkBitmap->swap(skBitmap);
+        }
+    }
     void* pPixelBits = nullptr;
     SkPixmap pixmap;
     if (m_pSkBitmap->peekPixels(&pixmap)) {
@@ -104,6 +112,7 @@ void* Bitmap_Skia::LockPixelBits()
 
 void Bitmap_Skia::UnLockPixelBits()
 {
+    m_skImage.reset();
     void* pPixelBits = nullptr;
     SkPixmap pixmap;
     if (m_pSkBitmap->peekPixels(&pixmap)) {
@@ -150,12 +159,7 @@ void Bitmap_Skia::UpdateAlphaFlag(uint8_t* pPixelBits)
     }
     if (m_pSkBitmap->info().alphaType() == SkAlphaType::kOpaque_SkAlphaType) {
         //指定为不透明图片，不需要更新AlphaBitmap标志
-        for (int32_t i = 0; i < nHeight; ++i) {
-            for (int32_t j = 0; j < nWidth; ++j) {
-                uint8_t* a = (uint8_t*)pPixelBits + (i * nWidth + j) * sizeof(uint32_t) + 3;
-                *a = 255;
-            }
-        }
+        PixelUtil::ConvertPixels(pPixelBits, pPixelBits, (uint32_t)nWidth, (uint32_t)nHeight, PixelUtil::kPixelForceOpaque);
     }
 }
 
@@ -165,4 +169,35 @@ const SkBitmap& Bitmap_Skia::GetSkBitmap() const
     return *m_pSkBitmap.get();
 }
 
+/** 图片释放时，释放对位图像素数据的引用
+*/
+static void ReleaseSkPixelRef(const void* /*pPixels*/, void* pContext)
+{
+    SkSafeUnref(static_cast<SkPixelRef*>(pContext));
+}
+
+sk_sp<SkImage> Bitmap_Skia::GetSkImage() const
+{
+    ASSERT(m_pSkBitmap.get() != nullptr);
+    SkPixmap pixmap;
+    if ((m_skImage == nullptr) && !m_pSkBitmap->drawsNothing() && m_pSkBitmap->peekPixels(&pixmap)) {
+        //图片直接引用位图的像素数据（不复制数据，位图是可变的，SkBitmap::asImage会复制一份），
+        //图片持有像素数据的引用计数，保证图片的生命周期内像素数据有效；
+        //位图数据变化时（LockPixelBits）重新生成图片，如果旧图片仍被引用，位图写时复制像素数据，保证图片的像素数据不变
+        SkPixelRef* pPixelRef = m_pSkBitmap->pixelRef();
+        SkSafeRef(pPixelRef);
+        m_skImage = SkImages::RasterFromPixmap(pixmap, ReleaseSkPixelRef, pPixelRef);
+        if (m_skImage != nullptr) {
+            PerformanceUtil::Instance().AddCounter(_T("Bitmap_Skia::GetSkImage(MakeImage)"));
+            //生成图片不复制像素数据（复制的字节数只在写时复制时增加，稳定状态下为0）
+            PerformanceUtil::Instance().AddCounter(_T("Bitmap_Skia(CopyBytes)"), 0);
+        }
+        else {
+            //参数无效时不会调用释放函数
+            SkSafeUnref(pPixelRef);
+        }
+    }
+    return m_skImage;
+}
+
 } // namespace ui
@@ -3,8 +3,16 @@
 
 #include "duilib/Render/IRender.h"
 
+#pragma warning (push)
+#pragma warning (disable: 4244 4201)
+
+#include "include/core/SkRefCnt.h"
+
+#pragma warning (pop)
+
 //Skia相关类的前置声明
 class SkBitmap;
+class SkImage;
 
 namespace ui
 {
@@ -42,6 +50,7 @@ public:
     virtual UiSize GetSize() const override;
 
     /** 锁定位图数据，数据长度 = GetWidth() * GetHeight() * 4
+    *   如果之前生成的图片仍被引用（GetSkImage），先复制一份像素数据（写时复制），返回新的数据，已有的图片不受影响
     */
     virtual void* LockPixelBits() override;
 
@@ -59,19 +68,24 @@ public:
     */
     const SkBitmap& GetSkBitmap() const;
 
+    /** 获取Skia 图片（不可变的图片对象，绘制时使用）
+    *   图片对象直接引用位图的像素数据（不复制），并且是缓存的，仅在位图数据变化（调用LockPixelBits/UnLockPixelBits或者Init）后才重新生成
+    */
+    sk_sp<SkImage> GetSkImage() const;
+
 private:
     /** 更新图片的透明通道标志
     */
     void UpdateAlphaFlag(uint8_t* pPixelBits);
 
-    /** 对图片数据进行垂直翻转
-    */
-    void FlipPixelBits(const uint8_t* pPixelBits, uint32_t nWidth, uint32_t nHeight, std::vector<uint8_t>& flipBits);
-
 private:
     /** Skia 位图
     */
     std::unique_ptr<SkBitmap> m_pSkBitmap;
+
+    /** 缓存的Skia 图片（由m_pSkBitmap生成）
+    */
+    mutable sk_sp<SkImage> m_skImage;
 };
 
 } // namespace ui
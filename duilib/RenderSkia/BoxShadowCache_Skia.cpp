@@ -0,0 +1,190 @@
+#include "BoxShadowCache_Skia.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/effects/SkImageFilters.h"
+
+#pragma warning (pop)
+
+#include <cmath>
+
+namespace ui
+{
+
+/** 默认的缓存最大字节数：4MB
+*/
+static constexpr size_t kDefaultMaxCacheBytes = 4 * 1024 * 1024;
+
+BoxShadowCache_Skia::BoxShadowCache_Skia():
+    m_nCacheBytes(0),
+    m_nMaxCacheBytes(kDefaultMaxCacheBytes),
+    m_nHitCount(0),
+    m_nMissCount(0),
+    m_nEvictionCount(0)
+{
+}
+
+BoxShadowCache_Skia::~BoxShadowCache_Skia()
+{
+    Clear();
+}
+
+BoxShadowCache_Skia& BoxShadowCache_Skia::Instance()
+{
+    static BoxShadowCache_Skia self;
+    return self;
+}
+
+size_t BoxShadowCache_Skia::TKeyHash::operator()(const TKey& key) const
+{
+    size_t nHash = std::hash<uint32_t>()(key.m_nColor);
+    nHash ^= std::hash<int32_t>()(key.m_cx) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_cy) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_nBlurRadius) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    return nHash;
+}
+
+void BoxShadowCache_Skia::CalcShadowGeometry(const UiSize& roundSize, int32_t nBlurRadius, ShadowImage& shadowImage)
+{
+    //模糊算法影响的范围是3倍的sigma(与SkImageFilters::Blur计算输出区域的方法一致)
+    shadowImage.m_nMargin = (nBlurRadius > 0) ? (int32_t)std::ceil(3.0f * (float)nBlurRadius) : 0;
+    //九宫格的固定区域：外部模糊区域 + 圆角区域 + 内部模糊区域，这个区域之外的阴影颜色是均匀的
+    shadowImage.m_nCornerX = shadowImage.m_nMargin * 2 + std::max(roundSize.cx, 0);
+    shadowImage.m_nCornerY = shadowImage.m_nMargin * 2 + std::max(roundSize.cy, 0);
+}
+
+bool BoxShadowCache_Skia::GetShadowImage(const UiSize& roundSize, int32_t nBlurRadius, UiColor dwColor, ShadowImage& shadowImage)
+{
+    TKey key;
+    key.m_cx = roundSize.cx;
+    key.m_cy = roundSize.cy;
+    key.m_nBlurRadius = nBlurRadius;
+    key.m_nColor = dwColor.GetARGB();
+
+    auto iter = m_cacheMap.find(key);
+    if (iter != m_cacheMap.end()) {
+        //命中：移动到列表头部
+        m_cacheList.splice(m_cacheList.begin(), m_cacheList, iter->second);
+        shadowImage = iter->second->m_shadowImage;
+        ++m_nHitCount;
+        PerformanceUtil::Instance().AddCounter(_T("BoxShadowCache_Skia(Hit)"));
+        return true;
+    }
+
+    ++m_nMissCount;
+    PerformanceUtil::Instance().AddCounter(_T("BoxShadowCache_Skia(Miss)"));
+
+    ShadowImage newShadowImage;
+    CalcShadowGeometry(roundSize, nBlurRadius, newShadowImage);
+    newShadowImage.m_skImage = MakeShadowImage(roundSize, nBlurRadius, dwColor, newShadowImage);
+    if (newShadowImage.m_skImage == nullptr) {
+        return false;
+    }
+    shadowImage = newShadowImage;
+
+    TItem item;
+    item.m_key = key;
+    item.m_shadowImage = newShadowImage;
+    item.m_nBytes = (size_t)newShadowImage.m_skImage->width() * newShadowImage.m_skImage->height() * sizeof(uint32_t);
+    m_nCacheBytes += item.m_nBytes;
+    m_cacheList.push_front(item);
+    m_cacheMap[key] = m_cacheList.begin();
+    TrimCache();
+    return true;
+}
+
+sk_sp<SkImage> BoxShadowCache_Skia::MakeShadowImage(const UiSize& roundSize, int32_t nBlurRadius, UiColor dwColor,
+                                                    const ShadowImage& shadowImage) const
+{
+    //阴影形状的最小尺寸：中间保留1个像素作为九宫格的可拉伸区域
+    const int32_t nShapeWidth = (shadowImage.m_nCornerX - shadowImage.m_nMargin) * 2 + 1;
+    const int32_t nShapeHeight = (shadowImage.m_nCornerY - shadowImage.m_nMargin) * 2 + 1;
+    const int32_t nImageWidth = nShapeWidth + shadowImage.m_nMargin * 2;
+    const int32_t nImageHeight = nShapeHeight + shadowImage.m_nMargin * 2;
+
+    sk_sp<SkSurface> skSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(nImageWidth, nImageHeight));
+    ASSERT(skSurface != nullptr);
+    if (skSurface == nullptr) {
+        return nullptr;
+    }
+    SkCanvas* skCanvas = skSurface->getCanvas();
+    skCanvas->clear(SK_ColorTRANSPARENT);
+
+    SkRect shapeRc = SkRect::MakeXYWH((SkScalar)shadowImage.m_nMargin, (SkScalar)shadowImage.m_nMargin,
+                                      (SkScalar)nShapeWidth, (SkScalar)nShapeHeight);
+    SkPath shadowPath;
+    shadowPath.addRoundRect(shapeRc, (SkScalar)roundSize.cx, (SkScalar)roundSize.cy);
+
+    //设置绘制阴影的属性（与直接绘制阴影时保持一致）
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setDither(true);
+    paint.setStyle(SkPaint::kStrokeAndFill_Style);
+    paint.setColor(dwColor.GetARGB());
+    paint.setImageFilter(SkImageFilters::Blur((SkScalar)nBlurRadius, (SkScalar)nBlurRadius, SkTileMode::kDecal, nullptr));
+    skCanvas->drawPath(shadowPath, paint);
+
+    return skSurface->makeImageSnapshot();
+}
+
+void BoxShadowCache_Skia::TrimCache()
+{
+    //至少保留一个缓存项（当前正在使用的）
+    while ((m_nCacheBytes > m_nMaxCacheBytes) && (m_cacheList.size() > 1)) {
+        const TItem& item = m_cacheList.back();
+        ASSERT(m_nCacheBytes >= item.m_nBytes);
+        m_nCacheBytes -= item.m_nBytes;
+        m_cacheMap.erase(item.m_key);
+        m_cacheList.pop_back();
+        ++m_nEvictionCount;
+        PerformanceUtil::Instance().AddCounter(_T("BoxShadowCache_Skia(Eviction)"));
+    }
+}
+
+void BoxShadowCache_Skia::SetMaxCacheBytes(size_t nMaxCacheBytes)
+{
+    m_nMaxCacheBytes = nMaxCacheBytes;
+    TrimCache();
+}
+
+size_t BoxShadowCache_Skia::GetMaxCacheBytes() const
+{
+    return m_nMaxCacheBytes;
+}
+
+size_t BoxShadowCache_Skia::GetCacheBytes() const
+{
+    return m_nCacheBytes;
+}
+
+void BoxShadowCache_Skia::Clear()
+{
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_nCacheBytes = 0;
+}
+
+uint64_t BoxShadowCache_Skia::GetHitCount() const
+{
+    return m_nHitCount;
+}
+
+uint64_t BoxShadowCache_Skia::GetMissCount() const
+{
+    return m_nMissCount;
+}
+
+uint64_t BoxShadowCache_Skia::GetEvictionCount() const
+{
+    return m_nEvictionCount;
+}
+
+} // namespace ui
@@ -0,0 +1,165 @@
+#ifndef UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
+#define UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
+
+#include "duilib/Render/IRender.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201)
+
+#include "include/core/SkRefCnt.h"
+
+#pragma warning (pop)
+
+#include <list>
+#include <unordered_map>
+
+//Skia相关类的前置声明
+class SkImage;
+
+namespace ui
+{
+/** 阴影（box-shadow）图片缓存：Skia绘制引擎
+*   阴影图片只与圆角大小、模糊半径、颜色相关（扩展半径和DPI缩放已体现在目标区域和传入的像素值中），
+*   每种组合只生成一个最小尺寸的九宫格阴影图片，绘制时通过drawImageLattice拉伸到目标大小，
+*   避免每次绘制时都进行模糊计算
+*/
+class UILIB_API BoxShadowCache_Skia
+{
+public:
+    BoxShadowCache_Skia();
+    ~BoxShadowCache_Skia();
+    BoxShadowCache_Skia(const BoxShadowCache_Skia&) = delete;
+    BoxShadowCache_Skia& operator = (const BoxShadowCache_Skia&) = delete;
+
+    /** 单例对象
+    */
+    static BoxShadowCache_Skia& Instance();
+
+public:
+    /** 九宫格阴影图片的信息
+    */
+    struct ShadowImage
+    {
+        //阴影图片
+        sk_sp<SkImage> m_skImage;
+
+        //模糊区域的宽度（阴影图片比阴影形状每边多出的部分）
+        int32_t m_nMargin = 0;
+
+        //九宫格左右两边固定区域的宽度（中间可拉伸区域的宽度为1）
+        int32_t m_nCornerX = 0;
+
+        //九宫格上下两边固定区域的高度（中间可拉伸区域的高度为1）
+        int32_t m_nCornerY = 0;
+    };
+
+    /** 计算九宫格阴影图片的几何信息（不生成图片）
+    * @param [in] roundSize 圆角大小
+    * @param [in] nBlurRadius 模糊半径
+    * @param [out] shadowImage 返回模糊区域的宽度和九宫格固定区域的大小
+    */
+    static void CalcShadowGeometry(const UiSize& roundSize, int32_t nBlurRadius, ShadowImage& shadowImage);
+
+    /** 获取阴影图片，如果缓存中不存在，则生成并加入缓存
+    * @param [in] roundSize 圆角大小
+    * @param [in] nBlurRadius 模糊半径
+    * @param [in] dwColor 阴影颜色
+    * @param [out] shadowImage 返回阴影图片的信息
+    */
+    bool GetShadowImage(const UiSize& roundSize, int32_t nBlurRadius, UiColor dwColor, ShadowImage& shadowImage);
+
+    /** 设置缓存的最大字节数（超过时按最近最少使用的顺序淘汰）
+    */
+    void SetMaxCacheBytes(size_t nMaxCacheBytes);
+
+    /** 获取缓存的最大字节数
+    */
+    size_t GetMaxCacheBytes() const;
+
+    /** 获取当前缓存的字节数
+    */
+    size_t GetCacheBytes() const;
+
+    /** 清空缓存
+    */
+    void Clear();
+
+    /** 获取缓存命中次数
+    */
+    uint64_t GetHitCount() const;
+
+    /** 获取缓存未命中次数
+    */
+    uint64_t GetMissCount() const;
+
+    /** 获取缓存淘汰次数
+    */
+    uint64_t GetEvictionCount() const;
+
+private:
+    /** 生成阴影图片
+    */
+    sk_sp<SkImage> MakeShadowImage(const UiSize& roundSize, int32_t nBlurRadius, UiColor dwColor,
+                                   const ShadowImage& shadowImage) const;
+
+    /** 按缓存大小限制，淘汰缓存
+    */
+    void TrimCache();
+
+private:
+    /** 缓存的关键字
+    */
+    struct TKey
+    {
+        int32_t m_cx = 0;
+        int32_t m_cy = 0;
+        int32_t m_nBlurRadius = 0;
+        uint32_t m_nColor = 0;
+
+        bool operator == (const TKey& r) const
+        {
+            return (m_cx == r.m_cx) && (m_cy == r.m_cy) &&
+                   (m_nBlurRadius == r.m_nBlurRadius) && (m_nColor == r.m_nColor);
+        }
+    };
+
+    struct TKeyHash
+    {
+        size_t operator()(const TKey& key) const;
+    };
+
+    /** 缓存项
+    */
+    struct TItem
+    {
+        TKey m_key;
+        ShadowImage m_shadowImage;
+        size_t m_nBytes = 0;
+    };
+
+    /** 缓存列表（按最近使用的顺序排列，最近使用的在前面）
+    */
+    std::list<TItem> m_cacheList;
+
+    /** 缓存索引
+    */
+    std::unordered_map<TKey, std::list<TItem>::iterator, TKeyHash> m_cacheMap;
+
+    /** 当前缓存的字节数
+    */
+    size_t m_nCacheBytes;
+
+    /** 缓存的最大字节数
+    */
+    size_t m_nMaxCacheBytes;
+
+    /** 统计数据：命中次数、未命中次数、淘汰次数
+    */
+    uint64_t m_nHitCount;
+    uint64_t m_nMissCount;
+    uint64_t m_nEvictionCount;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
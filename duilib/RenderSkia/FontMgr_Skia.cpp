@@ -1,4 +1,5 @@
 #include "FontMgr_Skia.h"
+#include "duilib/RenderSkia/TextLayoutCache_Skia.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
@@ -323,6 +324,8 @@ void FontMgr_Skia::ClearFontFiles()
 void FontMgr_Skia::ClearFontCache()
 {
     m_impl->m_fontStyleSetMap.clear();
+    //字体发生变化，文本排版结果的缓存同时失效
+    TextLayoutCache_Skia::Instance().Clear();
 }
 
 SkFont* FontMgr_Skia::CreateSkFont(const UiFont& fontInfo)
@@ -6,6 +6,7 @@
 #include "duilib/RenderSkia/Pen_Skia.h"
 #include "duilib/RenderSkia/Path_Skia.h"
 #include "duilib/RenderSkia/Matrix_Skia.h"
+#include "duilib/RenderSkia/TiledImageCache_Skia.h"
 
 #if defined (DUILIB_BUILD_FOR_SDL)
     #include "duilib/RenderSkia/Render_Skia_SDL.h"
@@ -34,6 +35,8 @@ RenderFactory_Skia::RenderFactory_Skia()
 
 RenderFactory_Skia::~RenderFactory_Skia()
 {
+    //释放缓存的图片（在Skia相关对象释放之前）
+    TiledImageCache_Skia::Instance().Clear();
     if (m_impl != nullptr) {
         delete m_impl;
         m_impl = nullptr;
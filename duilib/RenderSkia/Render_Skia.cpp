@@ -5,10 +5,15 @@
 #include "duilib/RenderSkia/Matrix_Skia.h"
 #include "duilib/RenderSkia/Font_Skia.h"
 #include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/BoxShadowCache_Skia.h"
+#include "duilib/RenderSkia/TextLayoutCache_Skia.h"
+#include "duilib/RenderSkia/TiledImageCache_Skia.h"
+#include "duilib/RenderSkia/Render_Skia_Picture.h"
 #include "duilib/Render/BitmapAlpha.h"
 
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/ThreadPool.h"
 #include "duilib/Core/SharePtr.h"
 
 #pragma warning (push)
@@ -20,6 +25,8 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRegion.h"
@@ -28,6 +35,7 @@
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkPathEffect.h"
+#include "include/core/SkTextBlob.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/effects/SkImageFilters.h"
@@ -35,6 +43,7 @@
 #pragma warning (pop)
 
 #include <unordered_set>
+#include <cstdlib>
 
 namespace ui {
 
@@ -58,6 +67,185 @@ static inline void DrawFunction(SkCanvas* pSkCanvas,
     pSkCanvas->drawImageRect(skImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
 }
 
+/** 九宫格绘制：使用drawImageLattice一次完成绘制（替代逐块绘制）
+*   仅在目标边角与源边角一致、且目标区域能容纳边角时使用，此时与逐块绘制的结果一致
+* @return 如果绘制完成返回true，否则返回false（由调用方按逐块绘制的方式绘制）
+*/
+static inline bool DrawLatticeFunction(SkCanvas* pSkCanvas,
+                                       const UiRect& rcDest,
+                                       const UiRect& rcDestCorners,
+                                       const SkPoint& skPointOrg,
+                                       const sk_sp<SkImage>& skImage,
+                                       const UiRect& rcSrc,
+                                       const UiRect& rcSrcCorners,
+                                       const SkPaint& skPaint)
+{
+    if ((pSkCanvas == nullptr) || (skImage == nullptr)) {
+        return false;
+    }
+    if ((rcDestCorners.left != rcSrcCorners.left) || (rcDestCorners.top != rcSrcCorners.top) ||
+        (rcDestCorners.right != rcSrcCorners.right) || (rcDestCorners.bottom != rcSrcCorners.bottom)) {
+        return false;
+    }
+    if ((rcSrcCorners.left < 0) || (rcSrcCorners.top < 0) || (rcSrcCorners.right < 0) || (rcSrcCorners.bottom < 0)) {
+        return false;
+    }
+    if ((rcSrcCorners.left == 0) && (rcSrcCorners.top == 0) && (rcSrcCorners.right == 0) && (rcSrcCorners.bottom == 0)) {
+        //无边角，不需要九宫格绘制
+        return false;
+    }
+    if ((rcSrc.Width() <= (rcSrcCorners.left + rcSrcCorners.right)) ||
+        (rcSrc.Height() <= (rcSrcCorners.top + rcSrcCorners.bottom))) {
+        //源图片的中间区域为空
+        return false;
+    }
+    if ((rcDest.Width() < (rcDestCorners.left + rcDestCorners.right)) ||
+        (rcDest.Height() < (rcDestCorners.top + rcDestCorners.bottom))) {
+        //目标区域容纳不下边角（drawImageLattice会缩小边角，与逐块绘制的结果不同）
+        return false;
+    }
+    const SkIRect rcSkSrcI = { rcSrc.left, rcSrc.top, rcSrc.right, rcSrc.bottom };
+    if (!SkIRect::MakeWH(skImage->width(), skImage->height()).contains(rcSkSrcI)) {
+        return false;
+    }
+
+    //分割线：固定区域与拉伸区域交替出现，第一个分割线与边界重合时，第一个区域为拉伸区域
+    int xDivs[2] = { 0, 0 };
+    int xCount = 0;
+    xDivs[xCount++] = rcSrc.left + rcSrcCorners.left;
+    if (rcSrcCorners.right > 0) {
+        xDivs[xCount++] = rcSrc.right - rcSrcCorners.right;
+    }
+    int yDivs[2] = { 0, 0 };
+    int yCount = 0;
+    yDivs[yCount++] = rcSrc.top + rcSrcCorners.top;
+    if (rcSrcCorners.bottom > 0) {
+        yDivs[yCount++] = rcSrc.bottom - rcSrcCorners.bottom;
+    }
+
+    SkCanvas::Lattice lattice;
+    lattice.fXDivs = xDivs;
+    lattice.fYDivs = yDivs;
+    lattice.fRectTypes = nullptr;
+    lattice.fXCount = xCount;
+    lattice.fYCount = yCount;
+    lattice.fBounds = &rcSkSrcI;
+    lattice.fColors = nullptr;
+
+    SkIRect rcSkDestI = { rcDest.left, rcDest.top, rcDest.right, rcDest.bottom };
+    SkRect rcSkDest = SkRect::Make(rcSkDestI);
+    rcSkDest.offset(skPointOrg);
+
+    pSkCanvas->drawImageLattice(skImage.get(), lattice, rcSkDest, SkFilterMode::kNearest, &skPaint);
+    return true;
+}
+
+/** 平铺绘制：使用图片着色器（SkTileMode::kRepeat）一次完成绘制（替代逐个平铺单元绘制）
+*   绘制结果与逐个平铺单元绘制一致：图片不拉伸，按nTiledMargin间隔平铺，
+*   fullxtiled/fullytiled为true时，只绘制完整的平铺单元，否则最后一个平铺单元按目标区域裁剪
+* @return 如果绘制完成返回true，否则返回false（由调用方按逐个平铺单元的方式绘制）
+*/
+static inline bool DrawTiledFunction(SkCanvas* pSkCanvas,
+                                     const UiRect& rcDest,
+                                     const SkPoint& skPointOrg,
+                                     const sk_sp<SkImage>& skImage,
+                                     const UiRect& rcSrc,
+                                     bool xtiled, bool ytiled,
+                                     bool fullxtiled, bool fullytiled,
+                                     int32_t nTiledMargin,
+                                     const SkPaint& skPaint)
+{
+    if ((pSkCanvas == nullptr) || (skImage == nullptr) || (nTiledMargin < 0)) {
+        return false;
+    }
+    const int32_t imageWidth = rcSrc.Width();
+    const int32_t imageHeight = rcSrc.Height();
+    if ((imageWidth <= 0) || (imageHeight <= 0)) {
+        return false;
+    }
+    const SkIRect rcSkSrcI = { rcSrc.left, rcSrc.top, rcSrc.right, rcSrc.bottom };
+    if (!SkIRect::MakeWH(skImage->width(), skImage->height()).contains(rcSkSrcI)) {
+        return false;
+    }
+
+    //平铺单元的大小（包含平铺间隔）
+    const int32_t tileWidth = xtiled ? (imageWidth + nTiledMargin) : imageWidth;
+    const int32_t tileHeight = ytiled ? (imageHeight + nTiledMargin) : imageHeight;
+
+    //计算需要填充的目标区域
+    UiRect rcFill = rcDest;
+    if (xtiled) {
+        int32_t nTimes = rcDest.Width() / tileWidth;
+        if (!fullxtiled && ((rcDest.Width() % tileWidth) > 0)) {
+            nTimes += 1;
+        }
+        rcFill.right = std::min(rcDest.right, rcDest.left + nTimes * tileWidth);
+    }
+    else {
+        rcFill.right = rcDest.left + imageWidth;
+    }
+    if (ytiled) {
+        int32_t nTimes = rcDest.Height() / tileHeight;
+        if (!fullytiled && ((rcDest.Height() % tileHeight) > 0)) {
+            nTimes += 1;
+        }
+        rcFill.bottom = std::min(rcDest.bottom, rcDest.top + nTimes * tileHeight);
+    }
+    else {
+        rcFill.bottom = rcDest.top + imageHeight;
+    }
+    if ((rcFill.Width() <= 0) || (rcFill.Height() <= 0)) {
+        //没有完整的平铺单元需要绘制
+        return true;
+    }
+
+    SkMatrix localMatrix = SkMatrix::Translate(SkIntToScalar(rcDest.left) + skPointOrg.fX,
+                                               SkIntToScalar(rcDest.top) + skPointOrg.fY);
+    sk_sp<SkShader> skShader;
+    if ((tileWidth == imageWidth) && (tileHeight == imageHeight) &&
+        (rcSkSrcI == SkIRect::MakeWH(skImage->width(), skImage->height()))) {
+        //平铺整个图片，并且没有平铺间隔：直接使用图片着色器
+        skShader = skImage->makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat, SkSamplingOptions(), &localMatrix);
+    }
+    else {
+        //平铺图片的局部区域，或者有平铺间隔：使用缓存的平铺单元图片生成图片着色器
+        sk_sp<SkImage> skTiledImage = TiledImageCache_Skia::Instance().GetTiledImage(skImage, rcSkSrcI, tileWidth, tileHeight);
+        if (skTiledImage != nullptr) {
+            skShader = skTiledImage->makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat, SkSamplingOptions(), &localMatrix);
+        }
+    }
+    if (skShader == nullptr) {
+        return false;
+    }
+
+    SkPaint skTiledPaint = skPaint;
+    skTiledPaint.setShader(skShader);
+
+    SkIRect rcSkFillI = { rcFill.left, rcFill.top, rcFill.right, rcFill.bottom };
+    SkRect rcSkFill = SkRect::Make(rcSkFillI);
+    rcSkFill.offset(skPointOrg);
+    pSkCanvas->drawRect(rcSkFill, skTiledPaint);
+    return true;
+}
+
+/** 获取源Surface的图片，用于BitBlt/StretchBlt/AlphaBlend等合成操作
+*   光栅模式下，直接引用源Surface的像素数据生成图片（不复制数据，也不会引起源Surface的写时复制）；
+*   其他模式下（比如GPU模式），源与目标是同一个Surface时，或者目标是录制用的Canvas（没有Surface，图片在回放时才使用）时，
+*   使用快照的方式生成图片
+*/
+static inline sk_sp<SkImage> MakeSrcSurfaceImage(SkSurface* skSurface, const SkSurface* skDestSurface)
+{
+    if (skSurface == nullptr) {
+        return nullptr;
+    }
+    SkPixmap pixmap;
+    if ((skDestSurface != nullptr) && (skSurface != skDestSurface) && skSurface->peekPixels(&pixmap)) {
+        //图片仅在本次绘制过程中使用，绘制完成后即释放，所以可以直接引用源Surface的像素数据
+        return SkImages::RasterFromPixmap(pixmap, nullptr, nullptr);
+    }
+    return skSurface->makeImageSnapshot();
+}
+
 Render_Skia::Render_Skia():
     m_saveCount(0)
 {
@@ -330,7 +518,7 @@ bool Render_Skia::BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender*
     if (skSurface == nullptr) {
         return false;
     }
-    sk_sp<SkImage> skSrcImage = skSurface->makeImageSnapshot();
+    sk_sp<SkImage> skSrcImage = MakeSrcSurfaceImage(skSurface, GetSkSurface());
     ASSERT(skSrcImage != nullptr);
     if (skSrcImage == nullptr) {
         return false;
@@ -356,6 +544,64 @@ bool Render_Skia::BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender*
     return false;
 }
 
+bool Render_Skia::ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    PerformanceStat statPerformance(_T("Render_Skia::ScrollRect"));
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return false;
+    }
+    SkPixmap pixmap;
+    if (!skCanvas->peekPixels(&pixmap) || (pixmap.writable_addr() == nullptr) || (pixmap.info().bytesPerPixel() != sizeof(uint32_t))) {
+        //非CPU绘制，不支持直接移动像素
+        return false;
+    }
+    UiRect rcValid = rcScroll;
+    if (!rcValid.Intersect(UiRect(0, 0, pixmap.width(), pixmap.height()))) {
+        return false;
+    }
+    if ((std::abs(dx) >= rcValid.Width()) || (std::abs(dy) >= rcValid.Height())) {
+        //移动后没有可复用的像素
+        return false;
+    }
+    if ((dx == 0) && (dy == 0)) {
+        return true;
+    }
+
+    //源区域和目标区域（都在rcValid范围内）
+    UiRect rcSrc = rcValid;
+    UiRect rcDest = rcValid;
+    if (dx > 0) {
+        rcSrc.right -= dx;
+        rcDest.left += dx;
+    }
+    else {
+        rcSrc.left -= dx;
+        rcDest.right += dx;
+    }
+    if (dy > 0) {
+        rcSrc.bottom -= dy;
+        rcDest.top += dy;
+    }
+    else {
+        rcSrc.top -= dy;
+        rcDest.bottom += dy;
+    }
+    ASSERT((rcSrc.Width() == rcDest.Width()) && (rcSrc.Height() == rcDest.Height()));
+
+    //逐行移动：向下移动时从最后一行开始，避免覆盖未移动的数据；同一行内的重叠由memmove处理
+    const size_t nRowBytes = (size_t)rcSrc.Width() * sizeof(uint32_t);
+    const int32_t nRows = rcSrc.Height();
+    for (int32_t i = 0; i < nRows; ++i) {
+        const int32_t nIndex = (dy > 0) ? (nRows - 1 - i) : i;
+        ::memmove(pixmap.writable_addr32(rcDest.left, rcDest.top + nIndex),
+                  pixmap.addr32(rcSrc.left, rcSrc.top + nIndex),
+                  nRowBytes);
+    }
+    return true;
+}
+
 bool Render_Skia::StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, int32_t heightDest, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, int32_t widthSrc, int32_t heightSrc, RopMode rop)
 {
     ASSERT((GetWidth() > 0) && (GetHeight() > 0));
@@ -374,7 +620,7 @@ bool Render_Skia::StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, in
     if (skSurface == nullptr) {
         return false;
     }
-    sk_sp<SkImage> skSrcImage = skSurface->makeImageSnapshot();
+    sk_sp<SkImage> skSrcImage = MakeSrcSurfaceImage(skSurface, GetSkSurface());
     ASSERT(skSrcImage != nullptr);
     if (skSrcImage == nullptr) {
         return false;
@@ -407,6 +653,7 @@ bool Render_Skia::AlphaBlend(int32_t xDest, int32_t yDest, int32_t widthDest, in
     if (pSrcRender == nullptr) {
         return false;
     }
+    PerformanceStat statPerformance(_T("Render_Skia::AlphaBlend"));
 
     Render_Skia* pSkiaRender = dynamic_cast<Render_Skia*>(pSrcRender);
     ASSERT(pSkiaRender != nullptr);
@@ -418,7 +665,7 @@ bool Render_Skia::AlphaBlend(int32_t xDest, int32_t yDest, int32_t widthDest, in
     if (skSurface == nullptr) {
         return false;
     }
-    sk_sp<SkImage> skSrcImage = skSurface->makeImageSnapshot();
+    sk_sp<SkImage> skSrcImage = MakeSrcSurfaceImage(skSurface, GetSkSurface());
     ASSERT(skSrcImage != nullptr);
     if (skSrcImage == nullptr) {
         return false;
@@ -473,8 +720,10 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     if (skiaBitmap == nullptr) {
         return;
     }
-    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    sk_sp<SkImage> skImage = skSrcBitmap.asImage();//这里是复制了一份位图数据的，有性能损耗
+    sk_sp<SkImage> skImage = skiaBitmap->GetSkImage();//图片是缓存的，位图数据未变化时不会复制
+    if (skImage == nullptr) {
+        return;
+    }
 
     UiRect rcTemp;
     UiRect rcDrawSource;
@@ -488,6 +737,12 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     //默认值就是kSrcOver
     skPaint.setBlendMode(SkBlendMode::kSrcOver);
 
+    if (!xtiled && !ytiled &&
+        DrawLatticeFunction(skCanvas, rcDest, rcDestCorners, *m_pSkPointOrg, skImage, rcSource, rcSourceCorners, skPaint)) {
+        //九宫格绘制已完成
+        return;
+    }
+
     // middle
     rcDrawDest.left = rcDest.left + rcDestCorners.left;
     rcDrawDest.top = rcDest.top + rcDestCorners.top;
@@ -502,6 +757,10 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         if (!xtiled && !ytiled) {
             DrawFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
         }
+        else if (DrawTiledFunction(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource,
+                                   xtiled, ytiled, fullxtiled, fullytiled, nTiledMargin, skPaint)) {
+            //平铺绘制已完成
+        }
         else if (xtiled && ytiled) {
             const int32_t imageDrawWidth = rcSource.right - rcSource.left - rcSourceCorners.left - rcSourceCorners.right;
             const int32_t imageDrawHeight = rcSource.bottom - rcSource.top - rcSourceCorners.top - rcSourceCorners.bottom;
@@ -790,8 +1049,10 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
     if (skiaBitmap == nullptr) {
         return;
     }
-    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    sk_sp<SkImage> skImage = skSrcBitmap.asImage();//这里是复制了一份位图数据的，有性能损耗
+    sk_sp<SkImage> skImage = skiaBitmap->GetSkImage();//图片是缓存的，位图数据未变化时不会复制
+    if (skImage == nullptr) {
+        return;
+    }
 
     bool isMatrixSet = false;
     if (pMatrix != nullptr) {
@@ -1368,67 +1629,50 @@ void Render_Skia::DrawString(const UiRect& textRect,
     SkRect rcSkDest = SkRect::Make(rcSkDestI);
     rcSkDest.offset(*m_pSkPointOrg);
 
-    //设置绘制属性
-    SkTextBox skTextBox;
-    skTextBox.setBox(rcSkDest);
-    if (uFormat & DrawStringFormat::TEXT_SINGLELINE) {
-        //单行文本
-        skTextBox.setLineMode(SkTextBox::kOneLine_Mode);
-    }
-
-    //绘制区域不足时，自动在末尾绘制省略号
-    bool bEndEllipsis = false;
-    if (uFormat & DrawStringFormat::TEXT_END_ELLIPSIS) {
-        bEndEllipsis = true;
-    }
-    skTextBox.setEndEllipsis(bEndEllipsis);
-
-    bool bPathEllipsis = false;
-    if (uFormat & DrawStringFormat::TEXT_PATH_ELLIPSIS) {
-        bPathEllipsis = true;
-    }
-    skTextBox.setPathEllipsis(bPathEllipsis);
-
-    //绘制文字时，不使用裁剪区域（可能会导致文字绘制超出边界）
-    if (uFormat & DrawStringFormat::TEXT_NOCLIP) {
-        skTextBox.setClipBox(false);
-    }
-    //删除线
-    skTextBox.setStrikeOut(pFont->IsStrikeOut());
-    //下划线
-    skTextBox.setUnderline(pFont->IsUnderline());
-
-    if (uFormat & DrawStringFormat::TEXT_CENTER) {
-        //横向对齐：居中对齐
-        skTextBox.setTextAlign(SkTextBox::kCenter_Align);
-    }
-    else if (uFormat & DrawStringFormat::TEXT_RIGHT) {
-        //横向对齐：右对齐
-        skTextBox.setTextAlign(SkTextBox::kRight_Align);
-    }
-    else {
-        //横向对齐：左对齐
-        skTextBox.setTextAlign(SkTextBox::kLeft_Align);
+    //查询排版缓存（排版结果与绘制位置无关，坐标相对于文本区域的左上角）
+    TextLayoutCache_Skia::Key layoutKey;
+    layoutKey.m_type = TextLayoutCache_Skia::LayoutType::kDraw;
+    layoutKey.m_text = strText;
+    layoutKey.m_font = *pSkFont;
+    layoutKey.m_bUnderline = pFont->IsUnderline();
+    layoutKey.m_bStrikeOut = pFont->IsStrikeOut();
+    layoutKey.m_nWidth = textRect.Width();
+    layoutKey.m_nHeight = textRect.Height();
+    layoutKey.m_uFormat = uFormat;
+
+    TextLayoutCache_Skia& layoutCache = TextLayoutCache_Skia::Instance();
+    const TextLayoutCache_Skia::Layout* pLayout = layoutCache.Find(layoutKey);
+    if (pLayout == nullptr) {
+        //设置排版属性，进行排版
+        SkTextBox skTextBox;
+        InitTextBox(skTextBox, SkRect::MakeIWH(textRect.Width(), textRect.Height()), uFormat, pFont);
+        skTextBox.setText((const char*)strText.c_str(),
+                          strText.size() * sizeof(DString::value_type),
+                          textEncoding,
+                          *pSkFont,
+                          skPaint);
+        TextLayoutCache_Skia::Layout layout;
+        layout.m_textBlob = skTextBox.snapshotTextLayout(layout.m_decorationRects);
+        pLayout = layoutCache.Insert(layoutKey, std::move(layout));
+    }
+    ASSERT(pLayout != nullptr);
+    if ((pLayout == nullptr) || ((pLayout->m_textBlob == nullptr) && pLayout->m_decorationRects.empty())) {
+        return;
     }
 
-    if (uFormat & DrawStringFormat::TEXT_VCENTER) {
-        //纵向对齐：居中对齐
-        skTextBox.setSpacingAlign(SkTextBox::kCenter_SpacingAlign);
+    //绘制排版结果
+    SkAutoCanvasRestore autoCanvasRestore(skCanvas, true);
+    if (!(uFormat & DrawStringFormat::TEXT_NOCLIP)) {
+        //设置裁剪区域，避免文字绘制超出边界
+        skCanvas->clipRect(rcSkDest, true);
     }
-    else if (uFormat & DrawStringFormat::TEXT_BOTTOM) {
-        //纵向对齐：下对齐
-        skTextBox.setSpacingAlign(SkTextBox::kEnd_SpacingAlign);
+    skCanvas->translate(rcSkDest.fLeft, rcSkDest.fTop);
+    if (pLayout->m_textBlob != nullptr) {
+        skCanvas->drawTextBlob(pLayout->m_textBlob, 0, 0, skPaint);
     }
-    else {
-        //纵向对齐：上对齐
-        skTextBox.setSpacingAlign(SkTextBox::kStart_SpacingAlign);
+    for (const SkRect& decorationRect : pLayout->m_decorationRects) {
+        skCanvas->drawRect(decorationRect, skPaint);
     }
-    skTextBox.draw(skCanvas, 
-                   (const char*)strText.c_str(), 
-                   strText.size() * sizeof(DString::value_type),
-                   textEncoding, 
-                   *pSkFont,
-                   skPaint);
 }
 
 UiRect Render_Skia::MeasureString(const DString& strText, 
@@ -1468,6 +1712,21 @@ UiRect Render_Skia::MeasureString(const DString& strText,
         return UiRect();
     }
 
+    //查询测量结果缓存
+    TextLayoutCache_Skia::Key layoutKey;
+    layoutKey.m_type = TextLayoutCache_Skia::LayoutType::kMeasure;
+    layoutKey.m_text = strText;
+    layoutKey.m_font = *pSkFont;
+    layoutKey.m_nWidth = width;
+    layoutKey.m_nHeight = 0;
+    layoutKey.m_uFormat = uFormat;
+
+    TextLayoutCache_Skia& layoutCache = TextLayoutCache_Skia::Instance();
+    const TextLayoutCache_Skia::Layout* pLayout = layoutCache.Find(layoutKey);
+    if (pLayout != nullptr) {
+        return pLayout->m_measureRect;
+    }
+
     //绘制属性设置
     SkPaint skPaint = *m_pSkPaint;
 
@@ -1480,6 +1739,7 @@ UiRect Render_Skia::MeasureString(const DString& strText,
     SkFontMetrics fontMetrics;
     SkScalar fontHeight = pSkFont->getMetrics(&fontMetrics);
 
+    UiRect rc;
     if (isSingleLineMode || (width <= 0)) {
         //单行模式, 或者没有限制宽度
         SkScalar textWidth = pSkFont->measureText(strText.c_str(),
@@ -1491,27 +1751,24 @@ UiRect Render_Skia::MeasureString(const DString& strText,
         if (textWidth > textIWidth) {
             textIWidth += 1;
         }
-        if (textIWidth <= 0) {
-            return UiRect();
-        }
-        UiRect rc;
-        rc.left = 0;
-        if (width <= 0) {
-            rc.right = textIWidth;
-        }
-        else if (textIWidth < width) {
-            rc.right = textIWidth;
-        }
-        else {
-            //返回限制宽度
-            rc.right = width;
-        }
-        rc.top = 0;
-        rc.bottom = SkScalarTruncToInt(fontHeight + 0.5f);
-        if (fontHeight > rc.bottom) {
-            rc.bottom += 1;
+        if (textIWidth > 0) {
+            rc.left = 0;
+            if (width <= 0) {
+                rc.right = textIWidth;
+            }
+            else if (textIWidth < width) {
+                rc.right = textIWidth;
+            }
+            else {
+                //返回限制宽度
+                rc.right = width;
+            }
+            rc.top = 0;
+            rc.bottom = SkScalarTruncToInt(fontHeight + 0.5f);
+            if (fontHeight > rc.bottom) {
+                rc.bottom += 1;
+            }
         }
-        return rc;
     }
     else {
         //多行模式，并且限制宽度width为有效值
@@ -1530,7 +1787,6 @@ UiRect Render_Skia::MeasureString(const DString& strText,
         if (lineCount > 0) {
             textHeight += scaledSpacing * (lineCount - 1);
         }
-        UiRect rc;
         rc.left = 0;
         rc.right = width;
         rc.top = 0;
@@ -1538,8 +1794,13 @@ UiRect Render_Skia::MeasureString(const DString& strText,
         if (textHeight > rc.bottom) {
             rc.bottom += 1;
         }
-        return rc;
     }
+
+    //保存到缓存
+    TextLayoutCache_Skia::Layout layout;
+    layout.m_measureRect = rc;
+    layoutCache.Insert(layoutKey, std::move(layout));
+    return rc;
 }
 
 void Render_Skia::MeasureRichText(const UiRect& textRect,
@@ -2716,6 +2977,12 @@ void Render_Skia::DrawTextString(const UiRect& textRect,
 
     //设置绘制属性
     SkTextBox skTextBox;
+    InitTextBox(skTextBox, rcSkDest, uFormat, pFont);
+    skTextBox.draw(skCanvas, text, len, textEncoding, *pSkFont, skPaint);
+}
+
+void Render_Skia::InitTextBox(SkTextBox& skTextBox, const SkRect& rcSkDest, uint32_t uFormat, IFont* pFont) const
+{
     skTextBox.setBox(rcSkDest);
     if (uFormat & DrawStringFormat::TEXT_SINGLELINE) {
         //单行文本
@@ -2739,10 +3006,12 @@ void Render_Skia::DrawTextString(const UiRect& textRect,
     if (uFormat & DrawStringFormat::TEXT_NOCLIP) {
         skTextBox.setClipBox(false);
     }
-    //删除线
-    skTextBox.setStrikeOut(pSkiaFont->IsStrikeOut());
-    //下划线
-    skTextBox.setUnderline(pSkiaFont->IsUnderline());
+    if (pFont != nullptr) {
+        //删除线
+        skTextBox.setStrikeOut(pFont->IsStrikeOut());
+        //下划线
+        skTextBox.setUnderline(pFont->IsUnderline());
+    }
 
     if (uFormat & DrawStringFormat::TEXT_CENTER) {
         //横向对齐：居中对齐
@@ -2769,7 +3038,6 @@ void Render_Skia::DrawTextString(const UiRect& textRect,
         //纵向对齐：上对齐
         skTextBox.setSpacingAlign(SkTextBox::kStart_SpacingAlign);
     }
-    skTextBox.draw(skCanvas, text, len, textEncoding, *pSkFont, skPaint);
 }
 
 void Render_Skia::DrawBoxShadow(const UiRect& rc,
@@ -2822,6 +3090,36 @@ void Render_Skia::DrawBoxShadow(const UiRect& rc,
     excludePath.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY, &skPathExclude);
     skCanvas->clipPath(skPathExclude, SkClipOp::kDifference);
 
+    //优先使用缓存的九宫格阴影图片绘制（阴影区域能容纳九宫格的固定区域时）
+    BoxShadowCache_Skia::ShadowImage shadowImage;
+    BoxShadowCache_Skia::CalcShadowGeometry(roundSize, nBlurRadius, shadowImage);
+    if ((destRc.Width() >= ((shadowImage.m_nCornerX - shadowImage.m_nMargin) * 2 + 1)) &&
+        (destRc.Height() >= ((shadowImage.m_nCornerY - shadowImage.m_nMargin) * 2 + 1)) &&
+        BoxShadowCache_Skia::Instance().GetShadowImage(roundSize, nBlurRadius, dwColor, shadowImage)) {
+        const int32_t nImageWidth = shadowImage.m_skImage->width();
+        const int32_t nImageHeight = shadowImage.m_skImage->height();
+        const int xDivs[2] = { shadowImage.m_nCornerX, nImageWidth - shadowImage.m_nCornerX };
+        const int yDivs[2] = { shadowImage.m_nCornerY, nImageHeight - shadowImage.m_nCornerY };
+        const SkIRect rcBounds = SkIRect::MakeWH(nImageWidth, nImageHeight);
+
+        SkCanvas::Lattice lattice;
+        lattice.fXDivs = xDivs;
+        lattice.fYDivs = yDivs;
+        lattice.fRectTypes = nullptr;
+        lattice.fXCount = 2;
+        lattice.fYCount = 2;
+        lattice.fBounds = &rcBounds;
+        lattice.fColors = nullptr;
+
+        //阴影图片比阴影形状每边多出模糊区域的宽度
+        SkRect rcShadowDest = srcRc.makeOutset((SkScalar)shadowImage.m_nMargin, (SkScalar)shadowImage.m_nMargin);
+        rcShadowDest.offset(m_pSkPointOrg->fX + (SkScalar)cpOffset.x, m_pSkPointOrg->fY + (SkScalar)cpOffset.y);
+
+        SkPaint imagePaint;
+        skCanvas->drawImageLattice(shadowImage.m_skImage.get(), lattice, rcShadowDest, SkFilterMode::kNearest, &imagePaint);
+        return;
+    }
+
     SkPath skPath;
     shadowPath.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY, &skPath);
 
@@ -3019,6 +3317,82 @@ void Render_Skia::SetRenderDpi(const IRenderDpiPtr& spRenderDpi)
     m_spRenderDpi = spRenderDpi;
 }
 
+/** 分块并行绘制时，每个分块的最小高度
+*/
+static constexpr int32_t kMinPaintTileHeight = 32;
+
+/** 分块并行绘制时，每个线程平均分配的分块个数（分块的绘制耗时不均匀，多分几块以便负载均衡）
+*/
+static constexpr int32_t kPaintTilesPerThread = 4;
+
+bool Render_Skia::PaintParallel(const UiRect& rcPaint, int32_t nThreadCount,
+                                const std::function<void(IRender* pRecordRender)>& recordFunc)
+{
+    ASSERT(recordFunc != nullptr);
+    if ((recordFunc == nullptr) || (nThreadCount < 2)) {
+        return false;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return false;
+    }
+    SkPixmap pixmap;
+    if (!skCanvas->peekPixels(&pixmap) || (pixmap.writable_addr() == nullptr)) {
+        //非CPU绘制，不支持
+        return false;
+    }
+    //绘制区域限制在当前的裁剪区域内
+    UiRect rcTotal = rcPaint;
+    const SkIRect rcDeviceClip = skCanvas->getDeviceClipBounds();
+    if (!rcTotal.Intersect(UiRect(rcDeviceClip.fLeft, rcDeviceClip.fTop, rcDeviceClip.fRight, rcDeviceClip.fBottom))) {
+        return true;
+    }
+
+    //录制绘制过程
+    sk_sp<SkPicture> skPicture;
+    {
+        PerformanceStat statPerformance(_T("Render_Skia::PaintParallel(Record)"));
+        Render_Skia_Picture recordRender(GetWidth(), GetHeight(), rcTotal);
+        recordRender.SetRenderDpi(GetRenderDpi());
+        recordRender.SetWindowOrg(GetWindowOrg());
+        recordFunc(&recordRender);
+        skPicture = recordRender.FinishRecording();
+    }
+    if (skPicture == nullptr) {
+        PerformanceUtil::Instance().AddCounter(_T("Render_Skia::PaintParallel(Fallback)"));
+        return false;
+    }
+
+    //按行切分为多个分块：每个分块是连续的内存，相邻分块互不重叠，可以同时写入
+    std::vector<UiRect> tiles;
+    const int32_t nMaxTiles = std::max(rcTotal.Height() / kMinPaintTileHeight, 1);
+    const int32_t nTileCount = std::min(nThreadCount * kPaintTilesPerThread, nMaxTiles);
+    for (int32_t nIndex = 0; nIndex < nTileCount; ++nIndex) {
+        UiRect rcTile = rcTotal;
+        rcTile.top = rcTotal.top + (int32_t)((int64_t)rcTotal.Height() * nIndex / nTileCount);
+        rcTile.bottom = rcTotal.top + (int32_t)((int64_t)rcTotal.Height() * (nIndex + 1) / nTileCount);
+        if (!rcTile.IsEmpty()) {
+            tiles.push_back(rcTile);
+        }
+    }
+
+    //并行回放：每个线程使用独立的Canvas，共享同一块像素数据
+    PerformanceStat statPerformance(_T("Render_Skia::PaintParallel(Playback)"));
+    const SkMatrix skMatrix = skCanvas->getTotalMatrix();
+    ThreadPool::Instance().ParallelFor(tiles.size(), (size_t)nThreadCount, [&](size_t nTileIndex) {
+            std::unique_ptr<SkCanvas> tileCanvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+            if (tileCanvas == nullptr) {
+                return;
+            }
+            const UiRect& rcTile = tiles[nTileIndex];
+            tileCanvas->clipIRect(SkIRect::MakeLTRB(rcTile.left, rcTile.top, rcTile.right, rcTile.bottom));
+            tileCanvas->setMatrix(skMatrix);
+            tileCanvas->drawPicture(skPicture);
+        });
+    return true;
+}
+
 SkTextEncoding Render_Skia::GetTextEncoding() const
 {
     constexpr const size_t nValueLen = sizeof(DString::value_type);
@@ -9,10 +9,12 @@ class SkSurface;
 class SkCanvas;
 struct SkPoint;
 class SkPaint;
+struct SkRect;
 enum class SkTextEncoding;
 
 namespace ui 
 {
+class SkTextBox;
 
 class UILIB_API Render_Skia : public IRender
 {
@@ -49,6 +51,7 @@ public:
     virtual void ClearClip() override;
 
     virtual bool BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, RopMode rop) override;
+    virtual bool ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
     virtual bool StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, int32_t heightDest, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, int32_t widthSrc, int32_t heightSrc, RopMode rop) override;
     virtual bool AlphaBlend(int32_t xDest, int32_t yDest, int32_t widthDest, int32_t heightDest, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, int32_t widthSrc, int32_t heightSrc, uint8_t alpha = 255) override;
 
@@ -162,6 +165,8 @@ public:
     virtual bool IsClipEmpty() const override;
     virtual bool IsEmpty() const override;
     virtual void SetRenderDpi(const IRenderDpiPtr& spRenderDpi) override;
+    virtual bool PaintParallel(const UiRect& rcPaint, int32_t nThreadCount,
+                               const std::function<void(IRender* pRecordRender)>& recordFunc) override;
 
 public:
     /** 获取SkSurface接口
@@ -201,6 +206,14 @@ private:
     void DrawTextString(const UiRect& textRect, const DString& strText, uint32_t uFormat,
                         const SkPaint& skPaint, IFont* pFont) const;
 
+    /** 按文本格式，设置文本绘制的属性
+    * @param [in] skTextBox 需要设置属性的文本对象
+    * @param [in] rcSkDest 文本绘制区域
+    * @param [in] uFormat 文本格式，取值参见：DrawStringFormat
+    * @param [in] pFont 字体接口，用于获取下划线和删除线属性
+    */
+    void InitTextBox(SkTextBox& skTextBox, const SkRect& rcSkDest, uint32_t uFormat, IFont* pFont) const;
+
     /** 绘制格式文本
     */
     void InternalDrawRichText(const UiRect& rcTextRect,
@@ -0,0 +1,178 @@
+#include "Render_Skia_Picture.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+
+#pragma warning (pop)
+
+namespace ui {
+
+Render_Skia_Picture::Render_Skia_Picture(int32_t nWidth, int32_t nHeight, const UiRect& rcBounds):
+    m_pSkCanvas(nullptr),
+    m_nWidth(nWidth),
+    m_nHeight(nHeight),
+    m_bUnsupported(false)
+{
+    m_pRecorder = std::make_unique<SkPictureRecorder>();
+    //使用R-Tree记录每个绘制操作的范围，回放时只执行与分块相交的操作
+    SkRTreeFactory rtreeFactory;
+    SkRect rcSkBounds = SkRect::MakeLTRB((SkScalar)rcBounds.left, (SkScalar)rcBounds.top,
+                                         (SkScalar)rcBounds.right, (SkScalar)rcBounds.bottom);
+    m_pSkCanvas = m_pRecorder->beginRecording(rcSkBounds, &rtreeFactory);
+    ASSERT(m_pSkCanvas != nullptr);
+}
+
+Render_Skia_Picture::~Render_Skia_Picture()
+{
+    m_pSkCanvas = nullptr;
+    m_pRecorder.reset();
+}
+
+sk_sp<SkPicture> Render_Skia_Picture::FinishRecording()
+{
+    if ((m_pSkCanvas == nullptr) || (m_pRecorder == nullptr)) {
+        return nullptr;
+    }
+    m_pSkCanvas = nullptr;
+    sk_sp<SkPicture> skPicture = m_pRecorder->finishRecordingAsPicture();
+    if (m_bUnsupported) {
+        return nullptr;
+    }
+    return skPicture;
+}
+
+void Render_Skia_Picture::SetUnsupported(const DString& opName)
+{
+    if (!m_bUnsupported) {
+        m_bUnsupported = true;
+        PerformanceUtil::Instance().AddCounter(_T("Render_Skia_Picture(Unsupported):") + opName);
+    }
+}
+
+RenderBackendType Render_Skia_Picture::GetRenderBackendType() const
+{
+    return RenderBackendType::kRaster_BackendType;
+}
+
+bool Render_Skia_Picture::Resize(int32_t width, int32_t height)
+{
+    //录制过程中不支持修改大小
+    return (width == m_nWidth) && (height == m_nHeight);
+}
+
+int32_t Render_Skia_Picture::GetWidth() const
+{
+    return m_nWidth;
+}
+
+int32_t Render_Skia_Picture::GetHeight() const
+{
+    return m_nHeight;
+}
+
+std::unique_ptr<IRender> Render_Skia_Picture::Clone()
+{
+    SetUnsupported(_T("Clone"));
+    return nullptr;
+}
+
+bool Render_Skia_Picture::PaintAndSwapBuffers(IRenderPaint* /*pRenderPaint*/)
+{
+    ASSERT(false);
+    return false;
+}
+
+bool Render_Skia_Picture::PaintParallel(const UiRect& /*rcPaint*/, int32_t /*nThreadCount*/,
+                                        const std::function<void(IRender* pRecordRender)>& /*recordFunc*/)
+{
+    //录制过程中不支持嵌套
+    return false;
+}
+
+void Render_Skia_Picture::Clear(const UiColor& /*uiColor*/)
+{
+    //Clear是直接写入像素数据（不受裁剪区域的影响），无法录制
+    SetUnsupported(_T("Clear"));
+}
+
+void Render_Skia_Picture::ClearRect(const UiRect& /*rcDirty*/, const UiColor& /*uiColor*/)
+{
+    SetUnsupported(_T("ClearRect"));
+}
+
+IBitmap* Render_Skia_Picture::MakeImageSnapshot()
+{
+    SetUnsupported(_T("MakeImageSnapshot"));
+    return nullptr;
+}
+
+void Render_Skia_Picture::ClearAlpha(const UiRect& /*rcDirty*/, uint8_t /*alpha*/)
+{
+    SetUnsupported(_T("ClearAlpha"));
+}
+
+void Render_Skia_Picture::RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/, uint8_t /*alpha*/)
+{
+    SetUnsupported(_T("RestoreAlpha"));
+}
+
+void Render_Skia_Picture::RestoreAlpha(const UiRect& /*rcDirty*/, const UiPadding& /*rcShadowPadding*/)
+{
+    SetUnsupported(_T("RestoreAlpha"));
+}
+
+bool Render_Skia_Picture::ScrollRect(const UiRect& /*rcScroll*/, int32_t /*dx*/, int32_t /*dy*/)
+{
+    SetUnsupported(_T("ScrollRect"));
+    return false;
+}
+
+bool Render_Skia_Picture::ReadPixels(const UiRect& /*rc*/, void* /*dstPixels*/, size_t /*dstPixelsLen*/)
+{
+    SetUnsupported(_T("ReadPixels"));
+    return false;
+}
+
+bool Render_Skia_Picture::WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/)
+{
+    SetUnsupported(_T("WritePixels"));
+    return false;
+}
+
+bool Render_Skia_Picture::WritePixels(void* /*srcPixels*/, size_t /*srcPixelsLen*/, const UiRect& /*rc*/, const UiRect& /*rcPaint*/)
+{
+    SetUnsupported(_T("WritePixels"));
+    return false;
+}
+
+SkSurface* Render_Skia_Picture::GetSkSurface() const
+{
+    return nullptr;
+}
+
+SkCanvas* Render_Skia_Picture::GetSkCanvas() const
+{
+    return m_pSkCanvas;
+}
+
+#ifdef DUILIB_BUILD_FOR_WIN
+
+HDC Render_Skia_Picture::GetRenderDC(HWND /*hWnd*/)
+{
+    SetUnsupported(_T("GetRenderDC"));
+    return nullptr;
+}
+
+void Render_Skia_Picture::ReleaseRenderDC(HDC /*hdc*/)
+{
+}
+
+#endif
+
+} // namespace ui
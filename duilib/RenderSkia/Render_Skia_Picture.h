@@ -0,0 +1,102 @@
+#ifndef UI_RENDER_SKIA_RENDER_PICTURE_H_
+#define UI_RENDER_SKIA_RENDER_PICTURE_H_
+
+#include "duilib/RenderSkia/Render_Skia.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201)
+
+#include "include/core/SkRefCnt.h"
+
+#pragma warning (pop)
+
+//Skia相关类的前置声明
+class SkPicture;
+class SkPictureRecorder;
+
+namespace ui
+{
+/** 录制绘制过程的Render（用于分块并行绘制）
+*   所有绘制操作被录制为SkPicture，录制完成后可以在多个线程中并行回放；
+*   直接读写像素的操作（ReadPixels/WritePixels/ClearAlpha/GetRenderDC等）无法录制，
+*   调用后录制结果作废，由调用方改为普通方式绘制
+*/
+class UILIB_API Render_Skia_Picture: public Render_Skia
+{
+public:
+    /** 构造函数
+    * @param [in] nWidth 画布宽度（与回放的目标Render一致）
+    * @param [in] nHeight 画布高度（与回放的目标Render一致）
+    * @param [in] rcBounds 录制的范围，超出此范围的绘制操作不录制
+    */
+    Render_Skia_Picture(int32_t nWidth, int32_t nHeight, const UiRect& rcBounds);
+    Render_Skia_Picture(const Render_Skia_Picture& r) = delete;
+    Render_Skia_Picture& operator = (const Render_Skia_Picture& r) = delete;
+    virtual ~Render_Skia_Picture() override;
+
+    /** 结束录制
+    * @return 返回录制结果；如果录制过程中使用了无法录制的操作，返回nullptr
+    */
+    sk_sp<SkPicture> FinishRecording();
+
+public:
+    virtual RenderBackendType GetRenderBackendType() const override;
+    virtual bool Resize(int32_t width, int32_t height) override;
+    virtual int32_t GetWidth() const override;
+    virtual int32_t GetHeight() const override;
+    virtual std::unique_ptr<IRender> Clone() override;
+    virtual bool PaintAndSwapBuffers(IRenderPaint* pRenderPaint) override;
+    virtual bool PaintParallel(const UiRect& rcPaint, int32_t nThreadCount,
+                               const std::function<void(IRender* pRecordRender)>& recordFunc) override;
+
+    virtual void Clear(const UiColor& uiColor) override;
+    virtual void ClearRect(const UiRect& rcDirty, const UiColor& uiColor) override;
+    virtual IBitmap* MakeImageSnapshot() override;
+    virtual void ClearAlpha(const UiRect& rcDirty, uint8_t alpha = 0) override;
+    virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha) override;
+    virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding = UiPadding()) override;
+    virtual bool ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
+    virtual bool ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixelsLen) override;
+    virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc) override;
+    virtual bool WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect& rc, const UiRect& rcPaint) override;
+
+    /** 获取SkSurface接口（录制时没有Surface，返回nullptr）
+    */
+    virtual SkSurface* GetSkSurface() const override;
+
+    /** 获取SkCanvas接口（录制使用的Canvas）
+    */
+    virtual SkCanvas* GetSkCanvas() const override;
+
+private:
+#ifdef DUILIB_BUILD_FOR_WIN
+    virtual HDC GetRenderDC(HWND hWnd) override;
+    virtual void ReleaseRenderDC(HDC hdc) override;
+#endif
+
+    /** 使用了无法录制的操作
+    */
+    void SetUnsupported(const DString& opName);
+
+private:
+    /** 录制对象
+    */
+    std::unique_ptr<SkPictureRecorder> m_pRecorder;
+
+    /** 录制使用的Canvas（由m_pRecorder管理）
+    */
+    SkCanvas* m_pSkCanvas;
+
+    /** 画布宽度和高度
+    */
+    int32_t m_nWidth;
+    int32_t m_nHeight;
+
+    /** 是否使用了无法录制的操作
+    */
+    bool m_bUnsupported;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_RENDER_PICTURE_H_
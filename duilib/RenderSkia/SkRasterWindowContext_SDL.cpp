@@ -1,17 +1,26 @@
 #include "SkRasterWindowContext_SDL.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/PixelUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
 
 #include <SDL3/SDL.h>
 
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100 4267)
+
+#include "include/core/SkSwizzle.h"
+
+#pragma warning (pop)
+
 namespace ui {
 
 SkRasterWindowContext_SDL::SkRasterWindowContext_SDL(SDL_Window* sdlWindow, std::unique_ptr<const skwindow::DisplayParams> params):
     skwindow::internal::RasterWindowContext(std::move(params)),
     m_sdlWindow(sdlWindow),
-    m_sdlTextrue(nullptr)
+    m_sdlTextrue(nullptr),
+    m_pWindowSurfacePixels(nullptr)
 {
     fWidth = 0;
     fHeight = 0;
@@ -60,8 +69,10 @@ void SkRasterWindowContext_SDL::resize(int nWidth, int nHeight)
     fWidth = nWidth;
     fHeight = nHeight;
 
+    //大小变化后，恢复为使用自己的后台缓冲区，绘制时再检查是否可以直接绘制到窗口的Surface
     m_fSurfaceMemory.reset();
     m_fBackbufferSurface.reset();
+    m_pWindowSurfacePixels = nullptr;
     
     if ((nWidth == 0) || (nHeight == 0)) {
         return;
@@ -73,9 +84,7 @@ void SkRasterWindowContext_SDL::resize(int nWidth, int nHeight)
     if (pixels == nullptr) {
         return;
     }
-
-    SkImageInfo info = SkImageInfo::Make(nWidth, nHeight, pDisplayParams->colorType(), SkAlphaType::kPremul_SkAlphaType, pDisplayParams->colorSpace());
-    m_fBackbufferSurface = SkSurfaces::WrapPixels(info, pixels, sizeof(uint32_t) * nWidth);
+    WrapBackbufferPixels(pixels);
 
     if (m_sdlTextrue != nullptr) {
         SDL_DestroyTexture(m_sdlTextrue);
@@ -83,6 +92,127 @@ void SkRasterWindowContext_SDL::resize(int nWidth, int nHeight)
     }
 }
 
+bool SkRasterWindowContext_SDL::WrapBackbufferPixels(void* pixels)
+{
+    const skwindow::DisplayParams* pDisplayParams = getDisplayParams();
+    ASSERT((pDisplayParams != nullptr) && (pixels != nullptr));
+    if ((pDisplayParams == nullptr) || (pixels == nullptr)) {
+        m_fBackbufferSurface.reset();
+        return false;
+    }
+    SkImageInfo info = SkImageInfo::Make(width(), height(), pDisplayParams->colorType(), SkAlphaType::kPremul_SkAlphaType, pDisplayParams->colorSpace());
+    m_fBackbufferSurface = SkSurfaces::WrapPixels(info, pixels, sizeof(uint32_t) * width());
+    ASSERT(m_fBackbufferSurface != nullptr);
+    return m_fBackbufferSurface != nullptr;
+}
+
+SDL_Surface* SkRasterWindowContext_SDL::GetMatchedWindowSurface(uint8_t nLayeredWindowAlpha) const
+{
+    if ((m_sdlWindow == nullptr) || (nLayeredWindowAlpha != 255)) {
+        //需要处理窗口透明度时，不能直接修改后台缓冲区的数据
+        return nullptr;
+    }
+    const skwindow::DisplayParams* pDisplayParams = getDisplayParams();
+    if (pDisplayParams == nullptr) {
+        return nullptr;
+    }
+    SDL_Surface* sdlSurface = SDL_GetWindowSurface(m_sdlWindow);
+    if ((sdlSurface == nullptr) || (sdlSurface->pixels == nullptr) ||
+        (sdlSurface->w != width()) || (sdlSurface->h != height()) || (sdlSurface->pitch != width() * sizeof(uint32_t))) {
+        //大小不匹配
+        return nullptr;
+    }
+    int32_t backR = -1;
+    int32_t backG = -1;
+    int32_t backB = -1;
+    int32_t backA = -1;
+    int32_t sdlR = -1;
+    int32_t sdlG = -1;
+    int32_t sdlB = -1;
+    int32_t sdlA = -1;
+    if (!GetSkiaColorByteOrder(pDisplayParams->colorType(), backR, backG, backB, backA) ||
+        !GetSDLColorByteOrder(sdlSurface->format, sdlR, sdlG, sdlB, sdlA)) {
+        return nullptr;
+    }
+    if ((backR != sdlR) || (backG != sdlG) || (backB != sdlB) || (backA != sdlA)) {
+        //颜色格式不同
+        return nullptr;
+    }
+    return sdlSurface;
+}
+
+bool SkRasterWindowContext_SDL::UpdateBackbufferMode(uint8_t nLayeredWindowAlpha)
+{
+    if ((width() <= 0) || (height() <= 0)) {
+        return true;
+    }
+    const size_t nBufferSize = (size_t)width() * height() * sizeof(uint32_t);
+    SDL_Surface* sdlSurface = GetMatchedWindowSurface(nLayeredWindowAlpha);
+    if (m_pWindowSurfacePixels != nullptr) {
+        //当前为零拷贝模式
+        if ((sdlSurface != nullptr) && (sdlSurface->pixels == m_pWindowSurfacePixels)) {
+            //窗口的Surface未发生变化
+            return true;
+        }
+        if (sdlSurface != nullptr) {
+            //窗口的Surface已经重建，原数据已经丢失，直接使用新的Surface
+            m_pWindowSurfacePixels = sdlSurface->pixels;
+            WrapBackbufferPixels(m_pWindowSurfacePixels);
+            return false;
+        }
+        //不再满足零拷贝的条件，恢复使用自己的后台缓冲区
+        m_fSurfaceMemory.reset(nBufferSize);
+        if (m_fSurfaceMemory.get() == nullptr) {
+            m_pWindowSurfacePixels = nullptr;
+            m_fBackbufferSurface.reset();
+            return false;
+        }
+        SDL_Surface* sdlWindowSurface = SDL_GetWindowSurface(m_sdlWindow);
+        const bool bContentKept = (sdlWindowSurface != nullptr) && (sdlWindowSurface->pixels == m_pWindowSurfacePixels);
+        if (bContentKept) {
+            //窗口的Surface未重建，保留原来的数据
+            ::memcpy(m_fSurfaceMemory.get(), m_pWindowSurfacePixels, nBufferSize);
+        }
+        m_pWindowSurfacePixels = nullptr;
+        WrapBackbufferPixels(m_fSurfaceMemory.get());
+        return bContentKept;
+    }
+    else if (sdlSurface != nullptr) {
+        //满足零拷贝的条件：后台缓冲区直接使用窗口Surface的数据，绘制后无需复制数据
+        if (m_fSurfaceMemory.get() != nullptr) {
+            ::memcpy(sdlSurface->pixels, m_fSurfaceMemory.get(), nBufferSize);
+        }
+        m_pWindowSurfacePixels = sdlSurface->pixels;
+        WrapBackbufferPixels(m_pWindowSurfacePixels);
+        m_fSurfaceMemory.reset();
+        return true;
+    }
+    return true;
+}
+
+bool SkRasterWindowContext_SDL::SwapWindowSurface(const std::vector<UiRect>& paintRects)
+{
+    PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapWindowSurface"));
+    ASSERT((m_sdlWindow != nullptr) && (m_pWindowSurfacePixels != nullptr));
+    if ((m_sdlWindow == nullptr) || (m_pWindowSurfacePixels == nullptr) || paintRects.empty()) {
+        return false;
+    }
+    if (IsFullPaint(paintRects)) {
+        return SDL_UpdateWindowSurface(m_sdlWindow);
+    }
+    std::vector<SDL_Rect> sdlRects;
+    sdlRects.reserve(paintRects.size());
+    for (const UiRect& rcPaint : paintRects) {
+        SDL_Rect rect;
+        rect.x = rcPaint.left;
+        rect.y = rcPaint.top;
+        rect.w = rcPaint.Width();
+        rect.h = rcPaint.Height();
+        sdlRects.push_back(rect);
+    }
+    return SDL_UpdateWindowSurfaceRects(m_sdlWindow, sdlRects.data(), (int)sdlRects.size());
+}
+
 sk_sp<SkSurface> SkRasterWindowContext_SDL::getBackbufferSurface()
 {
     return m_fBackbufferSurface;
@@ -111,62 +241,97 @@ bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPai
         return false;
     }
 
-    //获取需要绘制的区域
-    UiRect rcPaint;
-    bool bUpdateRect = pRenderPaint->GetUpdateRect(rcPaint); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
-    if (bUpdateRect && !rcPaint.IsEmpty()) {
+    //获取需要绘制的区域（可能由多个矩形组成，每个矩形分别绘制）
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    std::vector<UiRect> paintRects;
+    bool bUpdateRect = pRenderPaint->GetUpdateRects(paintRects); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
+    if (bUpdateRect) {
         //确保区域的有效性
-        UiRect rcClient;
-        GetClientRect(rcClient);
-        rcPaint.Intersect(rcClient);
+        std::vector<UiRect> updateRects;
+        updateRects.swap(paintRects);
+        for (UiRect rcPaint : updateRects) {
+            if (rcPaint.Intersect(rcClient)) {
+                paintRects.push_back(rcPaint);
+            }
+        }
     }
-    if (rcPaint.IsEmpty()) {
+    if (paintRects.empty()) {
         //不支持局部绘制，每次都是需要重绘整个窗口的客户区域
-        GetClientRect(rcPaint);
-    }
-    if (rcPaint.IsEmpty()) {
-        //无需绘制
-        return false;
+        if (rcClient.IsEmpty()) {
+            //无需绘制
+            return false;
+        }
+        paintRects.push_back(rcClient);
     }
 
     //窗口透明度
     uint8_t nLayeredWindowAlpha = pRenderPaint->GetLayeredWindowAlpha();
 
-    //是否为完全绘制
-    const bool bFullPaint = (rcPaint.Width() == width()) && (rcPaint.Height() == height());
-    SkCanvas* skCanvas = nullptr;
-    if (!bFullPaint) {
-        //使用裁剪区域，避免绘制其他无关区域的数据
-        skCanvas = m_fBackbufferSurface->getCanvas();
-        if (skCanvas != nullptr) {
+    //检查是否可以直接绘制到窗口的Surface（零拷贝模式），如果后台缓冲区的数据丢失，需要完整绘制
+    if (!UpdateBackbufferMode(nLayeredWindowAlpha)) {
+        paintRects.clear();
+        paintRects.push_back(rcClient);
+    }
+    if (m_fBackbufferSurface == nullptr) {
+        return false;
+    }
+
+    //执行绘制：每个区域分别设置裁剪区域后绘制，避免绘制其他无关区域的数据
+    bool bRet = false;
+    SkCanvas* skCanvas = m_fBackbufferSurface->getCanvas();
+    for (const UiRect& rcPaint : paintRects) {
+        //是否为完全绘制
+        const bool bFullPaint = (rcPaint.Width() == width()) && (rcPaint.Height() == height());
+        const bool bClip = !bFullPaint && (skCanvas != nullptr);
+        if (bClip) {
             skCanvas->save();
             skCanvas->clipIRect(SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom));
         }
+        if (pRenderPaint->DoPaint(rcPaint)) {
+            bRet = true;
+        }
+        if (bClip) {
+            skCanvas->restore();
+        }
     }
 
-    //执行绘制
-    bool bRet = pRenderPaint->DoPaint(rcPaint);
     if (bRet) {
+        //需要更新到窗口的区域：绘制的区域 + 滚动时已经移动过像素的区域
+        std::vector<UiRect> swapRects = paintRects;
+        if (!IsFullPaint(paintRects)) {
+            std::vector<UiRect> scrolledRects;
+            pRenderPaint->GetScrolledRects(scrolledRects);
+            for (UiRect rcScrolled : scrolledRects) {
+                if (rcScrolled.Intersect(rcClient)) {
+                    swapRects.push_back(rcScrolled);
+                }
+            }
+        }
         //绘制完成后，更新到窗口
-        SwapPaintBuffers(rcPaint, nLayeredWindowAlpha);
+        if (m_pWindowSurfacePixels != nullptr) {
+            //零拷贝模式：已经直接绘制到窗口的Surface，只需要提交更新的区域
+            SwapWindowSurface(swapRects);
+        }
+        else {
+            SwapPaintBuffers(swapRects, nLayeredWindowAlpha);
+        }
     }
 
     //绘制完成后，将已经绘制的区域标记为有效区域
     if (bUpdateRect) {
-        ValidateRect(rcPaint);
-    }
-
-    if (skCanvas != nullptr) {
-        skCanvas->restore();
+        for (UiRect& rcPaint : paintRects) {
+            ValidateRect(rcPaint);
+        }
     }
     return bRet;
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffers(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha)
 {
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!paintRects.empty());
+    if (paintRects.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -182,7 +347,7 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
         return false;
     }
 
-    if (SwapPaintBuffersFast(rcPaint, nLayeredWindowAlpha)) {
+    if (SwapPaintBuffersFast(paintRects, nLayeredWindowAlpha)) {
         //直接通过窗口的Surface更新绘制数据到窗口设备(不使用GPU，速度更快)
         return true;
     }
@@ -210,20 +375,19 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
 
     //将界面数据复制到纹理
     bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();        
-        SkIRect bounds = SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom);
-        sk_sp<SkImage> snapshotImage = m_fBackbufferSurface->makeImageSnapshot(bounds);
-        if (snapshotImage != nullptr) {
-            SkPixmap pixmap;
-            if (snapshotImage->peekPixels(&pixmap) && (pixmap.addr() != nullptr) && (pixmap.width() == rcPaint.Width()) && (pixmap.height() == rcPaint.Height())) {
-                SDL_UpdateTexture(m_sdlTextrue, &rect, pixmap.addr(), (int)pixmap.rowBytes());
-                bDrawOk = true;
+    if (!IsFullPaint(paintRects)) {
+        //局部绘制：只更新绘制的部分
+        bDrawOk = true;
+        for (const UiRect& rcPaint : paintRects) {
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            const uint32_t* pPixels = (const uint32_t*)m_fSurfaceMemory.get() + rcPaint.top * width() + rcPaint.left;
+            if (!SDL_UpdateTexture(m_sdlTextrue, &rect, pPixels, width() * sizeof(uint32_t))) {
+                bDrawOk = false;
+                break;
             }
         }
         ASSERT(bDrawOk);
@@ -248,10 +412,10 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
     return true;
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha)
 {
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!paintRects.empty());
+    if (paintRects.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -299,39 +463,56 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffersFast"));
 
     bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();
-        //按行复制数据(每次复制1行数据)
-        const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-        const int32_t nWidth = rcPaint.Width();
-        for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-            ::memcpy((uint32_t*)sdlSurface->pixels + nRow * sdlSurface->w + rcPaint.left,
-                     (uint32_t*)m_fSurfaceMemory.get() + nRow * sdlSurface->w + rcPaint.left,
-                     nWidth * sizeof(uint32_t));
-        }
+    if (!IsFullPaint(paintRects)) {
+        //局部绘制：只绘制更新的部分，所有区域一次提交到窗口
+        std::vector<SDL_Rect> sdlRects;
+        sdlRects.reserve(paintRects.size());
+        const int32_t nWidth = sdlSurface->w;
+        for (const UiRect& rcPaint : paintRects) {
+            //按行复制数据(每次复制1行数据)
+            const int32_t nMaxRow = rcPaint.bottom;
+            const int32_t nRowWidth = rcPaint.Width();
+            for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
+                ::memcpy((uint32_t*)sdlSurface->pixels + nRow * nWidth + rcPaint.left,
+                         (uint32_t*)m_fSurfaceMemory.get() + nRow * nWidth + rcPaint.left,
+                         nRowWidth * sizeof(uint32_t));
+            }
 
-        //处理颜色顺序
-        UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
-        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
-        SDL_UpdateWindowSurfaceRects(m_sdlWindow, &rect, 1);
+            //处理颜色顺序
+            UpdateColorByteOrder(sdlSurface->pixels, nWidth, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
+            UpdateColorAlpha(sdlSurface->pixels, nWidth, rcPaint, nLayeredWindowAlpha);
+
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            sdlRects.push_back(rect);
+        }
+        SDL_UpdateWindowSurfaceRects(m_sdlWindow, sdlRects.data(), (int)sdlRects.size());
         bDrawOk = true;
-        ASSERT(bDrawOk);
     }
     if (!bDrawOk) {
         //完整绘制
+        const UiRect rcPaint(0, 0, width(), height());
         ::memcpy(sdlSurface->pixels, m_fSurfaceMemory.get(), sdlSurface->h * sdlSurface->pitch);
         UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
-        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
+        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha);
         SDL_UpdateWindowSurface(m_sdlWindow);
     }
     return true;
 }
 
+bool SkRasterWindowContext_SDL::IsFullPaint(const std::vector<UiRect>& paintRects) const
+{
+    for (const UiRect& rcPaint : paintRects) {
+        if ((rcPaint.Width() == width()) && (rcPaint.Height() == height())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool SkRasterWindowContext_SDL::GetSkiaColorByteOrder(SkColorType backSurfaceColorType, int32_t& backR, int32_t& backG, int32_t& backB, int32_t& backA) const
 {
     if (backSurfaceColorType == kBGRA_8888_SkColorType) {
@@ -411,48 +592,52 @@ void SkRasterWindowContext_SDL::UpdateColorByteOrder(void* surfacePixels, int32_
         //颜色格式相同，无需更新颜色数据
         return;
     }
-    uint32_t colorValue = 0;
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
     const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            colorValue = *pColorValue;
-            if (bDiffR) {
-                ((uint8_t*)pColorValue)[sdlR] = ((uint8_t*)&colorValue)[backR];
-            }
-            if (bDiffG) {
-                ((uint8_t*)pColorValue)[sdlG] = ((uint8_t*)&colorValue)[backG];
-            }
-            if (bDiffB) {
-                ((uint8_t*)pColorValue)[sdlB] = ((uint8_t*)&colorValue)[backB];
-            }
-            if (bDiffA) {
-                ((uint8_t*)pColorValue)[sdlA] = ((uint8_t*)&colorValue)[backA];
+    const int32_t nHeight = rcPaint.Height();
+    uint32_t* pRowPixels = (uint32_t*)surfacePixels + rcPaint.top * nSurfaceWidth + rcPaint.left;
+    if (!bDiffG && !bDiffA && (sdlR == backB) && (sdlB == backR)) {
+        //只交换R和B通道（RGBA与BGRA互转，最常见的情况）：使用Skia的SIMD实现（运行时选择SSSE3/AVX2/NEON等指令集）
+        if (nWidth == nSurfaceWidth) {
+            //各行数据连续，一次完成
+            SkSwapRB(pRowPixels, pRowPixels, nWidth * nHeight);
+        }
+        else {
+            for (int32_t nRow = 0; nRow < nHeight; ++nRow, pRowPixels += nSurfaceWidth) {
+                SkSwapRB(pRowPixels, pRowPixels, nWidth);
             }
         }
+        return;
+    }
+
+    //其他颜色顺序：逐个像素转换
+    uint32_t colorValue = 0;
+    for (int32_t nRow = 0; nRow < nHeight; ++nRow, pRowPixels += nSurfaceWidth) {
+        uint8_t* pColorValue = (uint8_t*)pRowPixels;
+        for (int32_t nCol = 0; nCol < nWidth; ++nCol, pColorValue += sizeof(uint32_t)) {
+            ::memcpy(&colorValue, pColorValue, sizeof(uint32_t));
+            pColorValue[sdlR] = ((uint8_t*)&colorValue)[backR];
+            pColorValue[sdlG] = ((uint8_t*)&colorValue)[backG];
+            pColorValue[sdlB] = ((uint8_t*)&colorValue)[backB];
+            pColorValue[sdlA] = ((uint8_t*)&colorValue)[backA];
+        }
     }
 }
 
-void SkRasterWindowContext_SDL::UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha,
-                                                 int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA)
+void SkRasterWindowContext_SDL::UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha) const
 {
     if ((surfacePixels == nullptr) || (nSurfaceWidth < 1) || rcPaint.IsEmpty() || (nLayeredWindowAlpha == 255)) {
         return;
     }
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
     const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            uint8_t& r = ((uint8_t*)pColorValue)[sdlR];
-            uint8_t& g = ((uint8_t*)pColorValue)[sdlG];
-            uint8_t& b = ((uint8_t*)pColorValue)[sdlB];
-            uint8_t& a = ((uint8_t*)pColorValue)[sdlA];
-            r = r * nLayeredWindowAlpha / 255;
-            g = g * nLayeredWindowAlpha / 255;
-            b = b * nLayeredWindowAlpha / 255;
-            a = a * nLayeredWindowAlpha / 255;
+    const int32_t nHeight = rcPaint.Height();
+    uint32_t* pRowPixels = (uint32_t*)surfacePixels + rcPaint.top * nSurfaceWidth + rcPaint.left;
+    if (nWidth == nSurfaceWidth) {
+        //各行数据连续，一次完成（结果为 x * nLayeredWindowAlpha / 255 四舍五入）
+        PixelUtil::ScaleAlpha(pRowPixels, (size_t)nWidth * nHeight, nLayeredWindowAlpha);
+    }
+    else {
+        for (int32_t nRow = 0; nRow < nHeight; ++nRow, pRowPixels += nSurfaceWidth) {
+            PixelUtil::ScaleAlpha(pRowPixels, (size_t)nWidth, nLayeredWindowAlpha);
         }
     }
 }
@@ -21,9 +21,12 @@
 
 #pragma warning (pop)
 
+#include <vector>
+
 //SDL的类型，提前声明
 struct SDL_Window;
 struct SDL_Texture;
+struct SDL_Surface;
 
 namespace ui 
 {
@@ -59,22 +62,43 @@ protected:
     virtual void onSwapBuffers() override;
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
+    * @param [in] paintRects 绘制的区域（多个矩形）
     * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffers(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha);
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口(直接通过窗口的Surface更新绘制数据到窗口设备)
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
+    * @param [in] paintRects 绘制的区域（多个矩形，通过SDL_UpdateWindowSurfaceRects一次提交）
     * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffersFast(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha);
+
+    /** 零拷贝模式下，绘制结束后，将绘制的区域提交到窗口（后台缓冲区就是窗口的Surface，无需复制数据）
+    * @param [in] paintRects 绘制的区域（多个矩形）
+    */
+    bool SwapWindowSurface(const std::vector<UiRect>& paintRects);
+
+    /** 绘制前检查并切换后台缓冲区的模式：
+    *   当窗口Surface的大小和颜色格式与后台缓冲区一致，并且无需处理窗口透明度时，后台缓冲区直接使用窗口Surface的数据（零拷贝模式）；
+    *   否则使用自己的后台缓冲区，绘制后复制到窗口
+    * @param [in] nLayeredWindowAlpha 窗口透明度
+    * @return 如果后台缓冲区原有的数据得以保留返回true；如果原数据已丢失（需要完整绘制）返回false
+    */
+    bool UpdateBackbufferMode(uint8_t nLayeredWindowAlpha);
+
+    /** 获取可直接作为后台缓冲区的窗口Surface（大小、颜色格式一致，并且窗口不透明），不满足条件时返回nullptr
+    */
+    SDL_Surface* GetMatchedWindowSurface(uint8_t nLayeredWindowAlpha) const;
+
+    /** 使用指定的像素数据创建后台缓冲区的Surface接口
+    */
+    bool WrapBackbufferPixels(void* pixels);
+
+    /** 判断绘制区域是否覆盖整个窗口
+    */
+    bool IsFullPaint(const std::vector<UiRect>& paintRects) const;
 
     /** 获取当前窗口的客户区矩形
     * @param [out] rcClient 返回窗口的客户区坐标
@@ -98,16 +122,15 @@ private:
     */
     int32_t GetColorByteOrder(uint32_t mask) const;
 
-    /** 更新颜值的顺序
+    /** 更新颜值的顺序（R和B通道互换时使用SIMD指令）
     */
     void UpdateColorByteOrder(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint,
                               int32_t backR, int32_t backG, int32_t backB, int32_t backA,
                               int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA) const;
 
-    /** 更新颜色中的Alpha值
+    /** 更新颜色中的Alpha值（4个通道均乘以窗口透明度，使用SIMD指令）
     */
-    void UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha,
-                          int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA);
+    void UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha) const;
 
 private:
     /** Surface数据
@@ -125,6 +148,10 @@ private:
     /** SDL绘制的Texture
     */
     SDL_Texture* m_sdlTextrue;
+
+    /** 零拷贝模式下，后台缓冲区使用的窗口Surface像素数据（为nullptr表示使用自己的后台缓冲区m_fSurfaceMemory）
+    */
+    void* m_pWindowSurfacePixels;
 };
 
 } // namespace ui
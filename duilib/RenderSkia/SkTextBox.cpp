@@ -556,8 +556,62 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
     return false;
 }
 
-static void TextBox_DrawText(SkTextBox* textBox, 
-                             SkCanvas* canvas,
+/** 文字绘制的输出接口：可以直接绘制到SkCanvas，也可以记录下来（生成SkTextBlob）
+*/
+class TextBoxSink {
+public:
+    virtual ~TextBoxSink() {}
+    virtual void drawSimpleText(const char text[], size_t length, SkTextEncoding textEncoding,
+                                SkScalar x, SkScalar y,
+                                const SkFont& font, const SkPaint& paint) = 0;
+    virtual void drawRect(const SkRect& r, const SkPaint& paint) = 0;
+};
+
+/** 直接绘制到SkCanvas
+*/
+class CanvasTextBoxSink : public TextBoxSink {
+    SkCanvas* fCanvas;
+public:
+    explicit CanvasTextBoxSink(SkCanvas* canvas): fCanvas(canvas) {}
+
+    void drawSimpleText(const char text[], size_t length, SkTextEncoding textEncoding,
+                        SkScalar x, SkScalar y,
+                        const SkFont& font, const SkPaint& paint) override {
+        fCanvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+    }
+    void drawRect(const SkRect& r, const SkPaint& paint) override {
+        fCanvas->drawRect(r, paint);
+    }
+};
+
+/** 记录绘制结果：文字生成SkTextBlob，下划线和删除线记录为矩形
+*/
+class LayoutTextBoxSink : public TextBoxSink {
+public:
+    SkTextBlobBuilder fBuilder;
+    std::vector<SkRect>* fDecorationRects;
+
+    explicit LayoutTextBoxSink(std::vector<SkRect>* decorationRects): fDecorationRects(decorationRects) {}
+
+    void drawSimpleText(const char text[], size_t length, SkTextEncoding textEncoding,
+                        SkScalar x, SkScalar y,
+                        const SkFont& font, const SkPaint& /*paint*/) override {
+        const int count = font.countText(text, length, textEncoding);
+        if (count <= 0) {
+            return;
+        }
+        SkTextBlobBuilder::RunBuffer runBuffer = fBuilder.allocRun(font, count, x, y);
+        font.textToGlyphs(text, length, textEncoding, runBuffer.glyphs, count);
+    }
+    void drawRect(const SkRect& r, const SkPaint& /*paint*/) override {
+        if (fDecorationRects != nullptr) {
+            fDecorationRects->push_back(r);
+        }
+    }
+};
+
+static void TextBox_DrawText(const SkTextBox* textBox, 
+                             TextBoxSink* canvas,
                              const char text[], size_t length, SkTextEncoding textEncoding, 
                              SkScalar x, SkScalar y,
                              const SkFont& font, const SkPaint& paint,
@@ -668,10 +722,10 @@ static void TextBox_DrawText(SkTextBox* textBox,
 ///////////////////////////////////////////////////////////////////////////////
 
 class CanvasVisitor : public SkTextBox::Visitor {
-    SkCanvas* fCanvas;
-    SkTextBox* fTextBox;
+    TextBoxSink* fCanvas;
+    const SkTextBox* fTextBox;
 public:
-    CanvasVisitor(SkCanvas* canvas, SkTextBox* textBox): 
+    CanvasVisitor(TextBoxSink* canvas, const SkTextBox* textBox): 
          fCanvas(canvas)
         ,fTextBox(textBox) {
     }
@@ -768,7 +822,8 @@ void SkTextBox::draw(SkCanvas* canvas) {
         saveCount = canvas->save();
         canvas->clipRect(fBox, true);
     }
-    CanvasVisitor sink(canvas, this);
+    CanvasTextBoxSink canvasSink(canvas);
+    CanvasVisitor sink(&canvasSink, this);
     this->visit(sink);
     if (fClipBox) {
         canvas->restoreToCount(saveCount);
@@ -811,6 +866,18 @@ sk_sp<SkTextBlob> SkTextBox::snapshotTextBlob(SkScalar* computedBottom) const {
     return visitor.fBuilder.make();
 }
 
+sk_sp<SkTextBlob> SkTextBox::snapshotTextLayout(std::vector<SkRect>& decorationRects) const {
+    decorationRects.clear();
+    SkASSERT((fText != nullptr) && (fFont != nullptr) && (fPaint != nullptr));
+    if ((fText == nullptr) || (fLen == 0) || (fFont == nullptr) || (fPaint == nullptr)) {
+        return nullptr;
+    }
+    LayoutTextBoxSink layoutSink(&decorationRects);
+    CanvasVisitor visitor(&layoutSink, this);
+    this->visit(visitor);
+    return layoutSink.fBuilder.make();
+}
+
 bool SkTextBox::TextToGlyphs(const void* text, size_t byteLength, SkTextEncoding textEncoding,
                              const SkFont& font,
                              std::vector<SkGlyphID>& glyphs,
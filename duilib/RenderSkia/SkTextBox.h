@@ -149,6 +149,12 @@ public:
 
     sk_sp<SkTextBlob> snapshotTextBlob(SkScalar* computedBottom) const;
 
+    /** 生成与draw(SkCanvas*)绘制结果一致的排版数据（需要先调用setText），包含省略号的处理
+    * @param [out] decorationRects 返回下划线和删除线的矩形区域
+    * @return 返回文字的SkTextBlob，坐标与draw(SkCanvas*)一致（不含裁剪）
+    */
+    sk_sp<SkTextBlob> snapshotTextLayout(std::vector<SkRect>& decorationRects) const;
+
     class Visitor {
     public:
         virtual ~Visitor() {}
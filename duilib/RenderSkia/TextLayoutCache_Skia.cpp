@@ -0,0 +1,170 @@
+#include "TextLayoutCache_Skia.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4267)
+
+#include "include/core/SkTypeface.h"
+
+#pragma warning (pop)
+
+#include <cstring>
+
+namespace ui
+{
+
+/** 默认的缓存最大字节数：4MB
+*/
+static constexpr size_t kDefaultMaxCacheBytes = 4 * 1024 * 1024;
+
+/** 默认的缓存最大条目数
+*/
+static constexpr size_t kDefaultMaxCacheCount = 4096;
+
+bool TextLayoutCache_Skia::Key::operator == (const Key& r) const
+{
+    return (m_type == r.m_type) &&
+           (m_nWidth == r.m_nWidth) &&
+           (m_nHeight == r.m_nHeight) &&
+           (m_uFormat == r.m_uFormat) &&
+           (m_bUnderline == r.m_bUnderline) &&
+           (m_bStrikeOut == r.m_bStrikeOut) &&
+           (m_font == r.m_font) &&
+           (m_text == r.m_text);
+}
+
+size_t TextLayoutCache_Skia::KeyHash::operator()(const Key& key) const
+{
+    auto hashCombine = [](size_t nHash, size_t nValue) {
+            return nHash ^ (nValue + 0x9e3779b9 + (nHash << 6) + (nHash >> 2));
+        };
+    size_t nHash = std::hash<DString>()(key.m_text);
+    SkTypeface* pTypeface = key.m_font.getTypeface();
+    nHash = hashCombine(nHash, (pTypeface != nullptr) ? pTypeface->uniqueID() : 0);
+    uint32_t nFontSize = 0;
+    SkScalar fFontSize = key.m_font.getSize();
+    static_assert(sizeof(nFontSize) == sizeof(fFontSize), "size of SkScalar must be 4");
+    ::memcpy(&nFontSize, &fFontSize, sizeof(nFontSize));
+    nHash = hashCombine(nHash, nFontSize);
+    nHash = hashCombine(nHash, (size_t)key.m_nWidth);
+    nHash = hashCombine(nHash, (size_t)key.m_nHeight);
+    nHash = hashCombine(nHash, (size_t)key.m_uFormat);
+    nHash = hashCombine(nHash, ((size_t)key.m_type << 2) | ((size_t)key.m_bUnderline << 1) | (size_t)key.m_bStrikeOut);
+    return nHash;
+}
+
+TextLayoutCache_Skia::TextLayoutCache_Skia():
+    m_nCacheBytes(0),
+    m_nMaxCacheBytes(kDefaultMaxCacheBytes),
+    m_nMaxCacheCount(kDefaultMaxCacheCount),
+    m_nHitCount(0),
+    m_nMissCount(0)
+{
+}
+
+TextLayoutCache_Skia::~TextLayoutCache_Skia()
+{
+    Clear();
+}
+
+TextLayoutCache_Skia& TextLayoutCache_Skia::Instance()
+{
+    static TextLayoutCache_Skia self;
+    return self;
+}
+
+const TextLayoutCache_Skia::Layout* TextLayoutCache_Skia::Find(const Key& key)
+{
+    auto iter = m_cacheMap.find(key);
+    if (iter == m_cacheMap.end()) {
+        ++m_nMissCount;
+        PerformanceUtil::Instance().AddCounter(_T("TextLayoutCache_Skia(Miss)"));
+        return nullptr;
+    }
+    //命中：移动到列表头部
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, iter->second);
+    ++m_nHitCount;
+    PerformanceUtil::Instance().AddCounter(_T("TextLayoutCache_Skia(Hit)"));
+    return &iter->second->m_layout;
+}
+
+const TextLayoutCache_Skia::Layout* TextLayoutCache_Skia::Insert(const Key& key, Layout&& layout)
+{
+    auto iter = m_cacheMap.find(key);
+    if (iter != m_cacheMap.end()) {
+        //已经存在，替换原来的数据
+        ASSERT(m_nCacheBytes >= iter->second->m_nBytes);
+        m_nCacheBytes -= iter->second->m_nBytes;
+        m_cacheList.erase(iter->second);
+        m_cacheMap.erase(iter);
+    }
+    TItem item;
+    item.m_key = key;
+    item.m_layout = std::move(layout);
+    item.m_nBytes = EstimateBytes(item.m_key, item.m_layout);
+    m_nCacheBytes += item.m_nBytes;
+    m_cacheList.push_front(std::move(item));
+    m_cacheMap[key] = m_cacheList.begin();
+    TrimCache();
+    return &m_cacheList.front().m_layout;
+}
+
+size_t TextLayoutCache_Skia::EstimateBytes(const Key& key, const Layout& layout)
+{
+    size_t nBytes = sizeof(TItem) * 2 + key.m_text.size() * sizeof(DString::value_type) * 2;
+    nBytes += layout.m_decorationRects.size() * sizeof(SkRect);
+    if (layout.m_textBlob != nullptr) {
+        //每个Glyph：SkGlyphID + 位置信息 + 文本信息，按字符个数估算
+        nBytes += sizeof(SkTextBlob) + key.m_text.size() * (sizeof(SkGlyphID) + sizeof(SkScalar) * 2);
+    }
+    return nBytes;
+}
+
+void TextLayoutCache_Skia::TrimCache()
+{
+    //至少保留一个缓存项（当前正在使用的）
+    while (((m_nCacheBytes > m_nMaxCacheBytes) || (m_cacheList.size() > m_nMaxCacheCount)) &&
+           (m_cacheList.size() > 1)) {
+        const TItem& item = m_cacheList.back();
+        ASSERT(m_nCacheBytes >= item.m_nBytes);
+        m_nCacheBytes -= item.m_nBytes;
+        m_cacheMap.erase(item.m_key);
+        m_cacheList.pop_back();
+    }
+}
+
+void TextLayoutCache_Skia::Clear()
+{
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_nCacheBytes = 0;
+}
+
+void TextLayoutCache_Skia::SetCacheLimit(size_t nMaxCacheBytes, size_t nMaxCacheCount)
+{
+    m_nMaxCacheBytes = nMaxCacheBytes;
+    m_nMaxCacheCount = nMaxCacheCount;
+    TrimCache();
+}
+
+size_t TextLayoutCache_Skia::GetCacheBytes() const
+{
+    return m_nCacheBytes;
+}
+
+size_t TextLayoutCache_Skia::GetCacheCount() const
+{
+    return m_cacheList.size();
+}
+
+uint64_t TextLayoutCache_Skia::GetHitCount() const
+{
+    return m_nHitCount;
+}
+
+uint64_t TextLayoutCache_Skia::GetMissCount() const
+{
+    return m_nMissCount;
+}
+
+} // namespace ui
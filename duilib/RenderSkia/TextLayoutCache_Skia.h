@@ -0,0 +1,178 @@
+#ifndef UI_RENDER_SKIA_TEXT_LAYOUT_CACHE_H_
+#define UI_RENDER_SKIA_TEXT_LAYOUT_CACHE_H_
+
+#include "duilib/Render/IRender.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4267)
+
+#include "include/core/SkFont.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTextBlob.h"
+
+#pragma warning (pop)
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace ui
+{
+/** 文本排版结果缓存（DrawString/MeasureString使用）：Skia绘制引擎
+*   按(文本, 字体, 区域大小, 文本格式)缓存文字转换为Glyph、分行、省略号处理和测量的结果，
+*   文本内容和排版参数不变时，绘制和测量时不再重复排版；
+*   缓存按最近最少使用的顺序淘汰，有最大字节数和最大条目数的限制；
+*   关键字中的字体大小和区域大小都是按DPI缩放后的值，所以不同DPI的窗口可共用缓存，DPI变化时也无需清空缓存
+*/
+class UILIB_API TextLayoutCache_Skia
+{
+public:
+    TextLayoutCache_Skia();
+    ~TextLayoutCache_Skia();
+    TextLayoutCache_Skia(const TextLayoutCache_Skia&) = delete;
+    TextLayoutCache_Skia& operator = (const TextLayoutCache_Skia&) = delete;
+
+    /** 单例对象
+    */
+    static TextLayoutCache_Skia& Instance();
+
+public:
+    /** 缓存项的类型
+    */
+    enum class LayoutType : uint8_t
+    {
+        kDraw,      //绘制文本的排版结果（DrawString）
+        kMeasure    //测量文本的结果（MeasureString）
+    };
+
+    /** 缓存的关键字
+    */
+    struct Key
+    {
+        //缓存项的类型
+        LayoutType m_type = LayoutType::kDraw;
+
+        //文本内容
+        DString m_text;
+
+        //字体
+        SkFont m_font;
+
+        //字体属性：下划线和删除线
+        bool m_bUnderline = false;
+        bool m_bStrikeOut = false;
+
+        //文本区域的宽度和高度（测量时，高度固定为0）
+        int32_t m_nWidth = 0;
+        int32_t m_nHeight = 0;
+
+        //文本格式
+        uint32_t m_uFormat = 0;
+
+        bool operator == (const Key& r) const;
+    };
+
+    /** 文本排版的结果（坐标相对于文本区域的左上角）
+    */
+    struct Layout
+    {
+        //文字的绘制数据（可能为nullptr，表示没有需要绘制的文字）
+        sk_sp<SkTextBlob> m_textBlob;
+
+        //下划线和删除线的矩形区域
+        std::vector<SkRect> m_decorationRects;
+
+        //测量结果（测量时有效）
+        UiRect m_measureRect;
+    };
+
+    /** 查找缓存
+    * @param [in] key 关键字
+    * @return 如果找到返回排版结果（在下一次调用Insert/Clear之前有效），否则返回nullptr
+    */
+    const Layout* Find(const Key& key);
+
+    /** 加入缓存
+    * @param [in] key 关键字
+    * @param [in] layout 排版结果
+    * @return 返回加入缓存后的排版结果（在下一次调用Insert/Clear之前有效）
+    */
+    const Layout* Insert(const Key& key, Layout&& layout);
+
+    /** 清空缓存（字体发生变化时调用）
+    */
+    void Clear();
+
+    /** 设置缓存的限制：最大字节数和最大条目数
+    */
+    void SetCacheLimit(size_t nMaxCacheBytes, size_t nMaxCacheCount);
+
+    /** 获取当前缓存的字节数（估算值）
+    */
+    size_t GetCacheBytes() const;
+
+    /** 获取当前缓存的条目数
+    */
+    size_t GetCacheCount() const;
+
+    /** 获取缓存命中次数
+    */
+    uint64_t GetHitCount() const;
+
+    /** 获取缓存未命中次数
+    */
+    uint64_t GetMissCount() const;
+
+private:
+    /** 按缓存限制，淘汰缓存
+    */
+    void TrimCache();
+
+    /** 估算缓存项占用的字节数
+    */
+    static size_t EstimateBytes(const Key& key, const Layout& layout);
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    /** 缓存项
+    */
+    struct TItem
+    {
+        Key m_key;
+        Layout m_layout;
+        size_t m_nBytes = 0;
+    };
+
+    /** 缓存列表（按最近使用的顺序排列，最近使用的在前面）
+    */
+    std::list<TItem> m_cacheList;
+
+    /** 缓存索引(关键字指向缓存列表中的数据)
+    */
+    std::unordered_map<Key, std::list<TItem>::iterator, KeyHash> m_cacheMap;
+
+    /** 当前缓存的字节数
+    */
+    size_t m_nCacheBytes;
+
+    /** 缓存的最大字节数
+    */
+    size_t m_nMaxCacheBytes;
+
+    /** 缓存的最大条目数
+    */
+    size_t m_nMaxCacheCount;
+
+    /** 统计数据：命中次数、未命中次数
+    */
+    uint64_t m_nHitCount;
+    uint64_t m_nMissCount;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_TEXT_LAYOUT_CACHE_H_
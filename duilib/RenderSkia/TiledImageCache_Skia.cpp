@@ -0,0 +1,178 @@
+#include "TiledImageCache_Skia.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100)
+
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkPaint.h"
+
+#pragma warning (pop)
+
+namespace ui
+{
+
+/** 默认的缓存最大字节数：4MB
+*/
+static constexpr size_t kDefaultMaxCacheBytes = 4 * 1024 * 1024;
+
+TiledImageCache_Skia::TiledImageCache_Skia():
+    m_nCacheBytes(0),
+    m_nMaxCacheBytes(kDefaultMaxCacheBytes),
+    m_nHitCount(0),
+    m_nMissCount(0),
+    m_nEvictionCount(0)
+{
+}
+
+TiledImageCache_Skia::~TiledImageCache_Skia()
+{
+    Clear();
+}
+
+TiledImageCache_Skia& TiledImageCache_Skia::Instance()
+{
+    static TiledImageCache_Skia self;
+    return self;
+}
+
+size_t TiledImageCache_Skia::TKeyHash::operator()(const TKey& key) const
+{
+    size_t nHash = std::hash<uint32_t>()(key.m_nImageId);
+    nHash ^= std::hash<int32_t>()(key.m_rcSrc.fLeft) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_rcSrc.fTop) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_rcSrc.fRight) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_rcSrc.fBottom) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_nTileWidth) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    nHash ^= std::hash<int32_t>()(key.m_nTileHeight) + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+    return nHash;
+}
+
+sk_sp<SkImage> TiledImageCache_Skia::GetTiledImage(const sk_sp<SkImage>& skImage, const SkIRect& rcSrc,
+                                                   int32_t nTileWidth, int32_t nTileHeight)
+{
+    ASSERT(skImage != nullptr);
+    if ((skImage == nullptr) || rcSrc.isEmpty() ||
+        (nTileWidth < rcSrc.width()) || (nTileHeight < rcSrc.height())) {
+        return nullptr;
+    }
+    TKey key;
+    key.m_nImageId = skImage->uniqueID();
+    key.m_rcSrc = rcSrc;
+    key.m_nTileWidth = nTileWidth;
+    key.m_nTileHeight = nTileHeight;
+    {
+        std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+        auto iter = m_cacheMap.find(key);
+        if (iter != m_cacheMap.end()) {
+            //命中：移动到列表头部
+            m_cacheList.splice(m_cacheList.begin(), m_cacheList, iter->second);
+            ++m_nHitCount;
+            PerformanceUtil::Instance().AddCounter(_T("TiledImageCache_Skia(Hit)"));
+            return iter->second->m_skTiledImage;
+        }
+        ++m_nMissCount;
+    }
+    PerformanceUtil::Instance().AddCounter(_T("TiledImageCache_Skia(Miss)"));
+
+    //在锁外生成图片
+    sk_sp<SkImage> skTiledImage = MakeTiledImage(skImage, rcSrc, nTileWidth, nTileHeight);
+    if (skTiledImage == nullptr) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    if (m_cacheMap.find(key) == m_cacheMap.end()) {
+        TItem item;
+        item.m_key = key;
+        item.m_skTiledImage = skTiledImage;
+        item.m_nBytes = (size_t)nTileWidth * nTileHeight * sizeof(uint32_t);
+        m_nCacheBytes += item.m_nBytes;
+        m_cacheList.push_front(item);
+        m_cacheMap[key] = m_cacheList.begin();
+        TrimCache();
+    }
+    return skTiledImage;
+}
+
+sk_sp<SkImage> TiledImageCache_Skia::MakeTiledImage(const sk_sp<SkImage>& skImage, const SkIRect& rcSrc,
+                                                    int32_t nTileWidth, int32_t nTileHeight)
+{
+    sk_sp<SkSurface> skSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(nTileWidth, nTileHeight));
+    ASSERT(skSurface != nullptr);
+    if (skSurface == nullptr) {
+        return nullptr;
+    }
+    SkCanvas* skCanvas = skSurface->getCanvas();
+    skCanvas->clear(SK_ColorTRANSPARENT);
+    //直接复制源图片的像素（与逐个平铺单元绘制时的结果一致）
+    SkPaint skPaint;
+    skPaint.setBlendMode(SkBlendMode::kSrc);
+    skCanvas->drawImageRect(skImage, SkRect::Make(rcSrc), SkRect::MakeIWH(rcSrc.width(), rcSrc.height()),
+                            SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
+    return skSurface->makeImageSnapshot();
+}
+
+void TiledImageCache_Skia::TrimCache()
+{
+    //至少保留一个缓存项（当前正在使用的）
+    while ((m_nCacheBytes > m_nMaxCacheBytes) && (m_cacheList.size() > 1)) {
+        const TItem& item = m_cacheList.back();
+        ASSERT(m_nCacheBytes >= item.m_nBytes);
+        m_nCacheBytes -= item.m_nBytes;
+        m_cacheMap.erase(item.m_key);
+        m_cacheList.pop_back();
+        ++m_nEvictionCount;
+        PerformanceUtil::Instance().AddCounter(_T("TiledImageCache_Skia(Eviction)"));
+    }
+}
+
+void TiledImageCache_Skia::SetMaxCacheBytes(size_t nMaxCacheBytes)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_nMaxCacheBytes = nMaxCacheBytes;
+    TrimCache();
+}
+
+size_t TiledImageCache_Skia::GetMaxCacheBytes() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nMaxCacheBytes;
+}
+
+size_t TiledImageCache_Skia::GetCacheBytes() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nCacheBytes;
+}
+
+void TiledImageCache_Skia::Clear()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_nCacheBytes = 0;
+}
+
+uint64_t TiledImageCache_Skia::GetHitCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nHitCount;
+}
+
+uint64_t TiledImageCache_Skia::GetMissCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nMissCount;
+}
+
+uint64_t TiledImageCache_Skia::GetEvictionCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nEvictionCount;
+}
+
+} // namespace ui
@@ -0,0 +1,150 @@
+#ifndef UI_RENDER_SKIA_TILED_IMAGE_CACHE_H_
+#define UI_RENDER_SKIA_TILED_IMAGE_CACHE_H_
+
+#include "duilib/Render/IRender.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201)
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkRect.h"
+
+#pragma warning (pop)
+
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+//Skia相关类的前置声明
+class SkImage;
+
+namespace ui
+{
+/** 平铺单元图片缓存（平铺绘制使用）：Skia绘制引擎
+*   平铺图片的局部区域或者有平铺间隔时，平铺单元（源图片的局部区域 + 透明的平铺间隔）需要单独生成一个图片，
+*   然后使用图片着色器一次完成平铺绘制；缓存平铺单元图片，避免每次绘制时重新生成
+*   缓存按(源图片的uniqueID, 源图片区域, 平铺单元大小)查找，按最近最少使用的顺序淘汰
+*/
+class UILIB_API TiledImageCache_Skia
+{
+public:
+    TiledImageCache_Skia();
+    ~TiledImageCache_Skia();
+    TiledImageCache_Skia(const TiledImageCache_Skia&) = delete;
+    TiledImageCache_Skia& operator = (const TiledImageCache_Skia&) = delete;
+
+    /** 单例对象
+    */
+    static TiledImageCache_Skia& Instance();
+
+public:
+    /** 获取平铺单元图片，如果缓存中不存在，则生成并加入缓存
+    *   源图片的rcSrc区域位于平铺单元的左上角，其余部分（平铺间隔）为透明
+    * @param [in] skImage 源图片
+    * @param [in] rcSrc 源图片的区域
+    * @param [in] nTileWidth 平铺单元的宽度（包含平铺间隔）
+    * @param [in] nTileHeight 平铺单元的高度（包含平铺间隔）
+    */
+    sk_sp<SkImage> GetTiledImage(const sk_sp<SkImage>& skImage, const SkIRect& rcSrc,
+                                 int32_t nTileWidth, int32_t nTileHeight);
+
+    /** 设置缓存的最大字节数（超过时按最近最少使用的顺序淘汰）
+    */
+    void SetMaxCacheBytes(size_t nMaxCacheBytes);
+
+    /** 获取缓存的最大字节数
+    */
+    size_t GetMaxCacheBytes() const;
+
+    /** 获取当前缓存的字节数
+    */
+    size_t GetCacheBytes() const;
+
+    /** 清空缓存
+    */
+    void Clear();
+
+    /** 获取缓存命中次数
+    */
+    uint64_t GetHitCount() const;
+
+    /** 获取缓存未命中次数
+    */
+    uint64_t GetMissCount() const;
+
+    /** 获取缓存淘汰次数
+    */
+    uint64_t GetEvictionCount() const;
+
+private:
+    /** 生成平铺单元图片
+    */
+    static sk_sp<SkImage> MakeTiledImage(const sk_sp<SkImage>& skImage, const SkIRect& rcSrc,
+                                         int32_t nTileWidth, int32_t nTileHeight);
+
+    /** 按缓存大小限制，淘汰缓存（调用方已加锁）
+    */
+    void TrimCache();
+
+private:
+    /** 缓存的关键字
+    */
+    struct TKey
+    {
+        //源图片的uniqueID（图片数据变化后会生成新的SkImage，uniqueID唯一对应图片的内容）
+        uint32_t m_nImageId = 0;
+        SkIRect m_rcSrc = SkIRect::MakeEmpty();
+        int32_t m_nTileWidth = 0;
+        int32_t m_nTileHeight = 0;
+
+        bool operator == (const TKey& r) const
+        {
+            return (m_nImageId == r.m_nImageId) && (m_rcSrc == r.m_rcSrc) &&
+                   (m_nTileWidth == r.m_nTileWidth) && (m_nTileHeight == r.m_nTileHeight);
+        }
+    };
+
+    struct TKeyHash
+    {
+        size_t operator()(const TKey& key) const;
+    };
+
+    /** 缓存项
+    */
+    struct TItem
+    {
+        TKey m_key;
+        sk_sp<SkImage> m_skTiledImage;
+        size_t m_nBytes = 0;
+    };
+
+    /** 多线程同步锁（保护缓存数据和统计数据）
+    */
+    mutable std::mutex m_cacheMutex;
+
+    /** 缓存列表（按最近使用的顺序排列，最近使用的在前面）
+    */
+    std::list<TItem> m_cacheList;
+
+    /** 缓存索引
+    */
+    std::unordered_map<TKey, std::list<TItem>::iterator, TKeyHash> m_cacheMap;
+
+    /** 当前缓存的字节数
+    */
+    size_t m_nCacheBytes;
+
+    /** 缓存的最大字节数
+    */
+    size_t m_nMaxCacheBytes;
+
+    /** 统计数据：命中次数、未命中次数、淘汰次数
+    */
+    uint64_t m_nHitCount;
+    uint64_t m_nMissCount;
+    uint64_t m_nEvictionCount;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_TILED_IMAGE_CACHE_H_
@@ -0,0 +1,25 @@
+#include "AttributeTable.h"
+
+namespace ui
+{
+
+AttributeTable::AttributeTable(std::initializer_list<TItem> items)
+{
+    m_nameMap.reserve(items.size());
+    for (const TItem& item : items) {
+        ASSERT((item.m_name != nullptr) && (item.m_nId >= 0));
+        bool bInserted = m_nameMap.emplace(item.m_name, item.m_nId).second;
+        ASSERT_UNUSED_VARIABLE(bInserted);//属性名称不能重复
+    }
+}
+
+int32_t AttributeTable::Find(const DString& strName) const
+{
+    auto iter = m_nameMap.find(strName);
+    if (iter != m_nameMap.end()) {
+        return iter->second;
+    }
+    return -1;
+}
+
+} // namespace ui
@@ -0,0 +1,43 @@
+#ifndef UI_UTILS_ATTRIBUTE_TABLE_H_
+#define UI_UTILS_ATTRIBUTE_TABLE_H_
+
+#include "duilib/duilib_defs.h"
+#include <initializer_list>
+#include <unordered_map>
+
+namespace ui
+{
+/** 属性名称表：将属性名称映射为序号，SetAttribute函数查表得到序号后按序号分发（switch），
+*   避免逐个比较属性名称字符串（一次哈希查找，与属性个数无关）
+*   用法：在SetAttribute函数中定义静态的属性名称表（首次调用时初始化，多线程安全），同一个属性的多个名称（别名）使用同一个序号
+*/
+class UILIB_API AttributeTable
+{
+public:
+    /** 属性名称和序号
+    */
+    struct TItem
+    {
+        const DString::value_type* m_name;
+        int32_t m_nId;
+    };
+
+    explicit AttributeTable(std::initializer_list<TItem> items);
+    AttributeTable(const AttributeTable&) = delete;
+    AttributeTable& operator = (const AttributeTable&) = delete;
+
+    /** 查找属性名称对应的序号
+    * @param [in] strName 属性名称
+    * @return 返回属性名称对应的序号，如果属性名称不在表中，返回-1
+    */
+    int32_t Find(const DString& strName) const;
+
+private:
+    /** 属性名称与序号的映射表
+    */
+    std::unordered_map<DString, int32_t> m_nameMap;
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_ATTRIBUTE_TABLE_H_
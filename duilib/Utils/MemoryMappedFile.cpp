@@ -0,0 +1,126 @@
+#include "MemoryMappedFile.h"
+
+#ifndef DUILIB_BUILD_FOR_WIN
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ui
+{
+
+MemoryMappedFile::MemoryMappedFile():
+    m_pData(nullptr),
+    m_nSize(0)
+#ifdef DUILIB_BUILD_FOR_WIN
+    ,m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr)
+#endif
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+#ifdef DUILIB_BUILD_FOR_WIN
+
+bool MemoryMappedFile::Open(const FilePath& filePath)
+{
+    Close();
+    m_hFile = ::CreateFileW(filePath.ToStringW().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize = { 0, };
+    if (!::GetFileSizeEx(m_hFile, &fileSize) || (fileSize.QuadPart <= 0) ||
+        ((uint64_t)fileSize.QuadPart > (uint64_t)SIZE_MAX)) {
+        Close();
+        return false;
+    }
+    m_hMapping = ::CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr) {
+        Close();
+        return false;
+    }
+    m_pData = (const uint8_t*)::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pData == nullptr) {
+        Close();
+        return false;
+    }
+    m_nSize = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (m_pData != nullptr) {
+        ::UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+    if (m_hMapping != nullptr) {
+        ::CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+    m_nSize = 0;
+}
+
+#else
+
+bool MemoryMappedFile::Open(const FilePath& filePath)
+{
+    Close();
+    int fd = ::open(filePath.ToStringA().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if ((::fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+        ::close(fd);
+        return false;
+    }
+    void* pData = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //映射完成后，文件描述符可以关闭，不影响映射的内存
+    ::close(fd);
+    if (pData == MAP_FAILED) {
+        return false;
+    }
+    m_pData = (const uint8_t*)pData;
+    m_nSize = (size_t)fileStat.st_size;
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (m_pData != nullptr) {
+        ::munmap((void*)m_pData, m_nSize);
+        m_pData = nullptr;
+    }
+    m_nSize = 0;
+}
+
+#endif
+
+bool MemoryMappedFile::IsValid() const
+{
+    return m_pData != nullptr;
+}
+
+const uint8_t* MemoryMappedFile::GetData() const
+{
+    return m_pData;
+}
+
+size_t MemoryMappedFile::GetSize() const
+{
+    return m_nSize;
+}
+
+}
@@ -0,0 +1,63 @@
+#ifndef UI_UTILS_MEMORY_MAPPED_FILE_H_
+#define UI_UTILS_MEMORY_MAPPED_FILE_H_
+
+#include "duilib/Utils/FilePath.h"
+
+namespace ui
+{
+
+/** 只读方式的内存映射文件（读取大文件时避免一次性读入内存，由系统按需分页加载）
+*/
+class UILIB_API MemoryMappedFile
+{
+public:
+    MemoryMappedFile();
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator = (const MemoryMappedFile&) = delete;
+
+    /** 打开文件，并映射到内存
+    * @param [in] filePath 本地文件路径(绝对路径)
+    * @return 成功返回true，如果文件不存在或者文件长度为0，返回false
+    */
+    bool Open(const FilePath& filePath);
+
+    /** 关闭文件，解除内存映射
+    */
+    void Close();
+
+    /** 是否已经打开
+    */
+    bool IsValid() const;
+
+    /** 获取文件数据的起始地址（只读）
+    */
+    const uint8_t* GetData() const;
+
+    /** 获取文件数据的长度
+    */
+    size_t GetSize() const;
+
+private:
+    /** 文件数据的起始地址
+    */
+    const uint8_t* m_pData;
+
+    /** 文件数据的长度
+    */
+    size_t m_nSize;
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    /** 文件句柄
+    */
+    HANDLE m_hFile;
+
+    /** 文件映射句柄
+    */
+    HANDLE m_hMapping;
+#endif
+};
+
+}
+
+#endif // UI_UTILS_MEMORY_MAPPED_FILE_H_
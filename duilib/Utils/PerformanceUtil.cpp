@@ -23,6 +23,10 @@ PerformanceUtil::~PerformanceUtil()
                                         (int32_t)(iter.second.maxTime.count() / 1000));
         LogUtil::OutputLine(log);
     }
+    for (const auto& iter : m_counter) {
+        DString log = StringUtil::Printf(_T("%s: %lld"), iter.first.c_str(), (long long)iter.second);
+        LogUtil::OutputLine(log);
+    }
 }
 
 PerformanceUtil& PerformanceUtil::Instance()
@@ -31,29 +35,54 @@ PerformanceUtil& PerformanceUtil::Instance()
     return self;
 }
 
+/** 当前线程中每个统计项的开始时间（BeginStat/EndStat配对使用，不需要加锁）
+*/
+static thread_local std::map<DString, std::chrono::steady_clock::time_point> s_statStartTimes;
+
 void PerformanceUtil::BeginStat(const DString& name)
 {
     ASSERT(!name.empty());
-    TStat& stat = m_stat[name];
-    stat.startTime = std::chrono::steady_clock::now();
-    ASSERT(stat.nStartRefCount >= 0);
-    stat.nStartRefCount++;
+    s_statStartTimes[name] = std::chrono::steady_clock::now();
 }
 
 void PerformanceUtil::EndStat(const DString& name)
 {
     ASSERT(!name.empty());
-    TStat& stat = m_stat[name];
-    ASSERT(stat.nStartRefCount > 0);
-    if (stat.nStartRefCount <= 0) {
+    auto iter = s_statStartTimes.find(name);
+    ASSERT(iter != s_statStartTimes.end());
+    if (iter == s_statStartTimes.end()) {
         return;
     }
-    stat.endTime = std::chrono::steady_clock::now();
+    auto thisTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - iter->second);
+    s_statStartTimes.erase(iter);
+    AddStat(name, thisTime);
+}
+
+void PerformanceUtil::AddStat(const DString& name, std::chrono::microseconds thisTime)
+{
+    ASSERT(!name.empty());
+    std::lock_guard<std::mutex> threadGuard(m_statMutex);
+    TStat& stat = m_stat[name];
     stat.totalCount += 1;
-    auto thisTime = std::chrono::duration_cast<std::chrono::microseconds>(stat.endTime - stat.startTime);
     stat.totalTimes += thisTime;
-    stat.nStartRefCount--;
     stat.maxTime = (std::max)(stat.maxTime, thisTime);
 }
 
+void PerformanceUtil::AddCounter(const DString& name, int64_t nValue)
+{
+    ASSERT(!name.empty());
+    std::lock_guard<std::mutex> threadGuard(m_counterMutex);
+    m_counter[name] += nValue;
+}
+
+int64_t PerformanceUtil::GetCounter(const DString& name) const
+{
+    std::lock_guard<std::mutex> threadGuard(m_counterMutex);
+    auto iter = m_counter.find(name);
+    if (iter != m_counter.end()) {
+        return iter->second;
+    }
+    return 0;
+}
+
 }
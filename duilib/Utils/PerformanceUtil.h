@@ -6,6 +6,7 @@
 #include <map>
 #include <chrono>
 #include <algorithm>
+#include <mutex>
 
 namespace ui 
 {
@@ -22,30 +23,39 @@ public:
     */
     static PerformanceUtil& Instance();
 
-    /** 代码开始执行，开始计时
+    /** 代码开始执行，开始计时（可在多线程中调用，开始时间按线程分别记录，必须在同一个线程中调用EndStat）
     * @param [in] name 统计项的名称
     */
     void BeginStat(const DString& name);
 
-    /** 代码结束执行，统计执行性能
+    /** 代码结束执行，统计执行性能（可在多线程中调用）
     * @param [in] name 统计项的名称
     */
     void EndStat(const DString& name);
+
+    /** 累加一次执行时间（可在多线程中调用，由调用方计时，多个线程同时执行同一统计项时互不影响）
+    * @param [in] name 统计项的名称
+    * @param [in] thisTime 本次的执行时间
+    */
+    void AddStat(const DString& name, std::chrono::microseconds thisTime);
+
+    /** 累加计数类统计项的数值（比如缓存命中次数、复制的字节数等），可在多线程中调用
+    * @param [in] name 统计项的名称
+    * @param [in] nValue 本次累加的数值
+    */
+    void AddCounter(const DString& name, int64_t nValue = 1);
+
+    /** 获取计数类统计项的当前值，可在多线程中调用
+    * @param [in] name 统计项的名称
+    * @return 返回累加的总数值，如果该统计项不存在则返回0
+    */
+    int64_t GetCounter(const DString& name) const;
     
 private:
     /** 记录每项统计的结果
     */
     struct TStat
     {
-        //是否有开始数据
-        int32_t nStartRefCount = 0;
-
-        //开始时间
-        std::chrono::steady_clock::time_point startTime;
-
-        //结束时间
-        std::chrono::steady_clock::time_point endTime;
-
         //代码执行总时间：微秒(千分之一毫秒)
         std::chrono::microseconds totalTimes = std::chrono::microseconds::zero();
 
@@ -58,22 +68,38 @@ private:
     };
 
     std::map<DString, TStat> m_stat;
+
+    /** 执行时间类统计项的多线程同步锁
+    */
+    std::mutex m_statMutex;
+
+    /** 计数类统计项
+    */
+    std::map<DString, int64_t> m_counter;
+
+    /** 计数类统计项的多线程同步锁
+    */
+    mutable std::mutex m_counterMutex;
 };
 
 class PerformanceStat
 {
 public:
     explicit PerformanceStat(const DString& statName):
-        m_statName(statName)
+        m_statName(statName),
+        m_startTime(std::chrono::steady_clock::now())
     {
-        PerformanceUtil::Instance().BeginStat(m_statName);
     }
     ~PerformanceStat()
     {
-        PerformanceUtil::Instance().EndStat(m_statName);
+        auto thisTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime);
+        PerformanceUtil::Instance().AddStat(m_statName, thisTime);
     }
 private:
     DString m_statName;
+
+    //开始时间（每个统计对象单独记录，多线程同时统计同一项时互不影响）
+    std::chrono::steady_clock::time_point m_startTime;
 };
 
 }
@@ -0,0 +1,235 @@
+#include "PixelUtil.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define DUILIB_PIXEL_USE_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define DUILIB_PIXEL_USE_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace ui
+{
+
+/** 转换一个像素（每个像素4个字节，第3个字节是Alpha通道），返回转换后像素的Alpha值
+*   Alpha预乘使用四舍五入的除法：c * a / 255，与SIMD版本的计算结果完全一致
+*/
+static inline uint8_t ConvertPixel(const uint8_t* pSrc, uint8_t* pDest, bool bSwapRB, bool bPremultiply, bool bForceOpaque)
+{
+    uint8_t c0 = pSrc[0];
+    uint8_t c1 = pSrc[1];
+    uint8_t c2 = pSrc[2];
+    uint8_t a = bForceOpaque ? 255 : pSrc[3];
+    if (bSwapRB) {
+        uint8_t t = c0;
+        c0 = c2;
+        c2 = t;
+    }
+    if (bPremultiply && (a != 255)) {
+        uint32_t t0 = (uint32_t)c0 * a + 128;
+        uint32_t t1 = (uint32_t)c1 * a + 128;
+        uint32_t t2 = (uint32_t)c2 * a + 128;
+        c0 = (uint8_t)((t0 + (t0 >> 8)) >> 8);
+        c1 = (uint8_t)((t1 + (t1 >> 8)) >> 8);
+        c2 = (uint8_t)((t2 + (t2 >> 8)) >> 8);
+    }
+    pDest[0] = c0;
+    pDest[1] = c1;
+    pDest[2] = c2;
+    pDest[3] = a;
+    return a;
+}
+
+#if defined (DUILIB_PIXEL_USE_SSE2)
+
+/** 16位整数除以255（四舍五入）
+*/
+static inline __m128i Div255_SSE2(__m128i t)
+{
+    t = _mm_add_epi16(t, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/** 转换一行像素（每次处理4个像素），返回所有像素的Alpha值按位与的结果
+*/
+static uint8_t ConvertRow(const uint8_t* pSrc, uint8_t* pDest, uint32_t nWidth,
+                          bool bSwapRB, bool bPremultiply, bool bForceOpaque)
+{
+    const __m128i alphaMask = _mm_set1_epi32((int32_t)0xFF000000);
+    const __m128i agMask = _mm_set1_epi32((int32_t)0xFF00FF00);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i alphaAnd = _mm_set1_epi32(-1);
+    uint32_t x = 0;
+    for (; (x + 4) <= nWidth; x += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(pSrc + x * 4));
+        if (bForceOpaque) {
+            px = _mm_or_si128(px, alphaMask);
+        }
+        if (bSwapRB) {
+            //每个像素为32位整数：A|c2|c1|c0，交换c0和c2
+            __m128i ag = _mm_and_si128(px, agMask);
+            __m128i rb = _mm_andnot_si128(agMask, px);
+            rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+            px = _mm_or_si128(ag, rb);
+        }
+        alphaAnd = _mm_and_si128(alphaAnd, px);
+        if (bPremultiply) {
+            __m128i alpha = _mm_and_si128(px, alphaMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) != 0xFFFF) {
+                //扩展为16位整数，每次计算2个像素
+                __m128i lo = _mm_unpacklo_epi8(px, zero);
+                __m128i hi = _mm_unpackhi_epi8(px, zero);
+                __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+                __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+                lo = Div255_SSE2(_mm_mullo_epi16(lo, alphaLo));
+                hi = Div255_SSE2(_mm_mullo_epi16(hi, alphaHi));
+                //Alpha通道保持原值
+                px = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi)), alpha);
+            }
+        }
+        _mm_storeu_si128((__m128i*)(pDest + x * 4), px);
+    }
+    uint8_t nAlphaAnd = 0xFF;
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(alphaAnd, alphaMask), alphaMask)) != 0xFFFF) {
+        nAlphaAnd = 0;
+    }
+    for (; x < nWidth; ++x) {
+        nAlphaAnd &= ConvertPixel(pSrc + x * 4, pDest + x * 4, bSwapRB, bPremultiply, bForceOpaque);
+    }
+    return nAlphaAnd;
+}
+
+#elif defined (DUILIB_PIXEL_USE_NEON)
+
+/** 8位整数相乘后除以255（四舍五入）
+*/
+static inline uint8x16_t MulDiv255_NEON(uint8x16_t c, uint8x16_t a)
+{
+    uint16x8_t lo = vmull_u8(vget_low_u8(c), vget_low_u8(a));
+    uint16x8_t hi = vmull_u8(vget_high_u8(c), vget_high_u8(a));
+    //(t + ((t + 128) >> 8) + 128) >> 8
+    return vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+}
+
+/** 转换一行像素（每次处理16个像素），返回所有像素的Alpha值按位与的结果
+*/
+static uint8_t ConvertRow(const uint8_t* pSrc, uint8_t* pDest, uint32_t nWidth,
+                          bool bSwapRB, bool bPremultiply, bool bForceOpaque)
+{
+    uint8x16_t alphaAnd = vdupq_n_u8(0xFF);
+    uint32_t x = 0;
+    for (; (x + 16) <= nWidth; x += 16) {
+        //按通道拆分：val[0]~val[3]分别为16个像素的c0、c1、c2、A
+        uint8x16x4_t px = vld4q_u8(pSrc + x * 4);
+        if (bForceOpaque) {
+            px.val[3] = vdupq_n_u8(0xFF);
+        }
+        if (bSwapRB) {
+            uint8x16_t t = px.val[0];
+            px.val[0] = px.val[2];
+            px.val[2] = t;
+        }
+        alphaAnd = vandq_u8(alphaAnd, px.val[3]);
+        if (bPremultiply && (vminvq_u8(px.val[3]) != 0xFF)) {
+            px.val[0] = MulDiv255_NEON(px.val[0], px.val[3]);
+            px.val[1] = MulDiv255_NEON(px.val[1], px.val[3]);
+            px.val[2] = MulDiv255_NEON(px.val[2], px.val[3]);
+        }
+        vst4q_u8(pDest + x * 4, px);
+    }
+    uint8_t nAlphaAnd = (vminvq_u8(alphaAnd) == 0xFF) ? 0xFF : 0;
+    for (; x < nWidth; ++x) {
+        nAlphaAnd &= ConvertPixel(pSrc + x * 4, pDest + x * 4, bSwapRB, bPremultiply, bForceOpaque);
+    }
+    return nAlphaAnd;
+}
+
+#else
+
+/** 转换一行像素，返回所有像素的Alpha值按位与的结果
+*/
+static uint8_t ConvertRow(const uint8_t* pSrc, uint8_t* pDest, uint32_t nWidth,
+                          bool bSwapRB, bool bPremultiply, bool bForceOpaque)
+{
+    uint8_t nAlphaAnd = 0xFF;
+    for (uint32_t x = 0; x < nWidth; ++x) {
+        nAlphaAnd &= ConvertPixel(pSrc + x * 4, pDest + x * 4, bSwapRB, bPremultiply, bForceOpaque);
+    }
+    return nAlphaAnd;
+}
+
+#endif
+
+bool PixelUtil::ConvertPixels(const uint8_t* pSrcPixels, uint8_t* pDestPixels,
+                              uint32_t nWidth, uint32_t nHeight, uint32_t nFlags)
+{
+    ASSERT((pSrcPixels != nullptr) && (pDestPixels != nullptr));
+    if ((pSrcPixels == nullptr) || (pDestPixels == nullptr) || (nWidth == 0) || (nHeight == 0)) {
+        return false;
+    }
+    const bool bSwapRB = (nFlags & kPixelSwapRB) != 0;
+    const bool bPremultiply = (nFlags & kPixelPremultiply) != 0;
+    const bool bFlipVertical = (nFlags & kPixelFlipVertical) != 0;
+    const bool bForceOpaque = (nFlags & kPixelForceOpaque) != 0;
+    //原地转换时，不支持垂直翻转
+    ASSERT(!bFlipVertical || (pSrcPixels != pDestPixels));
+    if (bFlipVertical && (pSrcPixels == pDestPixels)) {
+        return false;
+    }
+
+    const size_t nRowBytes = (size_t)nWidth * 4;
+    uint8_t nAlphaAnd = 0xFF;
+    for (uint32_t nRow = 0; nRow < nHeight; ++nRow) {
+        const uint8_t* pSrc = pSrcPixels + nRowBytes * (bFlipVertical ? (nHeight - 1 - nRow) : nRow);
+        uint8_t* pDest = pDestPixels + nRowBytes * nRow;
+        nAlphaAnd &= ConvertRow(pSrc, pDest, nWidth, bSwapRB, bPremultiply, bForceOpaque);
+    }
+    return nAlphaAnd == 0xFF;
+}
+
+void PixelUtil::ScaleAlpha(uint32_t* pPixels, size_t nCount, uint8_t nAlpha)
+{
+    ASSERT((pPixels != nullptr) || (nCount == 0));
+    if ((pPixels == nullptr) || (nAlpha == 255)) {
+        return;
+    }
+    size_t nIndex = 0;
+#if defined (DUILIB_PIXEL_USE_SSE2)
+    //每次处理4个像素：扩展为16位后相乘，再通过 ((x + 128) * 257) >> 16 完成除以255
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha16 = _mm_set1_epi16((short)nAlpha);
+    const __m128i round16 = _mm_set1_epi16(128);
+    const __m128i div16 = _mm_set1_epi16(257);
+    for (; (nIndex + 4) <= nCount; nIndex += 4) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(pPixels + nIndex));
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), alpha16);
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), alpha16);
+        lo = _mm_mulhi_epu16(_mm_add_epi16(lo, round16), div16);
+        hi = _mm_mulhi_epu16(_mm_add_epi16(hi, round16), div16);
+        _mm_storeu_si128((__m128i*)(pPixels + nIndex), _mm_packus_epi16(lo, hi));
+    }
+#elif defined (DUILIB_PIXEL_USE_NEON)
+    //每次处理4个像素：扩展为16位后相乘，再通过 (t + ((t + 128) >> 8) + 128) >> 8 完成除以255
+    const uint8x8_t alpha8 = vdup_n_u8(nAlpha);
+    for (; (nIndex + 4) <= nCount; nIndex += 4) {
+        uint8x16_t px = vld1q_u8((const uint8_t*)(pPixels + nIndex));
+        uint16x8_t lo = vmull_u8(vget_low_u8(px), alpha8);
+        uint16x8_t hi = vmull_u8(vget_high_u8(px), alpha8);
+        vst1q_u8((uint8_t*)(pPixels + nIndex), vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)),
+                                                          vraddhn_u16(hi, vrshrq_n_u16(hi, 8))));
+    }
+#endif
+    //剩余的像素（或者不支持SIMD指令时）：一次处理两个通道
+    const uint32_t nAlpha32 = nAlpha;
+    for (; nIndex < nCount; ++nIndex) {
+        uint32_t nColor = pPixels[nIndex];
+        uint32_t rb = (nColor & 0x00FF00FF) * nAlpha32 + 0x00800080;
+        uint32_t ag = ((nColor >> 8) & 0x00FF00FF) * nAlpha32 + 0x00800080;
+        rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        ag = ((ag + ((ag >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        pPixels[nIndex] = rb | (ag << 8);
+    }
+}
+
+}
@@ -0,0 +1,64 @@
+#ifndef UI_UTILS_PIXEL_UTIL_H_
+#define UI_UTILS_PIXEL_UTIL_H_
+
+#include "duilib/duilib_defs.h"
+
+namespace ui
+{
+
+/** 位图像素数据的转换（图片解码后生成位图数据时使用）
+*   每个像素4个字节，R/B通道交换、Alpha预乘、不透明检测和垂直翻转在一次遍历中完成，
+*   x86/x64平台使用SSE2指令，ARM64平台使用NEON指令，每次处理多个像素
+*/
+class UILIB_API PixelUtil
+{
+public:
+    /** 像素转换的选项（可组合使用）
+    */
+    enum PixelConvertFlags : uint32_t
+    {
+        kPixelSwapRB        = 0x01, //交换R和B通道（RGBA <-> BGRA）
+        kPixelPremultiply   = 0x02, //Alpha预乘（源数据不是预乘格式时）
+        kPixelFlipVertical  = 0x04, //垂直翻转（源数据的行顺序是从下到上的）
+        kPixelForceOpaque   = 0x08  //所有像素设置为不透明（源数据的Alpha通道无效时）
+    };
+
+#ifdef DUILIB_BUILD_FOR_WIN
+    /** 源数据为RGBA格式时，转换为位图像素格式（Windows平台为BGRA，其他平台为RGBA）需要的选项
+    */
+    static constexpr uint32_t kPixelFromRGBA = kPixelSwapRB;
+
+    /** 源数据为BGRA格式时，转换为位图像素格式需要的选项
+    */
+    static constexpr uint32_t kPixelFromBGRA = 0;
+#else
+    static constexpr uint32_t kPixelFromRGBA = 0;
+    static constexpr uint32_t kPixelFromBGRA = kPixelSwapRB;
+#endif
+
+    /** 转换像素数据
+    *   Alpha预乘的计算结果为 c * a / 255 四舍五入（早期版本的APNG、CxImage解码是截断取整，个别通道值会比原来大1），
+    *   SIMD版本与非SIMD版本的计算结果完全一致；可使用tools/pixel_bench测试各个转换选项的性能
+    * @param [in] pSrcPixels 源数据，数据长度为：nWidth*nHeight*4
+    * @param [out] pDestPixels 目标数据，数据长度为：nWidth*nHeight*4，可与源数据相同（原地转换，此时不支持垂直翻转）
+    * @param [in] nWidth 宽度
+    * @param [in] nHeight 高度
+    * @param [in] nFlags 转换选项，参见PixelConvertFlags
+    * @return 如果所有像素都是不透明的，返回true；否则返回false
+    */
+    static bool ConvertPixels(const uint8_t* pSrcPixels, uint8_t* pDestPixels,
+                              uint32_t nWidth, uint32_t nHeight, uint32_t nFlags);
+
+    /** 将像素的各个通道（包括Alpha通道）乘以透明度，用于绘制带透明度的分层窗口
+    *   计算结果为 x * nAlpha / 255 四舍五入（早期版本是截断取整，个别通道值会比原来大1）；
+    *   4个通道乘以相同的值，所以与颜色通道的顺序无关
+    * @param [in,out] pPixels 像素数据（原地转换）
+    * @param [in] nCount 像素个数
+    * @param [in] nAlpha 透明度（0 - 255），为255时不做任何处理
+    */
+    static void ScaleAlpha(uint32_t* pPixels, size_t nCount, uint8_t nAlpha);
+};
+
+}
+
+#endif // UI_UTILS_PIXEL_UTIL_H_
@@ -0,0 +1,164 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace ui
+{
+
+/** 当前线程是否正在执行并行任务（用于检测在任务函数中嵌套调用ParallelFor）
+*/
+static thread_local bool s_bInParallelJob = false;
+
+ThreadPool::ThreadPool():
+    m_pJob(nullptr),
+    m_nJobSlots(0),
+    m_nActiveWorkers(0),
+    m_bStop(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_jobCv.notify_all();
+    for (std::unique_ptr<std::thread>& pWorker : m_workers) {
+        if ((pWorker != nullptr) && pWorker->joinable()) {
+            pWorker->join();
+        }
+    }
+    m_workers.clear();
+}
+
+ThreadPool& ThreadPool::Instance()
+{
+    static ThreadPool self;
+    return self;
+}
+
+size_t ThreadPool::GetMaxThreadCount() const
+{
+    size_t nCount = std::thread::hardware_concurrency();
+    return (nCount > 0) ? nCount : 1;
+}
+
+size_t ThreadPool::ParallelFor(size_t nTaskCount, size_t nMaxThreads, const std::function<void(size_t nTaskIndex)>& task)
+{
+    ASSERT(task != nullptr);
+    if ((nTaskCount == 0) || (task == nullptr)) {
+        return 0;
+    }
+    size_t nThreads = std::min(std::min(nMaxThreads, nTaskCount), GetMaxThreadCount());
+    std::unique_lock<std::mutex> jobLock;
+    if ((nThreads > 1) && !s_bInParallelJob) {
+        //嵌套调用时，当前线程可能已经持有m_jobMutex（不能再次加锁），所以先检查嵌套标志
+        jobLock = std::unique_lock<std::mutex>(m_jobMutex, std::try_to_lock);
+    }
+    if (!jobLock.owns_lock()) {
+        //单线程，或者线程池正在被使用：在调用方线程中顺序执行
+        for (size_t nIndex = 0; nIndex < nTaskCount; ++nIndex) {
+            task(nIndex);
+        }
+        return 1;
+    }
+
+    //调用方线程也参与执行，所以工作线程个数少一个
+    const size_t nWorkers = nThreads - 1;
+    const size_t nWorkerCount = EnsureWorkers(nWorkers);
+
+    TJob job;
+    job.m_pTask = &task;
+    job.m_nTaskCount = nTaskCount;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pJob = &job;
+        m_nJobSlots = std::min(nWorkers, nWorkerCount);
+    }
+    m_jobCv.notify_all();
+
+    RunJob(job);
+
+    //所有任务已被领取：禁止新的工作线程加入，并等待已加入的工作线程执行完成（job在栈上，必须等待）
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_nJobSlots = 0;
+    m_doneCv.wait(lock, [this]() { return m_nActiveWorkers == 0; });
+    m_pJob = nullptr;
+    return nThreads;
+}
+
+void ThreadPool::PostTask(const std::function<void()>& task)
+{
+    ASSERT(task != nullptr);
+    if (task == nullptr) {
+        return;
+    }
+    EnsureWorkers(GetMaxThreadCount() - 1);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(task);
+    }
+    m_jobCv.notify_one();
+}
+
+void ThreadPool::RunJob(TJob& job)
+{
+    s_bInParallelJob = true;
+    size_t nIndex = job.m_nNextIndex.fetch_add(1);
+    while (nIndex < job.m_nTaskCount) {
+        (*job.m_pTask)(nIndex);
+        nIndex = job.m_nNextIndex.fetch_add(1);
+    }
+    s_bInParallelJob = false;
+}
+
+size_t ThreadPool::EnsureWorkers(size_t nCount)
+{
+    //至少保留一个工作线程，用于执行异步任务
+    nCount = std::max(std::min(nCount, GetMaxThreadCount() - 1), (size_t)1);
+    std::lock_guard<std::mutex> lock(m_workersMutex);
+    while (m_workers.size() < nCount) {
+        m_workers.push_back(std::make_unique<std::thread>(&ThreadPool::WorkerProc, this));
+    }
+    return m_workers.size();
+}
+
+void ThreadPool::WorkerProc()
+{
+    while (true) {
+        TJob* pJob = nullptr;
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobCv.wait(lock, [this]() {
+                    return m_bStop || ((m_pJob != nullptr) && (m_nJobSlots > 0)) || !m_tasks.empty();
+                });
+            if (m_bStop) {
+                break;
+            }
+            if ((m_pJob != nullptr) && (m_nJobSlots > 0)) {
+                //优先执行并行任务（调用方线程在等待）
+                --m_nJobSlots;
+                ++m_nActiveWorkers;
+                pJob = m_pJob;
+            }
+            else {
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+        }
+        if (pJob != nullptr) {
+            RunJob(*pJob);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_nActiveWorkers;
+            }
+            m_doneCv.notify_all();
+        }
+        else if (task != nullptr) {
+            task();
+        }
+    }
+}
+
+}
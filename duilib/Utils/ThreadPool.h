@@ -0,0 +1,129 @@
+#ifndef UI_UTILS_THREAD_POOL_H_
+#define UI_UTILS_THREAD_POOL_H_
+
+#include "duilib/duilib_defs.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ui
+{
+
+/** 后台任务和并行计算使用的线程池（比如图片异步解码、分块并行绘制）
+*   ParallelFor：调用方线程也参与任务的执行，所有任务执行完成后才返回，所以任务函数可以引用调用方栈上的数据；
+*   PostTask：任务在工作线程中异步执行，调用方不等待；
+*   工作线程按需创建，个数不超过CPU核数-1（至少1个）
+*/
+class UILIB_API ThreadPool
+{
+public:
+    ThreadPool();
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    /** 单例对象
+    */
+    static ThreadPool& Instance();
+
+    /** 并行执行一组任务，所有任务执行完成后返回
+    * @param [in] nTaskCount 任务个数
+    * @param [in] nMaxThreads 最多使用的线程数（含调用方线程），为0或者1时在调用方线程中顺序执行
+    * @param [in] task 任务函数，参数为任务序号（0 到 nTaskCount-1），会在多个线程中同时调用
+    * @return 返回实际参与执行的线程数（含调用方线程）
+    *  注：同一时刻只能执行一组并行任务，如果线程池正在被其他线程使用（或者在任务函数中嵌套调用），在调用方线程中顺序执行
+    */
+    size_t ParallelFor(size_t nTaskCount, size_t nMaxThreads, const std::function<void(size_t nTaskIndex)>& task);
+
+    /** 获取最多可用的线程数（含调用方线程），即CPU核数
+    */
+    size_t GetMaxThreadCount() const;
+
+    /** 投递一个异步任务，在工作线程中执行（多个任务可能在不同的工作线程中同时执行）
+    * @param [in] task 任务函数
+    *  注：线程池销毁时，尚未开始执行的任务被丢弃
+    */
+    void PostTask(const std::function<void()>& task);
+
+private:
+    /** 一组并行任务
+    */
+    struct TJob
+    {
+        //任务函数
+        const std::function<void(size_t)>* m_pTask = nullptr;
+
+        //任务个数
+        size_t m_nTaskCount = 0;
+
+        //下一个待执行的任务序号
+        std::atomic<size_t> m_nNextIndex{ 0 };
+    };
+
+    /** 执行任务，直到所有任务都被领取
+    */
+    static void RunJob(TJob& job);
+
+    /** 创建工作线程，使工作线程的个数不少于nCount
+    * @return 返回工作线程的个数
+    */
+    size_t EnsureWorkers(size_t nCount);
+
+    /** 工作线程的执行函数
+    */
+    void WorkerProc();
+
+private:
+    /** 工作线程
+    */
+    std::vector<std::unique_ptr<std::thread>> m_workers;
+
+    /** 创建工作线程的多线程同步锁
+    */
+    std::mutex m_workersMutex;
+
+    /** 保证同一时刻只有一组并行任务
+    */
+    std::mutex m_jobMutex;
+
+    /** 以下数据的多线程同步锁
+    */
+    std::mutex m_mutex;
+
+    /** 有新任务（并行任务或者异步任务）或者需要退出时，通知工作线程
+    */
+    std::condition_variable m_jobCv;
+
+    /** 工作线程离开任务时，通知调用方线程
+    */
+    std::condition_variable m_doneCv;
+
+    /** 当前正在执行的任务
+    */
+    TJob* m_pJob;
+
+    /** 当前任务还允许加入的工作线程个数
+    */
+    size_t m_nJobSlots;
+
+    /** 当前正在执行任务的工作线程个数
+    */
+    size_t m_nActiveWorkers;
+
+    /** 等待执行的异步任务
+    */
+    std::deque<std::function<void()>> m_tasks;
+
+    /** 是否退出
+    */
+    bool m_bStop;
+};
+
+}
+
+#endif // UI_UTILS_THREAD_POOL_H_
@@ -126,6 +126,24 @@ cd "$SRC_ROOT_DIR/build_temp/multi_browser"
 make clean; make
 cd "$SRC_ROOT_DIR/"
 
+#编译皮肤编译工具
+cmake -S "$SRC_ROOT_DIR/tools/skin_compiler/" -B "$SRC_ROOT_DIR/build_temp/skin_compiler" -DCMAKE_BUILD_TYPE=Debug
+cd "$SRC_ROOT_DIR/build_temp/skin_compiler"
+make clean; make
+cd "$SRC_ROOT_DIR/"
+
+#编译图片磁盘缓存的启动性能测试工具
+cmake -S "$SRC_ROOT_DIR/tools/image_cache_bench/" -B "$SRC_ROOT_DIR/build_temp/image_cache_bench" -DCMAKE_BUILD_TYPE=Debug
+cd "$SRC_ROOT_DIR/build_temp/image_cache_bench"
+make clean; make
+cd "$SRC_ROOT_DIR/"
+
+#编译像素处理函数的性能测试工具
+cmake -S "$SRC_ROOT_DIR/tools/pixel_bench/" -B "$SRC_ROOT_DIR/build_temp/pixel_bench" -DCMAKE_BUILD_TYPE=Debug
+cd "$SRC_ROOT_DIR/build_temp/pixel_bench"
+make clean; make
+cd "$SRC_ROOT_DIR/"
+
 #清理临时目录
 #rm -rf "$SRC_ROOT_DIR/build_temp/"
 
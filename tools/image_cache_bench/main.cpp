@@ -0,0 +1,108 @@
+/** 图片磁盘缓存的启动性能测试工具：加载资源目录下的所有图片，统计加载耗时（模拟程序冷启动时加载图片的过程）
+*   用法：image_cache_bench <资源目录> <缓存目录> [--dpi <DPI值>] [--no-cache] [--clear]
+*   --dpi      加载图片使用的DPI值，默认为96（比如144表示150%缩放）
+*   --no-cache 不使用磁盘缓存（每个图片都需要解码和缩放，作为对比的基准）
+*   --clear    运行前清空缓存目录（本次运行解码图片并写入缓存）
+*   测试方法：先运行一次 --no-cache 得到基准耗时，再运行一次 --clear 写入缓存，然后再运行一次（不带参数）得到使用缓存时的耗时；
+*   每次运行是一个独立的进程，与程序冷启动时的情况一致（操作系统的文件缓存除外）
+*/
+#include "duilib/duilib.h"
+#include "duilib/Core/ImageManager.h"
+#include "duilib/Image/ImageInfo.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        printf("usage: image_cache_bench <resource directory> <cache directory> [--dpi <dpi>] [--no-cache] [--clear]\n");
+        return 1;
+    }
+    const std::filesystem::path resourceDir = std::filesystem::path(argv[1]);
+    const std::filesystem::path cacheDir = std::filesystem::path(argv[2]);
+    uint32_t uDpi = 96;
+    bool bUseCache = true;
+    bool bClearCache = false;
+    for (int i = 3; i < argc; ++i) {
+        if ((::strcmp(argv[i], "--dpi") == 0) && ((i + 1) < argc)) {
+            uDpi = (uint32_t)::atoi(argv[++i]);
+        }
+        else if (::strcmp(argv[i], "--no-cache") == 0) {
+            bUseCache = false;
+        }
+        else if (::strcmp(argv[i], "--clear") == 0) {
+            bClearCache = true;
+        }
+    }
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(resourceDir, errorCode) || (uDpi == 0)) {
+        printf("resource directory not found: %s\n", argv[1]);
+        return 1;
+    }
+
+    //收集资源目录下的所有图片文件
+    std::vector<std::filesystem::path> imageFiles;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(resourceDir, errorCode)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const std::filesystem::path extension = entry.path().extension();
+        if ((extension == ".png") || (extension == ".svg") || (extension == ".jpg") || (extension == ".jpeg") ||
+            (extension == ".gif") || (extension == ".webp") || (extension == ".bmp") || (extension == ".ico")) {
+            imageFiles.push_back(entry.path());
+        }
+    }
+
+    ui::GlobalManager& globalManager = ui::GlobalManager::Instance();
+    if (!globalManager.Startup(ui::LocalFilesResParam(ui::FilePath(resourceDir.native())))) {
+        printf("startup failed\n");
+        return 1;
+    }
+    ui::ImageManager& imageManager = globalManager.Image();
+    if (bUseCache) {
+        const ui::FilePath cachePath(cacheDir.native());
+        if (bClearCache) {
+            //上限为0：删除所有缓存文件
+            imageManager.SetImageDiskCachePath(cachePath, 0);
+        }
+        imageManager.SetImageDiskCachePath(cachePath);
+    }
+
+    size_t nLoaded = 0;
+    uint64_t nBitmapBytes = 0;
+    std::vector<std::shared_ptr<ui::ImageInfo>> images;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (const std::filesystem::path& imageFile : imageFiles) {
+        ui::ImageLoadAttribute loadAttribute(_T(""), _T(""), true, false, 0);
+        loadAttribute.SetImageFullPath(ui::FilePath(imageFile.native()).ToString());
+        std::shared_ptr<ui::ImageInfo> imageInfo = imageManager.GetImage(uDpi, loadAttribute);
+        if (imageInfo != nullptr) {
+            ++nLoaded;
+            nBitmapBytes += imageInfo->GetBitmapDataSize();
+            //保持引用，避免图片释放后被再次加载
+            images.push_back(imageInfo);
+        }
+    }
+    const auto endTime = std::chrono::steady_clock::now();
+    const double fTotalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    ui::PerformanceUtil& performance = ui::PerformanceUtil::Instance();
+    printf("images: %zu, loaded: %zu, bitmap bytes: %llu, dpi: %u, disk cache: %s\n",
+           imageFiles.size(), nLoaded, (unsigned long long)nBitmapBytes, uDpi, bUseCache ? "on" : "off");
+    printf("total: %.2f ms, average: %.3f ms/image\n",
+           fTotalMs, imageFiles.empty() ? 0.0 : (fTotalMs / (double)imageFiles.size()));
+    printf("disk cache hit: %lld, miss: %lld, save: %lld\n",
+           (long long)performance.GetCounter(_T("ImageDiskCache(Hit)")),
+           (long long)performance.GetCounter(_T("ImageDiskCache(Miss)")),
+           (long long)performance.GetCounter(_T("ImageDiskCache(Save)")));
+
+    images.clear();
+    globalManager.Shutdown();
+    return 0;
+}
@@ -0,0 +1,221 @@
+/** 像素处理函数的性能测试工具：按常见的窗口尺寸，统计各个像素处理函数的吞吐量（MB/s）
+*   用法：pixel_bench [--time <毫秒数>]
+*   --time  每个测试项的最短运行时间，默认为500毫秒
+*   测试项：
+*   1. 窗口绘制（SDL）：交换R和B通道（SkSwapRB），分层窗口的透明度（PixelUtil::ScaleAlpha）
+*   2. 图片解码：PixelUtil::ConvertPixels的各个转换选项（R/B通道交换、Alpha预乘、垂直翻转、不透明）及其组合
+*   每个测试项同时给出逐像素实现（早期版本的实现）的结果，作为对比的基准
+*   注意：duilib和本工具都需要使用Release模式编译（-DCMAKE_BUILD_TYPE=Release），Debug模式下的测试结果没有参考价值
+*/
+#include "duilib/duilib.h"
+#include "duilib/Utils/PixelUtil.h"
+
+#pragma warning (push)
+#pragma warning (disable: 4244 4201 4100 4267)
+
+#include "include/core/SkSwizzle.h"
+
+#pragma warning (pop)
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+/** 测试项
+*/
+struct BenchItem
+{
+    //测试项的名称
+    const char* m_szName;
+
+    //测试函数：参数为源数据、目标数据（与源数据不同的缓冲区）、宽度、高度
+    std::function<void(const uint32_t* pSrc, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight)> m_func;
+};
+
+/** 窗口尺寸
+*/
+struct BenchSize
+{
+    uint32_t m_nWidth;
+    uint32_t m_nHeight;
+};
+
+/** 逐像素交换R和B通道（早期版本SkRasterWindowContext_SDL::UpdateColorByteOrder的实现）
+*/
+static void SwapRB_Scalar(uint32_t* pPixels, size_t nCount)
+{
+    const uint8_t backR = 0, backG = 1, backB = 2, backA = 3;
+    const uint8_t sdlR = 2, sdlG = 1, sdlB = 0, sdlA = 3;
+    uint32_t colorValue = 0;
+    uint8_t* pColorValue = (uint8_t*)pPixels;
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex, pColorValue += sizeof(uint32_t)) {
+        ::memcpy(&colorValue, pColorValue, sizeof(uint32_t));
+        pColorValue[sdlR] = ((uint8_t*)&colorValue)[backR];
+        pColorValue[sdlG] = ((uint8_t*)&colorValue)[backG];
+        pColorValue[sdlB] = ((uint8_t*)&colorValue)[backB];
+        pColorValue[sdlA] = ((uint8_t*)&colorValue)[backA];
+    }
+}
+
+/** 逐像素乘以透明度（早期版本SkRasterWindowContext_SDL::UpdateColorAlpha的实现，截断取整）
+*/
+static void ScaleAlpha_Scalar(uint32_t* pPixels, size_t nCount, uint8_t nAlpha)
+{
+    uint8_t* pColorValue = (uint8_t*)pPixels;
+    for (size_t nIndex = 0; nIndex < nCount * 4; ++nIndex) {
+        pColorValue[nIndex] = (uint8_t)((uint32_t)pColorValue[nIndex] * nAlpha / 255);
+    }
+}
+
+/** 逐像素交换R和B通道并做Alpha预乘（早期版本APNG/CxImage解码的实现，截断取整），然后复制到目标数据
+*/
+static void ConvertPixels_Scalar(const uint32_t* pSrc, uint32_t* pDest, size_t nCount)
+{
+    const uint8_t* pSrcColor = (const uint8_t*)pSrc;
+    uint8_t* pDestColor = (uint8_t*)pDest;
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex, pSrcColor += 4, pDestColor += 4) {
+        const uint8_t a = pSrcColor[3];
+        if (a == 255) {
+            pDestColor[0] = pSrcColor[2];
+            pDestColor[1] = pSrcColor[1];
+            pDestColor[2] = pSrcColor[0];
+        }
+        else {
+            pDestColor[0] = (uint8_t)(pSrcColor[2] * a / 255);
+            pDestColor[1] = (uint8_t)(pSrcColor[1] * a / 255);
+            pDestColor[2] = (uint8_t)(pSrcColor[0] * a / 255);
+        }
+        pDestColor[3] = a;
+    }
+}
+
+/** 运行一个测试项，返回吞吐量（MB/s，按源数据的字节数计算）
+*/
+static double RunBench(const BenchItem& item, const std::vector<uint32_t>& srcPixels, std::vector<uint32_t>& destPixels,
+                       uint32_t nWidth, uint32_t nHeight, int64_t nMinTimeMs)
+{
+    //预热一次：让数据进入缓存，与实际绘制时的情况接近
+    item.m_func(srcPixels.data(), destPixels.data(), nWidth, nHeight);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    int64_t nElapsedUs = 0;
+    int64_t nRounds = 0;
+    while (nElapsedUs < (nMinTimeMs * 1000)) {
+        item.m_func(srcPixels.data(), destPixels.data(), nWidth, nHeight);
+        ++nRounds;
+        nElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    }
+    const double fBytes = (double)nWidth * nHeight * 4 * nRounds;
+    return fBytes / (1024.0 * 1024.0) / ((double)nElapsedUs / 1000000.0);
+}
+
+int main(int argc, char** argv)
+{
+    int64_t nMinTimeMs = 500;
+    for (int i = 1; i < argc; ++i) {
+        if ((::strcmp(argv[i], "--time") == 0) && ((i + 1) < argc)) {
+            nMinTimeMs = ::atoi(argv[++i]);
+        }
+        else {
+            printf("usage: pixel_bench [--time <milliseconds>]\n");
+            return 1;
+        }
+    }
+    if (nMinTimeMs < 1) {
+        nMinTimeMs = 1;
+    }
+
+    const uint8_t nWindowAlpha = 200;
+    std::vector<BenchItem> benchItems;
+
+    //窗口绘制（SDL）：原地转换，不使用源数据
+    benchItems.push_back({ "present: SwapRB (SkSwapRB)",
+        [](const uint32_t* /*pSrc*/, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+            SkSwapRB(pDest, pDest, (int)(nWidth * nHeight));
+        } });
+    benchItems.push_back({ "present: SwapRB (scalar, old)",
+        [](const uint32_t* /*pSrc*/, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+            SwapRB_Scalar(pDest, (size_t)nWidth * nHeight);
+        } });
+    benchItems.push_back({ "present: ScaleAlpha (PixelUtil)",
+        [nWindowAlpha](const uint32_t* /*pSrc*/, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+            ui::PixelUtil::ScaleAlpha(pDest, (size_t)nWidth * nHeight, nWindowAlpha);
+        } });
+    benchItems.push_back({ "present: ScaleAlpha (scalar, old)",
+        [nWindowAlpha](const uint32_t* /*pSrc*/, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+            ScaleAlpha_Scalar(pDest, (size_t)nWidth * nHeight, nWindowAlpha);
+        } });
+
+    //图片解码：从源数据转换到目标数据
+    struct ConvertItem
+    {
+        const char* m_szName;
+        uint32_t m_nFlags;
+    };
+    const ConvertItem convertItems[] = {
+        { "decode: Copy (ConvertPixels)", 0 },
+        { "decode: SwapRB (ConvertPixels)", ui::PixelUtil::kPixelSwapRB },
+        { "decode: Premultiply (ConvertPixels)", ui::PixelUtil::kPixelPremultiply },
+        { "decode: FlipVertical (ConvertPixels)", ui::PixelUtil::kPixelFlipVertical },
+        { "decode: ForceOpaque (ConvertPixels)", ui::PixelUtil::kPixelForceOpaque },
+        { "decode: SwapRB+Premultiply (ConvertPixels)", ui::PixelUtil::kPixelSwapRB | ui::PixelUtil::kPixelPremultiply },
+        { "decode: SwapRB+Premultiply+Flip (ConvertPixels)", ui::PixelUtil::kPixelSwapRB | ui::PixelUtil::kPixelPremultiply | ui::PixelUtil::kPixelFlipVertical }
+    };
+    for (const ConvertItem& convertItem : convertItems) {
+        const uint32_t nFlags = convertItem.m_nFlags;
+        benchItems.push_back({ convertItem.m_szName,
+            [nFlags](const uint32_t* pSrc, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+                ui::PixelUtil::ConvertPixels((const uint8_t*)pSrc, (uint8_t*)pDest, nWidth, nHeight, nFlags);
+            } });
+    }
+    benchItems.push_back({ "decode: SwapRB+Premultiply (scalar, old)",
+        [](const uint32_t* pSrc, uint32_t* pDest, uint32_t nWidth, uint32_t nHeight) {
+            ConvertPixels_Scalar(pSrc, pDest, (size_t)nWidth * nHeight);
+        } });
+
+    const BenchSize benchSizes[] = {
+        { 800, 600 },
+        { 1280, 720 },
+        { 1920, 1080 },
+        { 2560, 1440 },
+        { 3840, 2160 }
+    };
+
+    printf("%-50s", "MB/s");
+    for (const BenchSize& benchSize : benchSizes) {
+        char szSize[32] = { 0 };
+        snprintf(szSize, sizeof(szSize), "%ux%u", benchSize.m_nWidth, benchSize.m_nHeight);
+        printf("%12s", szSize);
+    }
+    printf("\n");
+
+    //测试数据：随机的像素值（Alpha通道也是随机值）
+    std::vector<std::vector<uint32_t>> srcPixelsList;
+    for (const BenchSize& benchSize : benchSizes) {
+        std::vector<uint32_t> srcPixels((size_t)benchSize.m_nWidth * benchSize.m_nHeight);
+        uint32_t nSeed = 12345;
+        for (uint32_t& nPixel : srcPixels) {
+            nSeed = nSeed * 1103515245 + 12345;
+            nPixel = nSeed;
+        }
+        srcPixelsList.push_back(std::move(srcPixels));
+    }
+
+    for (const BenchItem& item : benchItems) {
+        printf("%-50s", item.m_szName);
+        for (size_t nSize = 0; nSize < std::size(benchSizes); ++nSize) {
+            const BenchSize& benchSize = benchSizes[nSize];
+            std::vector<uint32_t> destPixels = srcPixelsList[nSize];
+            const double fMBps = RunBench(item, srcPixelsList[nSize], destPixels,
+                                          benchSize.m_nWidth, benchSize.m_nHeight, nMinTimeMs);
+            printf("%12.0f", fMBps);
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+/** 皮肤编译工具：将皮肤目录下的所有XML文件编译为二进制格式（XML文件名 + ".skb"，格式说明见duilib/Core/SkinBinary.h）
+*   用法：skin_compiler <皮肤目录> [--no-class-expansion]
+*   皮肤目录是global.xml所在的目录（比如：bin/resources/themes/default），global.xml中定义的Class用于展开控件的class属性；
+*   参数 --no-class-expansion 表示不展开控件的class属性（比如程序运行时会修改全局Class的情况）
+*/
+#include "duilib/Core/SkinBinary.h"
+#include "duilib/Utils/FileUtil.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        printf("usage: skin_compiler <skin directory> [--no-class-expansion]\n");
+        return 1;
+    }
+    const std::filesystem::path skinDir = std::filesystem::path(argv[1]);
+    bool bExpandClass = true;
+    for (int i = 2; i < argc; ++i) {
+        if (::strcmp(argv[i], "--no-class-expansion") == 0) {
+            bExpandClass = false;
+        }
+    }
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(skinDir, errorCode)) {
+        printf("skin directory not found: %s\n", argv[1]);
+        return 1;
+    }
+
+    //读取全局Class
+    std::map<DString, DString> globalClassMap;
+    std::vector<uint8_t> xmlData;
+    const std::filesystem::path globalXmlPath = skinDir / "global.xml";
+    if (bExpandClass && ui::FileUtil::ReadFileData(ui::FilePath(globalXmlPath.native()), xmlData)) {
+        if (!ui::SkinBinary::ReadClasses(xmlData, globalClassMap)) {
+            printf("parse failed: %s\n", globalXmlPath.string().c_str());
+            return 1;
+        }
+    }
+
+    //编译目录下的所有XML文件
+    int nCompiled = 0;
+    int nFailed = 0;
+    std::vector<uint8_t> binData;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(skinDir, errorCode)) {
+        if (!entry.is_regular_file() || (entry.path().extension() != ".xml")) {
+            continue;
+        }
+        const ui::FilePath xmlFilePath(entry.path().native());
+        if (!ui::FileUtil::ReadFileData(xmlFilePath, xmlData) ||
+            !ui::SkinBinary::Compile(xmlData, globalClassMap, binData) ||
+            !ui::FileUtil::WriteFileData(ui::SkinBinary::GetCompiledFilePath(xmlFilePath), binData)) {
+            printf("compile failed: %s\n", entry.path().string().c_str());
+            ++nFailed;
+            continue;
+        }
+        printf("%s: %zu -> %zu bytes\n", entry.path().string().c_str(), xmlData.size(), binData.size());
+        ++nCompiled;
+    }
+    printf("compiled: %d, failed: %d\n", nCompiled, nFailed);
+    return (nFailed == 0) ? 0 : 1;
+}